@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <new>
 
 class ArenaAllocator {
 public:
@@ -11,7 +12,8 @@ public:
     {
         void* offset = m_offset;
         m_offset += sizeof(T);
-        return static_cast<T*>(offset);
+        // Construct in place so members like vectors start out valid
+        return new (offset) T();
     }
 private:
 
@@ -0,0 +1,332 @@
+#include "constant.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+
+std::optional<Constant> const_from_num_lit(const std::string& num_lit)
+{
+    double num;
+    std::from_chars_result result = std::from_chars(num_lit.data(), num_lit.data() + num_lit.size(), num);
+    if (result.ec != std::errc() || result.ptr != num_lit.data() + num_lit.size())
+    {
+        return {};
+    }
+
+    return Constant{.var = num};
+}
+
+bool const_is_truthy(const Constant& constant)
+{
+    if (std::holds_alternative<ConstNull>(constant.var))
+    {
+        return false;
+    }
+    else if (std::holds_alternative<bool>(constant.var))
+    {
+        return std::get<bool>(constant.var);
+    }
+    else if (std::holds_alternative<ConstVec>(constant.var))
+    {
+        const ConstVec& vec = std::get<ConstVec>(constant.var);
+        return vec.x != 0 || vec.y != 0 || vec.z != 0;
+    }
+    else
+    {
+        return std::get<double>(constant.var) != 0;
+    }
+}
+
+bool const_equals(const Constant& lhs, const Constant& rhs)
+{
+    if (lhs.var.index() != rhs.var.index())
+    {
+        return false;
+    }
+
+    if (std::holds_alternative<bool>(lhs.var))
+    {
+        return std::get<bool>(lhs.var) == std::get<bool>(rhs.var);
+    }
+    else if (std::holds_alternative<double>(lhs.var))
+    {
+        return std::abs(std::get<double>(lhs.var) - std::get<double>(rhs.var)) < hex_epsilon;
+    }
+    else if (std::holds_alternative<ConstVec>(lhs.var))
+    {
+        // Vectors are equal when they're close enough together
+        const ConstVec& lhs_vec = std::get<ConstVec>(lhs.var);
+        const ConstVec& rhs_vec = std::get<ConstVec>(rhs.var);
+        double dx = lhs_vec.x - rhs_vec.x;
+        double dy = lhs_vec.y - rhs_vec.y;
+        double dz = lhs_vec.z - rhs_vec.z;
+        return dx * dx + dy * dy + dz * dz < hex_epsilon * hex_epsilon;
+    }
+
+    // Both null
+    return true;
+}
+
+// Folds op on two numbers, for use on the components of vectors
+static std::optional<double> fold_num_op(TokenType_ op, double lhs, double rhs)
+{
+    std::optional<Constant> result = fold_bin_op(op, Constant{.var = lhs}, Constant{.var = rhs});
+    if (!result.has_value())
+    {
+        return {};
+    }
+    return std::get<double>(result.value().var);
+}
+
+// Follows the arithmetic patterns when at least one side is a vector, where a number is used on every component
+static std::optional<Constant> fold_vec_op(TokenType_ op, const Constant& lhs, const Constant& rhs)
+{
+    auto as_vec = [](const Constant& constant) -> std::optional<ConstVec> {
+        if (std::holds_alternative<ConstVec>(constant.var))
+        {
+            return std::get<ConstVec>(constant.var);
+        }
+        else if (std::holds_alternative<double>(constant.var))
+        {
+            double num = std::get<double>(constant.var);
+            return ConstVec{.x = num, .y = num, .z = num};
+        }
+        return {};
+    };
+
+    std::optional<ConstVec> lhs_vec = as_vec(lhs);
+    std::optional<ConstVec> rhs_vec = as_vec(rhs);
+    if (!lhs_vec.has_value() || !rhs_vec.has_value())
+    {
+        return {};
+    }
+
+    const ConstVec& a = lhs_vec.value();
+    const ConstVec& b = rhs_vec.value();
+    bool both_vecs = std::holds_alternative<ConstVec>(lhs.var) && std::holds_alternative<ConstVec>(rhs.var);
+
+    std::optional<double> x, y, z;
+
+    switch (op)
+    {
+    case TokenType_::plus:
+    case TokenType_::dash:
+        break;
+    case TokenType_::star:
+        if (both_vecs)
+        {
+            // Dot product
+            std::optional<double> xx = fold_num_op(TokenType_::star, a.x, b.x);
+            std::optional<double> yy = fold_num_op(TokenType_::star, a.y, b.y);
+            std::optional<double> zz = fold_num_op(TokenType_::star, a.z, b.z);
+            std::optional<double> xy = xx.has_value() && yy.has_value() ? fold_num_op(TokenType_::plus, xx.value(), yy.value()) : std::nullopt;
+            std::optional<double> dot = xy.has_value() && zz.has_value() ? fold_num_op(TokenType_::plus, xy.value(), zz.value()) : std::nullopt;
+            if (!dot.has_value())
+            {
+                return {};
+            }
+            return Constant{.var = dot.value()};
+        }
+        break;
+    case TokenType_::slash_forward:
+        if (both_vecs)
+        {
+            // Cross product
+            auto cross = [](double l1, double r1, double l2, double r2) -> std::optional<double> {
+                std::optional<double> first = fold_num_op(TokenType_::star, l1, r1);
+                std::optional<double> second = fold_num_op(TokenType_::star, l2, r2);
+                if (!first.has_value() || !second.has_value())
+                {
+                    return {};
+                }
+                return fold_num_op(TokenType_::dash, first.value(), second.value());
+            };
+            x = cross(a.y, b.z, a.z, b.y);
+            y = cross(a.z, b.x, a.x, b.z);
+            z = cross(a.x, b.y, a.y, b.x);
+        }
+        break;
+    default:
+        return {};
+    }
+
+    // Everything else is done on each component
+    if (!both_vecs || op != TokenType_::slash_forward)
+    {
+        x = fold_num_op(op, a.x, b.x);
+        y = fold_num_op(op, a.y, b.y);
+        z = fold_num_op(op, a.z, b.z);
+    }
+
+    if (!x.has_value() || !y.has_value() || !z.has_value())
+    {
+        return {};
+    }
+
+    return Constant{.var = ConstVec{.x = x.value(), .y = y.value(), .z = z.value()}};
+}
+
+std::optional<Constant> fold_bin_op(TokenType_ op, const Constant& lhs, const Constant& rhs)
+{
+    // Comparisons work on any iotas
+    if (op == TokenType_::double_eq)
+    {
+        return Constant{.var = const_equals(lhs, rhs)};
+    }
+    else if (op == TokenType_::not_eq_)
+    {
+        return Constant{.var = !const_equals(lhs, rhs)};
+    }
+
+    // Boolean logic
+    if (std::holds_alternative<bool>(lhs.var) && std::holds_alternative<bool>(rhs.var))
+    {
+        bool lhs_bool = std::get<bool>(lhs.var);
+        bool rhs_bool = std::get<bool>(rhs.var);
+
+        switch (op)
+        {
+        case TokenType_::double_amp:
+            return Constant{.var = lhs_bool && rhs_bool};
+        case TokenType_::double_bar:
+            return Constant{.var = lhs_bool || rhs_bool};
+        case TokenType_::caret:
+            return Constant{.var = lhs_bool != rhs_bool};
+        default:
+            return {};
+        }
+    }
+
+    if (std::holds_alternative<ConstVec>(lhs.var) || std::holds_alternative<ConstVec>(rhs.var))
+    {
+        return fold_vec_op(op, lhs, rhs);
+    }
+
+    // Everything else is only folded between numbers
+    if (!std::holds_alternative<double>(lhs.var) || !std::holds_alternative<double>(rhs.var))
+    {
+        return {};
+    }
+
+    double lhs_num = std::get<double>(lhs.var);
+    double rhs_num = std::get<double>(rhs.var);
+    double result;
+
+    switch (op)
+    {
+    case TokenType_::angle_open:
+        return Constant{.var = lhs_num < rhs_num};
+    case TokenType_::angle_close:
+        return Constant{.var = lhs_num > rhs_num};
+    case TokenType_::oangle_eq:
+        return Constant{.var = lhs_num < rhs_num || std::abs(lhs_num - rhs_num) < hex_epsilon};
+    case TokenType_::cangle_eq:
+        return Constant{.var = lhs_num > rhs_num || std::abs(lhs_num - rhs_num) < hex_epsilon};
+    case TokenType_::plus:
+        result = lhs_num + rhs_num;
+        break;
+    case TokenType_::dash:
+        result = lhs_num - rhs_num;
+        break;
+    case TokenType_::star:
+        result = lhs_num * rhs_num;
+        break;
+    case TokenType_::slash_forward:
+        // Leave division by zero to mishap at runtime
+        if (rhs_num == 0)
+        {
+            return {};
+        }
+        result = lhs_num / rhs_num;
+        break;
+    case TokenType_::modulus:
+        // Hex Casting and C++ only agree on the sign of the result for positive operands
+        if (rhs_num <= 0 || lhs_num < 0)
+        {
+            return {};
+        }
+        result = std::fmod(lhs_num, rhs_num);
+        break;
+    default:
+        return {};
+    }
+
+    if (!std::isfinite(result))
+    {
+        return {};
+    }
+
+    // Don't introduce a non-integer literal that wasn't in the code already, since numerical reflections can't draw
+    // most of them exactly
+    if (!is_exact_num(result) && is_exact_num(lhs_num) && is_exact_num(rhs_num))
+    {
+        return {};
+    }
+    // Nor one too long to draw, like 0.1 + 0.2, when the operands could be drawn on their own
+    if (!is_drawable_num(result))
+    {
+        return {};
+    }
+
+    return Constant{.var = result};
+}
+
+std::optional<Constant> fold_un_op(TokenType_ op, const Constant& operand)
+{
+    switch (op)
+    {
+    case TokenType_::dash:
+        if (std::holds_alternative<double>(operand.var))
+        {
+            return Constant{.var = -std::get<double>(operand.var)};
+        }
+        else if (std::holds_alternative<ConstVec>(operand.var))
+        {
+            const ConstVec& vec = std::get<ConstVec>(operand.var);
+            return Constant{.var = ConstVec{.x = -vec.x, .y = -vec.y, .z = -vec.z}};
+        }
+        break;
+    case TokenType_::not_:
+    case TokenType_::tilde:
+        if (std::holds_alternative<bool>(operand.var))
+        {
+            return Constant{.var = !std::get<bool>(operand.var)};
+        }
+        break;
+    default:
+        break;
+    }
+
+    return {};
+}
+
+bool is_exact_num(double num)
+{
+    // Past 2^53 doubles stop being able to hold every integer
+    return std::isfinite(num) && std::floor(num) == num && std::abs(num) <= 9007199254740992.0;
+}
+
+bool is_drawable_num(double num)
+{
+    if (is_exact_num(num))
+    {
+        return true;
+    }
+
+    std::string num_lit = num_to_string(num);
+    return (size_t)std::count_if(num_lit.begin(), num_lit.end(), [](char c){ return std::isdigit(c); }) <= max_num_lit_digits;
+}
+
+std::string num_to_string(double num)
+{
+    // Don't print negative zero
+    if (num == 0)
+    {
+        return "0";
+    }
+
+    char buf[400];
+    std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), num, std::chars_format::fixed);
+    return std::string(buf, result.ptr);
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <variant>
+
+#include "tokenization.hpp"
+
+struct ConstNull {};
+
+struct ConstVec {
+    double x, y, z;
+};
+
+// Compile-time value of an iota
+struct Constant {
+    std::variant<ConstNull, bool, double, ConstVec> var;
+};
+
+// Tolerance Hex Casting uses when comparing numbers
+const double hex_epsilon = 0.0001;
+
+std::optional<Constant> const_from_num_lit(const std::string& num_lit);
+
+// Follows Augur's Purification
+bool const_is_truthy(const Constant& constant);
+// Follows Equality Distillation
+bool const_equals(const Constant& lhs, const Constant& rhs);
+
+// Returns nothing if the operation can't be done at compile time, either because it would mishap or because the
+// result can't be drawn exactly as a numerical reflection
+std::optional<Constant> fold_bin_op(TokenType_ op, const Constant& lhs, const Constant& rhs);
+std::optional<Constant> fold_un_op(TokenType_ op, const Constant& operand);
+
+// Most digits in a number literal that can still be turned into an exact fraction
+const size_t max_num_lit_digits = 15;
+
+// Whether a number can be folded into a numerical reflection without losing precision
+bool is_exact_num(double num);
+// Whether number's literal is short enough to be drawn exactly, either as is or as a fraction
+bool is_drawable_num(double num);
+// Shortest string that reads back as the same number, without exponent
+std::string num_to_string(double num);
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include "effects.hpp"
+
+#include <algorithm>
+#include <set>
+
+#include "folding.hpp"
+
+// Inbuilt functions whose results only depend on their arguments
+static const std::set<std::string> pure_funcs = {
+    "pow", "floor", "ceil", "min", "max", "as_bool", "tau", "pi", "e", "sin", "cos", "tan", "arc_sin", "arc_cos", "arc_tan",
+    "angle", "log", "ln", "vec", "vec0", "vecXP", "vecXN", "vecYP", "vecYN", "vec_up", "vec_down", "vecZP", "vecZN", "self"
+};
+static const std::set<std::string> pure_members = {
+    "with", "with_back", "sublist", "back", "reversed", "without_at", "with_front", "without_duplicates", "front", "x", "y", "z",
+    "sign", "size", "length", "abs", "find", const_subscript_func
+};
+// Inbuilt functions that read from the world
+static const std::set<std::string> world_funcs = {
+    "sentinel_pos", "sentinel_dir_from", "is_flying", "circle_impetus_pos", "circle_impetus_forward", "circle_LNW", "circle_USE",
+    "block_raycast", "block_normal_raycast", "entity_raycast", "get_entity", "get_entities", "get_animal", "get_animals",
+    "get_monster", "get_monsters", "get_item", "get_items", "get_player", "get_players", "get_living", "get_non_animals",
+    "get_non_monsters", "get_non_items", "get_non_players", "get_non_living", "read", "can_read", "can_write", "read_akashic"
+};
+static const std::set<std::string> world_members = {
+    "pos", "eye_pos", "height", "velocity", "forward"
+};
+// Inbuilt functions whose results can change without anything else changing
+static const std::set<std::string> varying_funcs = {
+    "random", "patterns_remaining", "stack_size"
+};
+// Inbuilt void functions that change the world
+static const std::set<std::string> world_spells = {
+    "write", "write_akashic", "mine", "effect_weakness", "effect_levitation", "effect_withering", "effect_poison",
+    "effect_slowness", "craft_cypher", "craft_trinket", "craft_artifact", "recharge_item", "erase_item", "grow", "edify", "add_vel",
+    "teleport_forward", "play_note", "fly_range", "fly_duration", "change_color", "change_shape", "place_block", "destroy_liquid",
+    "destroy_fire", "destroy_sentinel", "create_sentinel", "create_block", "create_fire", "create_explosion", "create_explosion_fire",
+    "create_light", "create_water", "craft_phial", "flay_mind", "weather_rain", "weather_clear", "fly_wings", "teleport_relative",
+    "teleport_to", "effect_regeneration", "effect_night_vision", "effect_absorption", "effect_haste", "effect_strength",
+    "create_greater_sentinel", "create_lightning", "create_lava"
+};
+// Inbuilt functions that mishap on some numbers, and not just on the wrong types
+static const std::set<std::string> mishap_funcs = {
+    "pow", "log", "ln", "arc_sin", "arc_cos"
+};
+
+Effect inbuilt_effect(const std::string& name, bool is_void, bool is_member)
+{
+    if (is_void)
+    {
+        // Printing doesn't change anything that can be read back
+        if (name == "print")
+        {
+            return Effect::pure;
+        }
+        return world_spells.count(name) > 0 ? Effect::changes_world : Effect::unknown;
+    }
+
+    if ((is_member ? pure_members : pure_funcs).count(name) > 0)
+    {
+        return Effect::pure;
+    }
+    if ((is_member ? world_members : world_funcs).count(name) > 0)
+    {
+        return Effect::reads_world;
+    }
+    if (!is_member && varying_funcs.count(name) > 0)
+    {
+        return Effect::varies;
+    }
+    return Effect::unknown;
+}
+
+bool can_mishap_inbuilt(const std::string& name)
+{
+    return mishap_funcs.count(name) > 0;
+}
+
+bool can_speculate_expr(const NodeExpr* expr)
+{
+    if (const_from_expr(expr).has_value())
+    {
+        return true;
+    }
+    // Comparing for equality works on any two iotas
+    if (std::holds_alternative<NodeExprBin*>(expr->var))
+    {
+        const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+        return (expr_bin->op_type == TokenType_::double_eq || expr_bin->op_type == TokenType_::not_eq_) &&
+            can_speculate_expr(expr_bin->lhs) && can_speculate_expr(expr_bin->rhs);
+    }
+
+    const NodeTerm* term = std::get<NodeTerm*>(expr->var);
+    if (std::holds_alternative<NodeTermParen*>(term->var))
+    {
+        return can_speculate_expr(std::get<NodeTermParen*>(term->var)->expr);
+    }
+    // Subscripts mishap on anything but lists
+    if (std::holds_alternative<NodeTermVar*>(term->var))
+    {
+        return std::holds_alternative<NodeVarIdent*>(std::get<NodeTermVar*>(term->var)->var);
+    }
+    if (std::holds_alternative<NodeTermPatternLit*>(term->var))
+    {
+        return true;
+    }
+    if (std::holds_alternative<NodeTermListLit*>(term->var))
+    {
+        const std::vector<NodeExpr*>& exprs = std::get<NodeTermListLit*>(term->var)->exprs;
+        return std::all_of(exprs.begin(), exprs.end(), [](const NodeExpr* elem){ return can_speculate_expr(elem); });
+    }
+    // Functions that take arguments can mishap on the wrong types
+    if (std::holds_alternative<NodeTermCallFunc*>(term->var))
+    {
+        const NodeDefinedFunc* func = std::get<NodeTermCallFunc*>(term->var)->func;
+        return func->exprs.empty() && inbuilt_effect(func->ident.value.value(), false, false) == Effect::pure;
+    }
+    return false;
+}
+
+static bool is_pure_term(const NodeTerm* term)
+{
+    struct TermVisitor {
+        bool operator()(const NodeTermUn* term_un)
+        {
+            if (term_un->op_type == TokenType_::double_plus || term_un->op_type == TokenType_::double_dash)
+            {
+                return false;
+            }
+
+            return is_pure_term(term_un->term);
+        }
+
+        bool operator()(const NodeTermUnPost*)
+        {
+            return false;
+        }
+
+        bool operator()(const NodeTermNumLit*)
+        {
+            return true;
+        }
+
+        bool operator()(const NodeTermListLit* term_list_lit)
+        {
+            return std::all_of(term_list_lit->exprs.begin(), term_list_lit->exprs.end(),
+                [](const NodeExpr* expr){ return is_pure_expr(expr); });
+        }
+
+        bool operator()(const NodeTermPatternLit*)
+        {
+            return true;
+        }
+
+        bool operator()(const NodeTermBoolLit*)
+        {
+            return true;
+        }
+
+        bool operator()(const NodeTermNullLit*)
+        {
+            return true;
+        }
+
+        bool operator()(const NodeTermVar* term_var)
+        {
+            if (std::holds_alternative<NodeVarIdent*>(term_var->var))
+            {
+                return true;
+            }
+            return is_pure_expr(std::get<NodeVarListSubscript*>(term_var->var)->expr);
+        }
+
+        bool operator()(const NodeTermParen* term_paren)
+        {
+            return is_pure_expr(term_paren->expr);
+        }
+
+        bool operator()(const NodeTermCallFunc* call_func)
+        {
+            std::string func_name = call_func->func->ident.value.value();
+            return inbuilt_effect(func_name, false, false) == Effect::pure && !can_mishap_inbuilt(func_name) &&
+                std::all_of(call_func->func->exprs.begin(), call_func->func->exprs.end(),
+                    [](const NodeExpr* expr){ return is_pure_expr(expr); });
+        }
+        bool operator()(const NodeTermTernary* term_ternary)
+        {
+            return is_pure_expr(term_ternary->expr) && is_pure_expr(term_ternary->then_expr) &&
+                is_pure_expr(term_ternary->else_expr);
+        }
+    };
+
+    TermVisitor visitor;
+    return std::visit(visitor, term->var);
+}
+
+bool is_pure_expr(const NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        return is_pure_term(std::get<NodeTerm*>(expr->var));
+    }
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+
+    switch (expr_bin->op_type)
+    {
+    case TokenType_::eq:
+    case TokenType_::plus_eq:
+    case TokenType_::dash_eq:
+    case TokenType_::star_eq:
+    case TokenType_::fslash_eq:
+    case TokenType_::mod_eq:
+    // Can mishap on 0
+    case TokenType_::slash_forward:
+    case TokenType_::modulus:
+        return false;
+    case TokenType_::dot:
+        if (!std::holds_alternative<NodeTerm*>(expr_bin->rhs->var) ||
+            !std::holds_alternative<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var))
+        {
+            return false;
+        }
+        else
+        {
+            const NodeDefinedFunc* func = std::get<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var)->func;
+            return is_pure_expr(expr_bin->lhs) && inbuilt_effect(func->ident.value.value(), false, true) == Effect::pure &&
+                std::all_of(func->exprs.begin(), func->exprs.end(), [](const NodeExpr* arg){ return is_pure_expr(arg); });
+        }
+    default:
+        return is_pure_expr(expr_bin->lhs) && is_pure_expr(expr_bin->rhs);
+    }
+}
\ No newline at end of file
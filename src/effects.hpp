@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+
+#include "parser.hpp"
+
+// What calling an inbuilt function can do besides giving its result
+enum class Effect {
+    // Result only depends on the arguments
+    pure,
+    // Result depends on the world, and stays the same until something changes the world
+    reads_world,
+    // Result can be different every time, but nothing else changes
+    varies,
+    // Changes the world, so nothing read from it before can be reused
+    changes_world,
+    // Could do anything, like declared functions, which can also write to globals, and executed iotas
+    unknown,
+};
+
+// Effect of calling function with name, where names that aren't of inbuilt functions are declared functions
+Effect inbuilt_effect(const std::string& name, bool is_void, bool is_member);
+// Whether inbuilt function mishaps on some numbers, and not just on the wrong types
+bool can_mishap_inbuilt(const std::string& name);
+// Whether evaluating expression does nothing but make its value, and can only mishap on values of the wrong type
+bool is_pure_expr(const NodeExpr* expr);
+// Whether expression can be evaluated where its value isn't needed, because it can't mishap or do anything else
+bool can_speculate_expr(const NodeExpr* expr);
\ No newline at end of file
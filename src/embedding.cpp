@@ -0,0 +1,234 @@
+#include "embedding.hpp"
+
+#include <charconv>
+#include <map>
+#include <optional>
+
+// Whether numerical reflection's value can be written in an embedded iota as it is
+static bool is_embeddable_num(const std::string& num_lit)
+{
+    double num;
+    std::from_chars_result result = std::from_chars(num_lit.data(), num_lit.data() + num_lit.size(), num, std::chars_format::fixed);
+    return result.ec == std::errc() && result.ptr == num_lit.data() + num_lit.size();
+}
+
+// Vector along one axis made by scaling its vector reflection, if it's along one
+static std::vector<Pattern> scaled_axis(const std::string& x, const std::string& y, const std::string& z)
+{
+    bool on_x = x != "0" && y == "0" && z == "0";
+    bool on_y = x == "0" && y != "0" && z == "0";
+    bool on_z = x == "0" && y == "0" && z != "0";
+    if (!on_x && !on_y && !on_z)
+    {
+        return {};
+    }
+
+    // Scale is kept positive, since the reflection can point either way
+    std::string scale = on_x ? x : on_y ? y : z;
+    bool is_negative = scale.front() == '-';
+    if (is_negative)
+    {
+        scale.erase(0, 1);
+    }
+
+    PatternType axis = on_x ? (is_negative ? PatternType::vector_reflection_NX : PatternType::vector_reflection_PX) :
+        on_y ? (is_negative ? PatternType::vector_reflection_NY : PatternType::vector_reflection_PY) :
+        (is_negative ? PatternType::vector_reflection_NZ : PatternType::vector_reflection_PZ);
+
+    return {Pattern{.type = PatternType::numerical_reflection, .value = scale}, Pattern{.type = axis, .value = {}},
+        Pattern{.type = PatternType::multiplicative_distillation, .value = {}}};
+}
+
+// Number of elements a list made by Flock's Gambit with num_lit has, if it's a whole number
+static std::optional<size_t> list_size(const std::string& num_lit)
+{
+    size_t size;
+    std::from_chars_result result = std::from_chars(num_lit.data(), num_lit.data() + num_lit.size(), size);
+    if (result.ec != std::errc() || result.ptr != num_lit.data() + num_lit.size())
+    {
+        return {};
+    }
+    return size;
+}
+
+ConstantEmbedder::ConstantEmbedder(std::vector<Pattern> patterns)
+    :m_patterns(std::move(patterns))
+{ }
+
+std::vector<Pattern> ConstantEmbedder::embed()
+{
+    for (size_t i = 0; i < m_patterns.size(); ++i)
+    {
+        const Pattern& pattern = m_patterns[i];
+
+        switch (pattern.type)
+        {
+        // Escaped iota is pushed as it is
+        case PatternType::consideration:
+            add_pattern(pattern);
+            if (i + 1 < m_patterns.size())
+            {
+                add_pattern(m_patterns[++i]);
+            }
+            break;
+        case PatternType::numerical_reflection:
+            if (!is_embeddable_num(pattern.value.value()))
+            {
+                add_pattern(pattern);
+                break;
+            }
+            m_output.push_back(pattern);
+            push_constant(pattern.value.value(), true);
+            break;
+        case PatternType::vacant_reflection:
+            m_output.push_back(pattern);
+            push_constant("[]", false);
+            break;
+        case PatternType::vector_reflection_zero:
+        case PatternType::vector_reflection_PX:
+        case PatternType::vector_reflection_NX:
+        case PatternType::vector_reflection_PY:
+        case PatternType::vector_reflection_NY:
+        case PatternType::vector_reflection_PZ:
+        case PatternType::vector_reflection_NZ:
+        {
+            static const std::map<PatternType, std::string> vector_texts = {
+                {PatternType::vector_reflection_zero, "(0, 0, 0)"},
+                {PatternType::vector_reflection_PX, "(1, 0, 0)"},
+                {PatternType::vector_reflection_NX, "(-1, 0, 0)"},
+                {PatternType::vector_reflection_PY, "(0, 1, 0)"},
+                {PatternType::vector_reflection_NY, "(0, -1, 0)"},
+                {PatternType::vector_reflection_PZ, "(0, 0, 1)"},
+                {PatternType::vector_reflection_NZ, "(0, 0, -1)"},
+            };
+            m_output.push_back(pattern);
+            push_constant(vector_texts.at(pattern.type), false);
+            break;
+        }
+        case PatternType::vector_exaltation:
+        {
+            size_t num_constants = m_constants.size();
+            if (num_constants < 3 || !m_constants[num_constants - 3].is_num || !m_constants[num_constants - 2].is_num ||
+                !m_constants[num_constants - 1].is_num)
+            {
+                add_pattern(pattern);
+                break;
+            }
+
+            const std::string& x = m_constants[num_constants - 3].text;
+            const std::string& y = m_constants[num_constants - 2].text;
+            const std::string& z = m_constants[num_constants - 1].text;
+            m_output.push_back(pattern);
+            combine(3, "(" + x + ", " + y + ", " + z + ")", scaled_axis(x, y, z));
+            break;
+        }
+        case PatternType::flocks_gambit:
+        {
+            // Size is the constant on top, and the elements are the constants under it
+            std::optional<size_t> size = m_constants.empty() || !m_constants.back().is_num ? std::nullopt :
+                list_size(m_constants.back().text);
+            if (!size.has_value() || size.value() == 0 || size.value() + 1 > m_constants.size())
+            {
+                add_pattern(pattern);
+                break;
+            }
+
+            std::string text = "[";
+            for (size_t j = m_constants.size() - 1 - size.value(); j + 1 < m_constants.size(); ++j)
+            {
+                text += m_constants[j].text + (j + 2 < m_constants.size() ? ", " : "");
+            }
+            text += "]";
+
+            m_output.push_back(pattern);
+            combine(size.value() + 1, text);
+            break;
+        }
+        case PatternType::introspection:
+        {
+            // Single pattern literal, pushed as the only element of a list
+            bool is_pattern_lit = i + 3 < m_patterns.size() && m_patterns[i + 1].type == PatternType::pattern_lit &&
+                m_patterns[i + 2].type == PatternType::retrospection && m_patterns[i + 3].type == PatternType::flocks_disintegration;
+            if (is_pattern_lit)
+            {
+                std::vector<Pattern> patterns = escaped(m_patterns[i + 1].value.value());
+                if (patterns.size() < 4)
+                {
+                    m_constants.clear();
+                    m_output.insert(m_output.end(), patterns.begin(), patterns.end());
+                    ++num_embedded;
+                    i += 3;
+                    break;
+                }
+            }
+
+            add_pattern(pattern);
+            ++m_depth;
+            break;
+        }
+        case PatternType::retrospection:
+            if (m_depth > 0)
+            {
+                --m_depth;
+            }
+            add_pattern(pattern);
+            break;
+        default:
+            add_pattern(pattern);
+            break;
+        }
+    }
+
+    return m_output;
+}
+
+void ConstantEmbedder::add_pattern(const Pattern& pattern)
+{
+    m_output.push_back(pattern);
+    m_constants.clear();
+}
+
+void ConstantEmbedder::push_constant(const std::string& text, bool is_num)
+{
+    m_constants.push_back(ConstantIota{.start = m_output.size() - 1, .text = text, .is_num = is_num});
+}
+
+void ConstantEmbedder::combine(size_t num_constants, const std::string& text, const std::vector<Pattern>& other)
+{
+    size_t start = m_constants[m_constants.size() - num_constants].start;
+    m_constants.resize(m_constants.size() - num_constants);
+
+    std::vector<Pattern> patterns = escaped("<" + text + ">");
+    bool use_other = !other.empty() && other.size() < patterns.size();
+    if (use_other)
+    {
+        patterns = other;
+    }
+
+    if (patterns.size() < m_output.size() - start)
+    {
+        m_output.resize(start);
+        m_output.insert(m_output.end(), patterns.begin(), patterns.end());
+        ++(use_other ? num_scaled_axes : num_embedded);
+    }
+
+    m_constants.push_back(ConstantIota{.start = start, .text = text, .is_num = false});
+}
+
+std::vector<Pattern> ConstantEmbedder::escaped(const std::string& text) const
+{
+    // Each time a code list is read, Consideration escapes the iota after it and is dropped, so the iota needs one
+    // Consideration to be pushed when it runs, and another for every list it's read into before that. Past one list,
+    // putting it in a list of its own and taking it back out is shorter
+    switch (m_depth)
+    {
+    case 0:
+        return {Pattern{.type = PatternType::consideration, .value = {}}, Pattern{.type = PatternType::pattern_lit, .value = text}};
+    case 1:
+        return {Pattern{.type = PatternType::consideration, .value = {}}, Pattern{.type = PatternType::consideration, .value = {}},
+            Pattern{.type = PatternType::pattern_lit, .value = text}};
+    default:
+        return {Pattern{.type = PatternType::introspection, .value = {}}, Pattern{.type = PatternType::pattern_lit, .value = text},
+            Pattern{.type = PatternType::retrospection, .value = {}}, Pattern{.type = PatternType::flocks_disintegration, .value = {}}};
+    }
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "generation.hpp"
+
+// Replaces constant lists and vectors built from literals, and single pattern literals, with the iota itself embedded
+// in the spell, when pushing it that way takes fewer patterns
+class ConstantEmbedder {
+public:
+    ConstantEmbedder(std::vector<Pattern> patterns);
+
+    std::vector<Pattern> embed();
+
+    // Lists and vectors embedded, and pattern literals escaped with Consideration
+    size_t num_embedded = 0;
+    // Vectors along an axis made by multiplying a vector reflection
+    size_t num_scaled_axes = 0;
+private:
+    // Constant pushed by the output from start to its end
+    struct ConstantIota {
+        size_t start;
+        // As it's written in an embedded iota
+        std::string text;
+        bool is_num;
+    };
+
+    // Ends run of constants on top of the stack, since what pattern does with them isn't known
+    void add_pattern(const Pattern& pattern);
+    void push_constant(const std::string& text, bool is_num);
+    // Combines constants on top of the stack into one, made by the patterns from start, replacing them with it
+    // embedded or with other patterns making it, whichever is shortest
+    void combine(size_t num_constants, const std::string& text, const std::vector<Pattern>& other = {});
+    // Patterns that push iota written as text, where the output currently is
+    std::vector<Pattern> escaped(const std::string& text) const;
+
+    std::vector<Pattern> m_patterns;
+    std::vector<Pattern> m_output;
+
+    // Constants pushed one after another, ending at the end of the output
+    std::vector<ConstantIota> m_constants;
+    // Number of code lists the output is in, each of which is read once before it runs
+    size_t m_depth = 0;
+};
\ No newline at end of file
@@ -0,0 +1,795 @@
+#include "evaluation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "effects.hpp"
+#include "folding.hpp"
+
+bool eval_is_truthy(const EvalValue& value)
+{
+    if (std::holds_alternative<std::vector<EvalValue>>(value.var))
+    {
+        return !std::get<std::vector<EvalValue>>(value.var).empty();
+    }
+    return const_is_truthy(std::get<Constant>(value.var));
+}
+
+size_t eval_size(const EvalValue& value)
+{
+    if (std::holds_alternative<Constant>(value.var))
+    {
+        return 1;
+    }
+
+    const std::vector<EvalValue>& list = std::get<std::vector<EvalValue>>(value.var);
+    size_t size = 1;
+    for (const EvalValue& elem : list)
+    {
+        size += eval_size(elem);
+    }
+    return size;
+}
+
+bool eval_equals(const EvalValue& lhs, const EvalValue& rhs)
+{
+    if (lhs.var.index() != rhs.var.index())
+    {
+        return false;
+    }
+
+    if (std::holds_alternative<Constant>(lhs.var))
+    {
+        return const_equals(std::get<Constant>(lhs.var), std::get<Constant>(rhs.var));
+    }
+
+    // Lists are equal when all their elements are
+    const std::vector<EvalValue>& lhs_list = std::get<std::vector<EvalValue>>(lhs.var);
+    const std::vector<EvalValue>& rhs_list = std::get<std::vector<EvalValue>>(rhs.var);
+    return std::equal(lhs_list.begin(), lhs_list.end(), rhs_list.begin(), rhs_list.end(), eval_equals);
+}
+
+// Number in value, if it's one
+static std::optional<double> eval_num(const EvalValue& value)
+{
+    if (!std::holds_alternative<Constant>(value.var) || !std::holds_alternative<double>(std::get<Constant>(value.var).var))
+    {
+        return {};
+    }
+    return std::get<double>(std::get<Constant>(value.var).var);
+}
+
+// Index in value, if it's an integer from 0 up to, but not including, size
+static std::optional<size_t> eval_index(const EvalValue& value, size_t size)
+{
+    std::optional<double> num = eval_num(value);
+    if (!num.has_value() || !is_exact_num(num.value()) || num.value() < 0 || num.value() >= size)
+    {
+        return {};
+    }
+    return (size_t)num.value();
+}
+
+Evaluator::Evaluator(const NodeProg* prog, const std::map<std::string, std::pair<Constant, size_t>>& global_values)
+    :m_prog(prog), m_global_values(global_values), m_ret_value(EvalValue{.var = Constant{.var = ConstNull{}}})
+{ }
+
+std::optional<EvalValue> Evaluator::eval_call(const NodeDefinedFunc* call)
+{
+    // Arguments are evaluated without any variables, so only constants get through
+    std::optional<std::vector<EvalValue>> args = eval_args(call);
+    if (!args.has_value())
+    {
+        return {};
+    }
+
+    // Results are embedded in the spell, so huge lists aren't worth it
+    std::optional<EvalValue> result = call_func(call->ident.value.value(), args.value(), false);
+    if (!result.has_value() || eval_size(result.value()) > max_result_size)
+    {
+        return {};
+    }
+    return result;
+}
+
+std::optional<EvalValue> Evaluator::call_func(const std::string& name, const std::vector<EvalValue>& args, bool is_void)
+{
+    std::vector<NodeFunctionDef*>::const_iterator iter = std::find_if(m_prog->funcs.begin(), m_prog->funcs.end(),
+        [&](const NodeFunctionDef* func_def){
+            const std::vector<Token>& params = std::holds_alternative<NodeFunctionDefVoid*>(func_def->var) ?
+                std::get<NodeFunctionDefVoid*>(func_def->var)->params : std::get<NodeFunctionDefRet*>(func_def->var)->params;
+            const Token& ident = std::holds_alternative<NodeFunctionDefVoid*>(func_def->var) ?
+                std::get<NodeFunctionDefVoid*>(func_def->var)->ident : std::get<NodeFunctionDefRet*>(func_def->var)->ident;
+            return ident.value.value() == name && params.size() == args.size();
+        });
+
+    // Void functions don't give a value
+    if (iter == m_prog->funcs.end() || (!is_void && std::holds_alternative<NodeFunctionDefVoid*>((*iter)->var)))
+    {
+        return {};
+    }
+
+    if (m_depth >= max_depth || !step())
+    {
+        return {};
+    }
+
+    bool is_func_void = std::holds_alternative<NodeFunctionDefVoid*>((*iter)->var);
+    const std::vector<Token>& params = is_func_void ?
+        std::get<NodeFunctionDefVoid*>((*iter)->var)->params : std::get<NodeFunctionDefRet*>((*iter)->var)->params;
+    const NodeScope* scope = is_func_void ?
+        std::get<NodeFunctionDefVoid*>((*iter)->var)->scope : std::get<NodeFunctionDefRet*>((*iter)->var)->scope;
+
+    // Called function can only see its own params and locals
+    std::vector<std::pair<std::string, EvalValue>> locals = std::move(m_locals);
+    bool was_void = m_is_void;
+    m_locals.clear();
+    for (size_t i = 0; i < params.size(); ++i)
+    {
+        m_locals.push_back(std::make_pair(params[i].value.value(), args[i]));
+    }
+    m_is_void = is_func_void;
+    m_ret_value = EvalValue{.var = Constant{.var = ConstNull{}}};
+    ++m_depth;
+
+    Flow flow = run_stmts(scope->stmts);
+
+    --m_depth;
+    m_is_void = was_void;
+    m_locals = std::move(locals);
+
+    if (flow == Flow::failed)
+    {
+        return {};
+    }
+
+    // Non-void functions that reach the end return null
+    if (flow == Flow::next)
+    {
+        return EvalValue{.var = Constant{.var = ConstNull{}}};
+    }
+    return m_ret_value;
+}
+
+std::optional<EvalValue> Evaluator::call_inbuilt(const NodeDefinedFunc* func)
+{
+    std::optional<std::vector<EvalValue>> args = eval_args(func);
+    if (!args.has_value())
+    {
+        return {};
+    }
+
+    std::vector<Constant> const_args;
+    for (const EvalValue& arg : args.value())
+    {
+        if (!std::holds_alternative<Constant>(arg.var))
+        {
+            return {};
+        }
+        const_args.push_back(std::get<Constant>(arg.var));
+    }
+
+    std::optional<Constant> result = fold_inbuilt_call(func->ident.value.value(), const_args);
+    if (!result.has_value())
+    {
+        return {};
+    }
+    return EvalValue{.var = result.value()};
+}
+
+std::optional<EvalValue> Evaluator::call_member(const EvalValue& object, const NodeDefinedFunc* func)
+{
+    std::optional<std::vector<EvalValue>> opt_args = eval_args(func);
+    if (!opt_args.has_value())
+    {
+        return {};
+    }
+
+    const std::string& func_name = func->ident.value.value();
+    const std::vector<EvalValue>& args = opt_args.value();
+
+    if (std::holds_alternative<Constant>(object.var))
+    {
+        const Constant& constant = std::get<Constant>(object.var);
+
+        if (std::holds_alternative<ConstVec>(constant.var) && args.empty() && (func_name == "x" || func_name == "y" || func_name == "z"))
+        {
+            const ConstVec& vec = std::get<ConstVec>(constant.var);
+            return EvalValue{.var = Constant{.var = func_name == "x" ? vec.x : func_name == "y" ? vec.y : vec.z}};
+        }
+        if (std::holds_alternative<double>(constant.var) && args.empty() && func_name == "abs")
+        {
+            return EvalValue{.var = Constant{.var = std::abs(std::get<double>(constant.var))}};
+        }
+        return {};
+    }
+
+    std::vector<EvalValue> list = std::get<std::vector<EvalValue>>(object.var);
+
+    if (func_name == "size" && args.empty()) {
+        return EvalValue{.var = Constant{.var = (double)list.size()}};
+    } else if ((func_name == "with" || func_name == "with_back") && args.size() == 1) {
+        list.push_back(args[0]);
+        return EvalValue{.var = list};
+    } else if (func_name == "with_front" && args.size() == 1) {
+        list.insert(list.begin(), args[0]);
+        return EvalValue{.var = list};
+    } else if (func_name == "back" && args.empty() && !list.empty()) {
+        return list.back();
+    } else if (func_name == "front" && args.empty() && !list.empty()) {
+        return list.front();
+    } else if (func_name == "reversed" && args.empty()) {
+        std::reverse(list.begin(), list.end());
+        return EvalValue{.var = list};
+    } else if (func_name == "sublist" && args.size() == 2) {
+        std::optional<size_t> start = eval_index(args[0], list.size() + 1);
+        std::optional<size_t> end = eval_index(args[1], list.size() + 1);
+        if (!start.has_value() || !end.has_value() || start.value() > end.value())
+        {
+            return {};
+        }
+        return EvalValue{.var = std::vector<EvalValue>(list.begin() + start.value(), list.begin() + end.value())};
+    } else if (func_name == "without_at" && args.size() == 1) {
+        std::optional<size_t> index = eval_index(args[0], list.size());
+        if (!index.has_value())
+        {
+            return {};
+        }
+        list.erase(list.begin() + index.value());
+        return EvalValue{.var = list};
+    } else if (func_name == "find" && args.size() == 1) {
+        std::vector<EvalValue>::const_iterator iter = std::find_if(list.begin(), list.end(),
+            [&](const EvalValue& elem){ return eval_equals(elem, args[0]); });
+        return EvalValue{.var = Constant{.var = iter == list.end() ? -1.0 : (double)(iter - list.begin())}};
+    } else if (func_name == const_subscript_func && args.size() == 1) {
+        // Same as a subscript, giving null past the ends of the list
+        std::optional<double> num = eval_num(args[0]);
+        if (!num.has_value() || !is_exact_num(num.value()))
+        {
+            return {};
+        }
+        if (num.value() < 0 || num.value() >= list.size())
+        {
+            return EvalValue{.var = Constant{.var = ConstNull{}}};
+        }
+        return list[(size_t)num.value()];
+    }
+
+    return {};
+}
+
+std::optional<std::vector<EvalValue>> Evaluator::eval_args(const NodeDefinedFunc* func)
+{
+    std::vector<EvalValue> args;
+    for (const NodeExpr* expr : func->exprs)
+    {
+        std::optional<EvalValue> arg = eval_expr(expr);
+        if (!arg.has_value())
+        {
+            return {};
+        }
+        args.push_back(std::move(arg.value()));
+    }
+    return args;
+}
+
+Evaluator::Flow Evaluator::run_stmts(const std::vector<NodeStmt*>& stmts)
+{
+    for (const NodeStmt* stmt : stmts)
+    {
+        Flow flow = run_stmt(stmt);
+        if (flow != Flow::next)
+        {
+            return flow;
+        }
+    }
+    return Flow::next;
+}
+
+Evaluator::Flow Evaluator::run_stmt(const NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        Evaluator& eval;
+        StmtVisitor (Evaluator& _eval) :eval(_eval) {}
+
+        Flow operator()(const NodeStmtCallFunction* call_func)
+        {
+            // Inbuilt functions are called before declared ones, and the void ones all do something besides giving a value
+            const std::string& func_name = call_func->func->ident.value.value();
+            if (inbuilt_effect(func_name, true, false) != Effect::unknown || inbuilt_effect(func_name, false, false) != Effect::unknown)
+            {
+                return Flow::failed;
+            }
+
+            std::optional<std::vector<EvalValue>> args = eval.eval_args(call_func->func);
+            if (!args.has_value() || !eval.call_func(func_name, args.value(), true).has_value())
+            {
+                return Flow::failed;
+            }
+            return Flow::next;
+        }
+
+        Flow operator()(const NodeStmtReturn* stmt_ret)
+        {
+            // Returns that don't match the function are left for the generator to report
+            if (eval.m_is_void == stmt_ret->expr.has_value())
+            {
+                return Flow::failed;
+            }
+
+            if (stmt_ret->expr.has_value())
+            {
+                std::optional<EvalValue> value = eval.eval_expr(stmt_ret->expr.value());
+                if (!value.has_value())
+                {
+                    return Flow::failed;
+                }
+                eval.m_ret_value = std::move(value.value());
+            }
+            return Flow::returned;
+        }
+
+        Flow operator()(const NodeExpr* stmt_expr)
+        {
+            return eval.eval_expr(stmt_expr).has_value() ? Flow::next : Flow::failed;
+        }
+
+        Flow operator()(const NodeStmtLet* stmt_let)
+        {
+            std::optional<EvalValue> value = eval.eval_expr(stmt_let->expr);
+            if (!value.has_value())
+            {
+                return Flow::failed;
+            }
+
+            eval.m_locals.push_back(std::make_pair(stmt_let->ident.value.value(), std::move(value.value())));
+            return Flow::next;
+        }
+
+        Flow operator()(const NodeStmtIf* stmt_if)
+        {
+            std::optional<EvalValue> condition = eval.eval_expr(stmt_if->expr);
+            if (!condition.has_value())
+            {
+                return Flow::failed;
+            }
+
+            if (eval_is_truthy(condition.value()))
+            {
+                return eval.run_scoped_stmt(stmt_if->stmt);
+            }
+            else if (stmt_if->else_stmt != nullptr)
+            {
+                return eval.run_scoped_stmt(stmt_if->else_stmt);
+            }
+            return Flow::next;
+        }
+
+        Flow operator()(const NodeStmtWhile* stmt_while)
+        {
+            while (true)
+            {
+                std::optional<EvalValue> condition = eval.eval_expr(stmt_while->expr);
+                if (!condition.has_value() || !eval.step())
+                {
+                    return Flow::failed;
+                }
+
+                if (!eval_is_truthy(condition.value()))
+                {
+                    return Flow::next;
+                }
+
+                Flow flow = eval.run_scoped_stmt(stmt_while->stmt);
+                if (flow != Flow::next)
+                {
+                    return flow;
+                }
+            }
+        }
+
+        Flow operator()(const NodeStmtFor* stmt_for)
+        {
+            std::optional<EvalValue> list = eval.eval_expr(stmt_for->expr);
+            if (!list.has_value() || !std::holds_alternative<std::vector<EvalValue>>(list.value().var))
+            {
+                return Flow::failed;
+            }
+
+            for (const EvalValue& elem : std::get<std::vector<EvalValue>>(list.value().var))
+            {
+                if (!eval.step())
+                {
+                    return Flow::failed;
+                }
+
+                eval.m_locals.push_back(std::make_pair(stmt_for->ident.value.value(), elem));
+                Flow flow = eval.run_scoped_stmt(stmt_for->stmt);
+                eval.m_locals.pop_back();
+                if (flow != Flow::next)
+                {
+                    return flow;
+                }
+            }
+            return Flow::next;
+        }
+
+        Flow operator()(const NodeScope* stmt_scope)
+        {
+            size_t num_locals = eval.m_locals.size();
+            Flow flow = eval.run_stmts(stmt_scope->stmts);
+            eval.m_locals.resize(num_locals);
+            return flow;
+        }
+    };
+
+    if (!step())
+    {
+        return Flow::failed;
+    }
+
+    StmtVisitor visitor(*this);
+    return std::visit(visitor, stmt->var);
+}
+
+Evaluator::Flow Evaluator::run_scoped_stmt(const NodeStmt* stmt)
+{
+    size_t num_locals = m_locals.size();
+    Flow flow = run_stmt(stmt);
+    m_locals.resize(num_locals);
+    return flow;
+}
+
+std::optional<EvalValue> Evaluator::eval_expr(const NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        return eval_term(std::get<NodeTerm*>(expr->var));
+    }
+    return eval_bin_expr(std::get<NodeExprBin*>(expr->var));
+}
+
+std::optional<EvalValue> Evaluator::eval_bin_expr(const NodeExprBin* expr_bin)
+{
+    switch (expr_bin->op_type)
+    {
+    case TokenType_::eq:
+    case TokenType_::plus_eq:
+    case TokenType_::dash_eq:
+    case TokenType_::star_eq:
+    case TokenType_::fslash_eq:
+    case TokenType_::mod_eq:
+    {
+        if (!std::holds_alternative<NodeTerm*>(expr_bin->lhs->var) ||
+            !std::holds_alternative<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var))
+        {
+            return {};
+        }
+
+        // Value is evaluated before the variable is touched
+        std::optional<EvalValue> value = eval_expr(expr_bin->rhs);
+        if (!value.has_value())
+        {
+            return {};
+        }
+        return eval_assignment(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var), value.value(), expr_bin->op_type, false);
+    }
+    // Right side is only evaluated if it decides the result
+    case TokenType_::double_amp:
+    case TokenType_::double_bar:
+    {
+        std::optional<EvalValue> lhs = eval_expr(expr_bin->lhs);
+        if (!lhs.has_value() || !std::holds_alternative<Constant>(lhs.value().var) ||
+            !std::holds_alternative<bool>(std::get<Constant>(lhs.value().var).var))
+        {
+            return {};
+        }
+        if (std::get<bool>(std::get<Constant>(lhs.value().var).var) == (expr_bin->op_type == TokenType_::double_bar))
+        {
+            return lhs;
+        }
+
+        std::optional<EvalValue> rhs = eval_expr(expr_bin->rhs);
+        if (!rhs.has_value() || !std::holds_alternative<Constant>(rhs.value().var) ||
+            !std::holds_alternative<bool>(std::get<Constant>(rhs.value().var).var))
+        {
+            return {};
+        }
+        return rhs;
+    }
+    case TokenType_::dot:
+    {
+        std::optional<EvalValue> object = eval_expr(expr_bin->lhs);
+        if (!object.has_value() || !std::holds_alternative<NodeTerm*>(expr_bin->rhs->var) ||
+            !std::holds_alternative<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var))
+        {
+            return {};
+        }
+        return call_member(object.value(), std::get<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var)->func);
+    }
+    default:
+        break;
+    }
+
+    std::optional<EvalValue> lhs = eval_expr(expr_bin->lhs);
+    std::optional<EvalValue> rhs = eval_expr(expr_bin->rhs);
+    if (!lhs.has_value() || !rhs.has_value())
+    {
+        return {};
+    }
+
+    // Comparisons work on any iotas
+    if (expr_bin->op_type == TokenType_::double_eq || expr_bin->op_type == TokenType_::not_eq_)
+    {
+        return EvalValue{.var = Constant{.var = eval_equals(lhs.value(), rhs.value()) == (expr_bin->op_type == TokenType_::double_eq)}};
+    }
+
+    // Adding lists joins them
+    if (std::holds_alternative<std::vector<EvalValue>>(lhs.value().var) || std::holds_alternative<std::vector<EvalValue>>(rhs.value().var))
+    {
+        if (expr_bin->op_type != TokenType_::plus || !std::holds_alternative<std::vector<EvalValue>>(lhs.value().var) ||
+            !std::holds_alternative<std::vector<EvalValue>>(rhs.value().var))
+        {
+            return {};
+        }
+
+        std::vector<EvalValue> list = std::get<std::vector<EvalValue>>(lhs.value().var);
+        const std::vector<EvalValue>& rhs_list = std::get<std::vector<EvalValue>>(rhs.value().var);
+        list.insert(list.end(), rhs_list.begin(), rhs_list.end());
+        return EvalValue{.var = list};
+    }
+
+    std::optional<Constant> result = fold_bin_op(expr_bin->op_type, std::get<Constant>(lhs.value().var), std::get<Constant>(rhs.value().var));
+    if (!result.has_value())
+    {
+        return {};
+    }
+    return EvalValue{.var = result.value()};
+}
+
+std::optional<EvalValue> Evaluator::eval_term(const NodeTerm* term)
+{
+    struct TermVisitor {
+        Evaluator& eval;
+        TermVisitor (Evaluator& _eval) :eval(_eval) {}
+
+        std::optional<EvalValue> operator()(const NodeTermUn* term_un)
+        {
+            if (term_un->op_type == TokenType_::double_plus || term_un->op_type == TokenType_::double_dash)
+            {
+                if (!std::holds_alternative<NodeTermVar*>(term_un->term->var))
+                {
+                    return {};
+                }
+                return eval.eval_assignment(std::get<NodeTermVar*>(term_un->term->var),
+                    EvalValue{.var = Constant{.var = term_un->op_type == TokenType_::double_plus ? 1.0 : -1.0}}, TokenType_::plus_eq, false);
+            }
+
+            std::optional<EvalValue> operand = eval.eval_term(term_un->term);
+            if (!operand.has_value() || !std::holds_alternative<Constant>(operand.value().var))
+            {
+                return {};
+            }
+
+            std::optional<Constant> result = fold_un_op(term_un->op_type, std::get<Constant>(operand.value().var));
+            if (!result.has_value())
+            {
+                return {};
+            }
+            return EvalValue{.var = result.value()};
+        }
+
+        std::optional<EvalValue> operator()(const NodeTermUnPost* term_un_post)
+        {
+            return eval.eval_assignment(term_un_post->vari,
+                EvalValue{.var = Constant{.var = term_un_post->op_type == TokenType_::double_plus ? 1.0 : -1.0}}, TokenType_::plus_eq, true);
+        }
+
+        std::optional<EvalValue> operator()(const NodeTermNumLit* term_num_lit)
+        {
+            std::optional<Constant> num = const_from_num_lit(term_num_lit->num_lit.value.value());
+            if (!num.has_value())
+            {
+                return {};
+            }
+            return EvalValue{.var = num.value()};
+        }
+
+        std::optional<EvalValue> operator()(const NodeTermListLit* term_list_lit)
+        {
+            std::vector<EvalValue> list;
+            for (const NodeExpr* expr : term_list_lit->exprs)
+            {
+                std::optional<EvalValue> elem = eval.eval_expr(expr);
+                if (!elem.has_value())
+                {
+                    return {};
+                }
+                list.push_back(std::move(elem.value()));
+            }
+            return EvalValue{.var = list};
+        }
+
+        std::optional<EvalValue> operator()(const NodeTermPatternLit*)
+        {
+            return {};
+        }
+
+        std::optional<EvalValue> operator()(const NodeTermBoolLit* term_bool_lit)
+        {
+            return EvalValue{.var = Constant{.var = term_bool_lit->bool_.value == "true"}};
+        }
+
+        std::optional<EvalValue> operator()(const NodeTermNullLit*)
+        {
+            return EvalValue{.var = Constant{.var = ConstNull{}}};
+        }
+
+        std::optional<EvalValue> operator()(const NodeTermVar* term_var)
+        {
+            if (std::holds_alternative<NodeVarIdent*>(term_var->var))
+            {
+                return eval.read_var(std::get<NodeVarIdent*>(term_var->var)->ident.value.value());
+            }
+
+            const NodeVarListSubscript* subscript = std::get<NodeVarListSubscript*>(term_var->var);
+            std::optional<EvalValue> list = eval.read_var(subscript->ident.value.value());
+            std::optional<EvalValue> index = eval.eval_expr(subscript->expr);
+            if (!list.has_value() || !index.has_value() || !std::holds_alternative<std::vector<EvalValue>>(list.value().var))
+            {
+                return {};
+            }
+
+            // Selection Distillation gives null past the ends of the list
+            const std::vector<EvalValue>& elems = std::get<std::vector<EvalValue>>(list.value().var);
+            std::optional<double> num = eval_num(index.value());
+            if (!num.has_value() || !is_exact_num(num.value()))
+            {
+                return {};
+            }
+            if (num.value() < 0 || num.value() >= elems.size())
+            {
+                return EvalValue{.var = Constant{.var = ConstNull{}}};
+            }
+            return elems[(size_t)num.value()];
+        }
+
+        std::optional<EvalValue> operator()(const NodeTermParen* term_paren)
+        {
+            return eval.eval_expr(term_paren->expr);
+        }
+
+        std::optional<EvalValue> operator()(const NodeTermCallFunc* call_func)
+        {
+            // Inbuilt functions are called before declared ones with the same name
+            const std::string& func_name = call_func->func->ident.value.value();
+            if (inbuilt_effect(func_name, false, false) != Effect::unknown)
+            {
+                return eval.call_inbuilt(call_func->func);
+            }
+
+            std::optional<std::vector<EvalValue>> args = eval.eval_args(call_func->func);
+            if (!args.has_value())
+            {
+                return {};
+            }
+            return eval.call_func(func_name, args.value(), false);
+        }
+
+        std::optional<EvalValue> operator()(const NodeTermTernary* term_ternary)
+        {
+            std::optional<EvalValue> condition = eval.eval_expr(term_ternary->expr);
+            if (!condition.has_value())
+            {
+                return {};
+            }
+            return eval.eval_expr(eval_is_truthy(condition.value()) ? term_ternary->then_expr : term_ternary->else_expr);
+        }
+    };
+
+    TermVisitor visitor(*this);
+    return std::visit(visitor, term->var);
+}
+
+std::optional<EvalValue> Evaluator::eval_assignment(const NodeTermVar* var, const EvalValue& value, TokenType_ op, bool is_post)
+{
+    const std::string& name = std::holds_alternative<NodeVarIdent*>(var->var) ?
+        std::get<NodeVarIdent*>(var->var)->ident.value.value() : std::get<NodeVarListSubscript*>(var->var)->ident.value.value();
+
+    // Globals can't be written at compile time
+    EvalValue* local = find_local(name);
+    if (local == nullptr)
+    {
+        return {};
+    }
+
+    // Assigning to an element makes a new list with it replaced
+    std::optional<size_t> index = {};
+    if (std::holds_alternative<NodeVarListSubscript*>(var->var))
+    {
+        std::optional<EvalValue> index_value = eval_expr(std::get<NodeVarListSubscript*>(var->var)->expr);
+        // Evaluating the index can declare nothing, but can assign to locals, so look the variable up again
+        local = find_local(name);
+        if (!index_value.has_value() || !std::holds_alternative<std::vector<EvalValue>>(local->var))
+        {
+            return {};
+        }
+
+        index = eval_index(index_value.value(), std::get<std::vector<EvalValue>>(local->var).size());
+        if (!index.has_value())
+        {
+            return {};
+        }
+    }
+
+    EvalValue& target = index.has_value() ? std::get<std::vector<EvalValue>>(local->var)[index.value()] : *local;
+    EvalValue old_value = target;
+
+    if (op == TokenType_::eq)
+    {
+        target = value;
+    }
+    else
+    {
+        static const std::map<TokenType_, TokenType_> bin_ops = {
+            {TokenType_::plus_eq, TokenType_::plus},
+            {TokenType_::dash_eq, TokenType_::dash},
+            {TokenType_::star_eq, TokenType_::star},
+            {TokenType_::fslash_eq, TokenType_::slash_forward},
+            {TokenType_::mod_eq, TokenType_::modulus},
+        };
+
+        if (!std::holds_alternative<Constant>(target.var) || !std::holds_alternative<Constant>(value.var))
+        {
+            return {};
+        }
+
+        std::optional<Constant> result = fold_bin_op(bin_ops.at(op), std::get<Constant>(target.var), std::get<Constant>(value.var));
+        if (!result.has_value())
+        {
+            return {};
+        }
+        target = EvalValue{.var = result.value()};
+    }
+
+    // Assigning to an element gives the whole list, and the order of what's left of a post-op on an element isn't worth
+    // copying
+    if (index.has_value())
+    {
+        if (is_post)
+        {
+            return {};
+        }
+        return *local;
+    }
+    return is_post ? old_value : target;
+}
+
+std::optional<EvalValue> Evaluator::read_var(const std::string& name)
+{
+    EvalValue* local = find_local(name);
+    if (local != nullptr)
+    {
+        return *local;
+    }
+
+    // Only globals that were found to be constant have a known value
+    std::map<std::string, std::pair<Constant, size_t>>::const_iterator iter = m_global_values.find(name);
+    if (iter == m_global_values.end())
+    {
+        return {};
+    }
+    return EvalValue{.var = iter->second.first};
+}
+
+EvalValue* Evaluator::find_local(const std::string& name)
+{
+    std::vector<std::pair<std::string, EvalValue>>::reverse_iterator iter = std::find_if(m_locals.rbegin(), m_locals.rend(),
+        [&](const std::pair<std::string, EvalValue>& local){ return local.first == name; });
+    return iter == m_locals.rend() ? nullptr : &iter->second;
+}
+
+bool Evaluator::step()
+{
+    return ++m_num_steps <= max_steps;
+}
\ No newline at end of file
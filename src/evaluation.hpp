@@ -0,0 +1,77 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "parser.hpp"
+#include "constant.hpp"
+
+// Value of an iota while code is run at compile time, which unlike a constant can also be a list
+struct EvalValue {
+    std::variant<Constant, std::vector<EvalValue>> var;
+};
+
+// Runs calls to declared functions at compile time, so calls that only depend on their constant arguments can be
+// replaced by their results
+class Evaluator {
+public:
+    // Global values are the constant globals, which are the only ones that can be read
+    Evaluator(const NodeProg* prog, const std::map<std::string, std::pair<Constant, size_t>>& global_values);
+
+    // Result of call, or nothing if its arguments aren't constant, running it would do anything but compute its result,
+    // mishap, or take more than max_steps, or the result is a list of more than max_result_size iotas
+    std::optional<EvalValue> eval_call(const NodeDefinedFunc* call);
+private:
+    // How running statements ended
+    enum class Flow {
+        next,
+        returned,
+        // Hit something that can't be done at compile time
+        failed,
+    };
+
+    std::optional<EvalValue> call_func(const std::string& name, const std::vector<EvalValue>& args, bool is_void);
+    std::optional<EvalValue> call_inbuilt(const NodeDefinedFunc* func);
+    std::optional<EvalValue> call_member(const EvalValue& object, const NodeDefinedFunc* func);
+    std::optional<std::vector<EvalValue>> eval_args(const NodeDefinedFunc* func);
+
+    Flow run_stmts(const std::vector<NodeStmt*>& stmts);
+    Flow run_stmt(const NodeStmt* stmt);
+    // Runs statement in its own scope, so variables declared in it are forgotten after
+    Flow run_scoped_stmt(const NodeStmt* stmt);
+
+    std::optional<EvalValue> eval_expr(const NodeExpr* expr);
+    std::optional<EvalValue> eval_bin_expr(const NodeExprBin* expr_bin);
+    std::optional<EvalValue> eval_term(const NodeTerm* term);
+    // Value is what's assigned, or what op is done with, and post-ops give the variable's value from before
+    std::optional<EvalValue> eval_assignment(const NodeTermVar* var, const EvalValue& value, TokenType_ op, bool is_post);
+
+    std::optional<EvalValue> read_var(const std::string& name);
+    EvalValue* find_local(const std::string& name);
+
+    // Counts a statement, loop or call, returns false once the limit is hit
+    bool step();
+
+    const NodeProg* m_prog;
+    const std::map<std::string, std::pair<Constant, size_t>>& m_global_values;
+
+    // Params and locals of the function being run, in the order they're declared
+    std::vector<std::pair<std::string, EvalValue>> m_locals;
+    bool m_is_void = false;
+    EvalValue m_ret_value;
+    size_t m_num_steps = 0;
+    size_t m_depth = 0;
+
+    static const size_t max_steps = 100000;
+    static const size_t max_depth = 256;
+    static const size_t max_result_size = 256;
+};
+
+bool eval_is_truthy(const EvalValue& value);
+// Number of iotas in value, counting the elements of lists and the lists themselves
+size_t eval_size(const EvalValue& value);
+bool eval_equals(const EvalValue& lhs, const EvalValue& rhs);
\ No newline at end of file
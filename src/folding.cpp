@@ -0,0 +1,955 @@
+#include "folding.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "util.hpp"
+#include "effects.hpp"
+
+static std::optional<Constant> const_from_term(const NodeTerm* term)
+{
+    if (std::holds_alternative<NodeTermNumLit*>(term->var))
+    {
+        return const_from_num_lit(std::get<NodeTermNumLit*>(term->var)->num_lit.value.value());
+    }
+    else if (std::holds_alternative<NodeTermBoolLit*>(term->var))
+    {
+        return Constant{.var = std::get<NodeTermBoolLit*>(term->var)->bool_.value == "true"};
+    }
+    else if (std::holds_alternative<NodeTermNullLit*>(term->var))
+    {
+        return Constant{.var = ConstNull{}};
+    }
+    else if (std::holds_alternative<NodeTermCallFunc*>(term->var))
+    {
+        // Folded vectors are left as a call to vec with number literals
+        const NodeDefinedFunc* func = std::get<NodeTermCallFunc*>(term->var)->func;
+        if (func->ident.value.value() != "vec" || func->exprs.size() != 3)
+        {
+            return {};
+        }
+
+        std::optional<Constant> x = const_from_expr(func->exprs[0]);
+        std::optional<Constant> y = const_from_expr(func->exprs[1]);
+        std::optional<Constant> z = const_from_expr(func->exprs[2]);
+        if (!x.has_value() || !y.has_value() || !z.has_value() || !std::holds_alternative<double>(x.value().var) ||
+            !std::holds_alternative<double>(y.value().var) || !std::holds_alternative<double>(z.value().var))
+        {
+            return {};
+        }
+
+        return Constant{.var = ConstVec{.x = std::get<double>(x.value().var), .y = std::get<double>(y.value().var),
+            .z = std::get<double>(z.value().var)}};
+    }
+
+    return {};
+}
+
+std::optional<Constant> const_from_expr(const NodeExpr* expr)
+{
+    if (!std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        return {};
+    }
+
+    return const_from_term(std::get<NodeTerm*>(expr->var));
+}
+
+// Term of already folded expression if it's a literal, including pattern literals and lists of literals
+static const NodeTerm* literal_term(const NodeExpr* expr)
+{
+    while (std::holds_alternative<NodeTerm*>(expr->var) && std::holds_alternative<NodeTermParen*>(std::get<NodeTerm*>(expr->var)->var))
+    {
+        expr = std::get<NodeTermParen*>(std::get<NodeTerm*>(expr->var)->var)->expr;
+    }
+
+    if (!std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        return nullptr;
+    }
+
+    const NodeTerm* term = std::get<NodeTerm*>(expr->var);
+    if (std::holds_alternative<NodeTermPatternLit*>(term->var) || const_from_term(term).has_value())
+    {
+        return term;
+    }
+    if (!std::holds_alternative<NodeTermListLit*>(term->var))
+    {
+        return nullptr;
+    }
+
+    for (const NodeExpr* elem : std::get<NodeTermListLit*>(term->var)->exprs)
+    {
+        if (literal_term(elem) == nullptr)
+        {
+            return nullptr;
+        }
+    }
+    return term;
+}
+
+static bool is_const_decl(const NodeStmt* stmt)
+{
+    return std::holds_alternative<NodeStmtLet*>(stmt->var) && std::get<NodeStmtLet*>(stmt->var)->is_const;
+}
+
+std::optional<Constant> fold_inbuilt_call(const std::string& func_name, const std::vector<Constant>& args)
+{
+    static const std::map<std::string, ConstVec> axis_vecs = {
+        {"vec0", ConstVec{.x = 0, .y = 0, .z = 0}},
+        {"vecXP", ConstVec{.x = 1, .y = 0, .z = 0}},
+        {"vecXN", ConstVec{.x = -1, .y = 0, .z = 0}},
+        {"vecYP", ConstVec{.x = 0, .y = 1, .z = 0}},
+        {"vec_up", ConstVec{.x = 0, .y = 1, .z = 0}},
+        {"vecYN", ConstVec{.x = 0, .y = -1, .z = 0}},
+        {"vec_down", ConstVec{.x = 0, .y = -1, .z = 0}},
+        {"vecZP", ConstVec{.x = 0, .y = 0, .z = 1}},
+        {"vecZN", ConstVec{.x = 0, .y = 0, .z = -1}},
+    };
+    std::map<std::string, ConstVec>::const_iterator axis_vec = axis_vecs.find(func_name);
+    if (axis_vec != axis_vecs.end() && args.empty())
+    {
+        return Constant{.var = axis_vec->second};
+    }
+
+    // Otherwise only pure math functions on numbers are folded
+    std::vector<double> nums;
+    for (const Constant& arg : args)
+    {
+        if (!std::holds_alternative<double>(arg.var))
+        {
+            return {};
+        }
+
+        nums.push_back(std::get<double>(arg.var));
+    }
+
+    double result;
+
+    if (func_name == "pow" && nums.size() == 2) {
+        result = std::pow(nums[0], nums[1]);
+    } else if (func_name == "floor" && nums.size() == 1) {
+        result = std::floor(nums[0]);
+    } else if (func_name == "ceil" && nums.size() == 1) {
+        result = std::ceil(nums[0]);
+    } else if (func_name == "min" && nums.size() == 2) {
+        result = std::min(nums[0], nums[1]);
+    } else if (func_name == "max" && nums.size() == 2) {
+        result = std::max(nums[0], nums[1]);
+    } else if (func_name == "vec" && nums.size() == 3) {
+        return Constant{.var = ConstVec{.x = nums[0], .y = nums[1], .z = nums[2]}};
+    } else {
+        return {};
+    }
+
+    if (!is_exact_num(result))
+    {
+        return {};
+    }
+
+    return Constant{.var = result};
+}
+
+ConstantFolder::ConstantFolder(NodeProg* prog)
+    :m_prog(prog), m_allocator(1024 * 1024 * 4)
+{ }
+
+void ConstantFolder::fold()
+{
+    // Constants are taken out before the generator could find them declared twice
+    for (size_t i = 0; i < m_prog->vars.size(); ++i)
+    {
+        for (size_t j = 0; j < i; ++j)
+        {
+            if (m_prog->vars[j]->ident.value == m_prog->vars[i]->ident.value && (m_prog->vars[i]->is_const || m_prog->vars[j]->is_const))
+            {
+                compilation_error(std::string("Global identifier already used: ") + m_prog->vars[i]->ident.value.value(), m_prog->vars[i]->line);
+            }
+        }
+    }
+
+    // Constant globals can make more expressions constant, including the values of other globals
+    do
+    {
+        m_fixed_globals.clear();
+        fold_prog();
+    } while (find_const_globals());
+
+    // Constant globals no longer need a place in raven's mind
+    for (const NodeGlobalLet* global_let : m_prog->vars)
+    {
+        if (m_global_values.count(global_let->ident.value.value()) > 0)
+        {
+            const_globals.push_back(global_let->ident.value.value());
+        }
+    }
+
+    // Neither do constants, which were replaced by their literal where used
+    std::erase_if(m_prog->vars, [&](const NodeGlobalLet* global_let){
+        return global_let->is_const || m_global_values.count(global_let->ident.value.value()) > 0; });
+}
+
+void ConstantFolder::fold_prog()
+{
+    for (m_global_index = 0; m_global_index < m_prog->vars.size(); ++m_global_index)
+    {
+        m_locals.clear();
+        m_local_consts.clear();
+        const NodeGlobalLet* global_let = m_prog->vars[m_global_index];
+        fold_expr(global_let->expr);
+
+        if (global_let->is_const)
+        {
+            const NodeTerm* literal = literal_term(global_let->expr);
+            if (literal == nullptr)
+            {
+                compilation_error(std::string("Value of constant must be known at compile time: ") + global_let->ident.value.value(), global_let->line);
+            }
+            m_global_consts[global_let->ident.value.value()] = std::make_pair(literal, m_global_index);
+        }
+    }
+
+    for (NodeFunctionDef* func_def : m_prog->funcs)
+    {
+        fold_func_def(func_def);
+    }
+
+    fold_func_def(m_prog->main_);
+}
+
+bool ConstantFolder::find_const_globals()
+{
+    bool found_new = false;
+
+    for (size_t i = 0; i < m_prog->vars.size(); ++i)
+    {
+        const std::string& name = m_prog->vars[i]->ident.value.value();
+        if (m_prog->vars[i]->is_const || m_global_values.count(name) > 0 || m_fixed_globals.count(name) > 0)
+        {
+            continue;
+        }
+
+        // Globals declared twice are left for the generator to report
+        if (std::count_if(m_prog->vars.begin(), m_prog->vars.end(),
+            [&](const NodeGlobalLet* global_let){ return global_let->ident.value.value() == name; }) > 1)
+        {
+            continue;
+        }
+
+        std::optional<Constant> value = const_from_expr(m_prog->vars[i]->expr);
+        if (value.has_value())
+        {
+            m_global_values.emplace(name, std::make_pair(value.value(), i));
+            found_new = true;
+        }
+    }
+
+    return found_new;
+}
+
+std::optional<Constant> ConstantFolder::fold_expr(NodeExpr* expr)
+{
+    struct ExprVisitor {
+        ConstantFolder& folder;
+        NodeExpr* expr;
+        ExprVisitor (ConstantFolder& _folder, NodeExpr* _expr) :folder(_folder), expr(_expr) {}
+
+        std::optional<Constant> operator()(NodeTerm* term)
+        {
+            return folder.fold_term(term);
+        }
+
+        std::optional<Constant> operator()(NodeExprBin* expr_bin)
+        {
+            switch (expr_bin->op_type)
+            {
+            // Only the value and subscript of assignments can be folded
+            case TokenType_::eq:
+            case TokenType_::plus_eq:
+            case TokenType_::dash_eq:
+            case TokenType_::star_eq:
+            case TokenType_::fslash_eq:
+            case TokenType_::mod_eq:
+                if (std::holds_alternative<NodeTerm*>(expr_bin->lhs->var) &&
+                    std::holds_alternative<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var))
+                {
+                    folder.check_assignable(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var), expr_bin->line);
+                    folder.fix_var(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var));
+                    folder.fold_var(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var));
+                }
+                folder.fold_expr(expr_bin->rhs);
+                return {};
+            // Member functions can only have their object and arguments folded, other than getting the components of
+            // a vector
+            case TokenType_::dot:
+            {
+                std::optional<Constant> object = folder.fold_expr(expr_bin->lhs);
+                if (!std::holds_alternative<NodeTerm*>(expr_bin->rhs->var) ||
+                    !std::holds_alternative<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var))
+                {
+                    return {};
+                }
+
+                NodeDefinedFunc* func = std::get<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var)->func;
+                folder.fold_func_args(func);
+
+                const std::string& func_name = func->ident.value.value();
+                if (!object.has_value() || !std::holds_alternative<ConstVec>(object.value().var) || !func->exprs.empty() ||
+                    (func_name != "x" && func_name != "y" && func_name != "z"))
+                {
+                    return {};
+                }
+
+                const ConstVec& vec = std::get<ConstVec>(object.value().var);
+                Constant result = Constant{.var = func_name == "x" ? vec.x : func_name == "y" ? vec.y : vec.z};
+
+                NodeTerm* term = folder.m_allocator.alloc<NodeTerm>();
+                term->line = expr_bin->line;
+                folder.set_const_term(term, result);
+                expr->var = term;
+                return result;
+            }
+            default:
+                break;
+            }
+
+            std::optional<Constant> lhs = folder.fold_expr(expr_bin->lhs);
+            std::optional<Constant> rhs = folder.fold_expr(expr_bin->rhs);
+
+            if (!lhs.has_value() || !rhs.has_value())
+            {
+                return {};
+            }
+
+            std::optional<Constant> result = fold_bin_op(expr_bin->op_type, lhs.value(), rhs.value());
+            if (result.has_value())
+            {
+                // Replace binary expression with literal
+                NodeTerm* term = folder.m_allocator.alloc<NodeTerm>();
+                term->line = expr_bin->line;
+                folder.set_const_term(term, result.value());
+                expr->var = term;
+            }
+
+            return result;
+        }
+    };
+
+    ExprVisitor visitor(*this, expr);
+    return std::visit(visitor, expr->var);
+}
+
+std::optional<Constant> ConstantFolder::fold_term(NodeTerm* term)
+{
+    struct TermVisitor {
+        ConstantFolder& folder;
+        NodeTerm* term;
+        TermVisitor (ConstantFolder& _folder, NodeTerm* _term) :folder(_folder), term(_term) {}
+
+        std::optional<Constant> operator()(NodeTermUn* term_un)
+        {
+            // Pre-increment and decrement are assignments
+            if (term_un->op_type == TokenType_::double_plus || term_un->op_type == TokenType_::double_dash)
+            {
+                if (std::holds_alternative<NodeTermVar*>(term_un->term->var))
+                {
+                    folder.check_assignable(std::get<NodeTermVar*>(term_un->term->var), term_un->line);
+                    folder.fix_var(std::get<NodeTermVar*>(term_un->term->var));
+                    folder.fold_var(std::get<NodeTermVar*>(term_un->term->var));
+                }
+                return {};
+            }
+
+            std::optional<Constant> operand = folder.fold_term(term_un->term);
+            if (!operand.has_value())
+            {
+                return {};
+            }
+
+            std::optional<Constant> result = fold_un_op(term_un->op_type, operand.value());
+            if (result.has_value())
+            {
+                folder.set_const_term(term, result.value());
+            }
+
+            return result;
+        }
+
+        std::optional<Constant> operator()(NodeTermUnPost* term_un_post)
+        {
+            folder.check_assignable(term_un_post->vari, term_un_post->line);
+            folder.fix_var(term_un_post->vari);
+            folder.fold_var(term_un_post->vari);
+            return {};
+        }
+
+        std::optional<Constant> operator()(NodeTermNumLit* term_num_lit)
+        {
+            return const_from_num_lit(term_num_lit->num_lit.value.value());
+        }
+
+        std::optional<Constant> operator()(NodeTermListLit* term_list_lit)
+        {
+            for (NodeExpr* expr : term_list_lit->exprs)
+            {
+                folder.fold_expr(expr);
+            }
+            return {};
+        }
+
+        std::optional<Constant> operator()(NodeTermPatternLit*)
+        {
+            return {};
+        }
+
+        std::optional<Constant> operator()(NodeTermBoolLit* term_bool_lit)
+        {
+            return Constant{.var = term_bool_lit->bool_.value == "true"};
+        }
+
+        std::optional<Constant> operator()(NodeTermNullLit*)
+        {
+            return Constant{.var = ConstNull{}};
+        }
+
+        std::optional<Constant> operator()(NodeTermVar* term_var)
+        {
+            folder.fold_var(term_var);
+
+            // Constant is replaced by a copy of its literal, which may fold further
+            const NodeTerm* literal = folder.find_const(std::holds_alternative<NodeVarIdent*>(term_var->var) ?
+                std::get<NodeVarIdent*>(term_var->var)->ident.value.value() : std::get<NodeVarListSubscript*>(term_var->var)->ident.value.value());
+            if (literal != nullptr)
+            {
+                if (std::holds_alternative<NodeVarListSubscript*>(term_var->var))
+                {
+                    folder.set_subscript_term(term, literal, std::get<NodeVarListSubscript*>(term_var->var)->expr);
+                }
+                else
+                {
+                    folder.set_literal_term(term, literal);
+                }
+                return folder.fold_term(term);
+            }
+
+            // Literals can't be indexed into
+            if (std::holds_alternative<NodeVarListSubscript*>(term_var->var))
+            {
+                folder.fix_var(term_var);
+                return {};
+            }
+
+            // Replace constant global with its value
+            const std::string& name = std::get<NodeVarIdent*>(term_var->var)->ident.value.value();
+            std::map<std::string, std::pair<Constant, size_t>>::iterator iter = folder.m_global_values.find(name);
+            if (folder.is_local(name) || iter == folder.m_global_values.end() || iter->second.second >= folder.m_global_index)
+            {
+                return {};
+            }
+
+            Constant value = iter->second.first;
+            folder.set_const_term(term, value);
+            return value;
+        }
+
+        std::optional<Constant> operator()(NodeTermParen* term_paren)
+        {
+            std::optional<Constant> result = folder.fold_expr(term_paren->expr);
+            if (result.has_value())
+            {
+                folder.set_const_term(term, result.value());
+            }
+            return result;
+        }
+
+        std::optional<Constant> operator()(NodeTermCallFunc* call_func)
+        {
+            folder.fold_func_args(call_func->func);
+
+            // Vectors are already left as the call that makes them
+            std::optional<Constant> result = folder.fold_inbuilt_func(call_func->func);
+            if (result.has_value() && call_func->func->ident.value.value() != "vec")
+            {
+                folder.set_const_term(term, result.value());
+            }
+            // Functions can't be called while globals are set, since they aren't stored yet
+            if (result.has_value() || inbuilt_effect(call_func->func->ident.value.value(), false, false) != Effect::unknown ||
+                folder.m_global_index < folder.m_prog->vars.size())
+            {
+                return result;
+            }
+
+            // Declared function called with constants can be run now, if it only computes its result
+            Evaluator evaluator(folder.m_prog, folder.m_global_values);
+            std::optional<EvalValue> value = evaluator.eval_call(call_func->func);
+            if (!value.has_value())
+            {
+                return {};
+            }
+
+            folder.set_value_term(term, value.value());
+            ++folder.num_evaluated_calls;
+            folder.evaluated_funcs.insert(FuncKey(call_func->func->ident.value.value(), call_func->func->exprs.size()));
+
+            if (!std::holds_alternative<Constant>(value.value().var))
+            {
+                return {};
+            }
+            return std::get<Constant>(value.value().var);
+        }
+
+        std::optional<Constant> operator()(NodeTermTernary* term_ternary)
+        {
+            std::optional<Constant> condition = folder.fold_expr(term_ternary->expr);
+            std::optional<Constant> then_value = folder.fold_expr(term_ternary->then_expr);
+            std::optional<Constant> else_value = folder.fold_expr(term_ternary->else_expr);
+            if (!condition.has_value())
+            {
+                return {};
+            }
+
+            std::optional<Constant> result = const_is_truthy(condition.value()) ? then_value : else_value;
+            if (result.has_value())
+            {
+                folder.set_const_term(term, result.value());
+            }
+            return result;
+        }
+    };
+
+    TermVisitor visitor(*this, term);
+    return std::visit(visitor, term->var);
+}
+
+void ConstantFolder::fold_stmt(NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        ConstantFolder& folder;
+        StmtVisitor (ConstantFolder& _folder) :folder(_folder) {}
+
+        void operator()(NodeStmtCallFunction* call_func)
+        {
+            folder.fold_func_args(call_func->func);
+        }
+
+        void operator()(NodeStmtReturn* stmt_ret)
+        {
+            if (stmt_ret->expr.has_value())
+            {
+                folder.fold_expr(stmt_ret->expr.value());
+            }
+        }
+
+        void operator()(NodeExpr* stmt_expr)
+        {
+            folder.fold_expr(stmt_expr);
+        }
+
+        void operator()(NodeStmtLet* stmt_let)
+        {
+            folder.fold_expr(stmt_let->expr);
+            const std::string& name = stmt_let->ident.value.value();
+            folder.check_declarable(name, stmt_let->is_const, stmt_let->line);
+
+            if (!stmt_let->is_const)
+            {
+                folder.m_locals.push_back(name);
+                return;
+            }
+
+            const NodeTerm* literal = literal_term(stmt_let->expr);
+            if (literal == nullptr)
+            {
+                compilation_error(std::string("Value of constant must be known at compile time: ") + name, stmt_let->line);
+            }
+            folder.m_local_consts.push_back(std::make_pair(name, literal));
+        }
+
+        void operator()(NodeStmtIf* stmt_if)
+        {
+            if (stmt_if->is_switch_case)
+            {
+                folder.check_switch_case(stmt_if);
+            }
+
+            folder.fold_expr(stmt_if->expr);
+            folder.fold_body(stmt_if->stmt);
+            if (stmt_if->else_stmt != nullptr)
+            {
+                folder.fold_body(stmt_if->else_stmt);
+            }
+        }
+
+        void operator()(NodeStmtWhile* stmt_while)
+        {
+            folder.fold_expr(stmt_while->expr);
+            folder.fold_body(stmt_while->stmt);
+        }
+
+        // Element variable is a local, so it hides globals and can't be named after a constant
+        void operator()(NodeStmtFor* stmt_for)
+        {
+            folder.fold_expr(stmt_for->expr);
+            folder.check_declarable(stmt_for->ident.value.value(), false, stmt_for->line);
+            folder.m_locals.push_back(stmt_for->ident.value.value());
+            folder.fold_body(stmt_for->stmt);
+            folder.m_locals.pop_back();
+        }
+
+        void operator()(NodeScope* stmt_scope)
+        {
+            folder.fold_scope(stmt_scope);
+        }
+    };
+
+    StmtVisitor visitor(*this);
+    std::visit(visitor, stmt->var);
+}
+
+std::optional<Constant> ConstantFolder::fold_inbuilt_func(NodeDefinedFunc* func)
+{
+    std::vector<Constant> args;
+    for (NodeExpr* expr : func->exprs)
+    {
+        if (!std::holds_alternative<NodeTerm*>(expr->var))
+        {
+            return {};
+        }
+
+        std::optional<Constant> arg = fold_term(std::get<NodeTerm*>(expr->var));
+        if (!arg.has_value())
+        {
+            return {};
+        }
+
+        args.push_back(arg.value());
+    }
+
+    return fold_inbuilt_call(func->ident.value.value(), args);
+}
+
+void ConstantFolder::fold_func_args(NodeDefinedFunc* func)
+{
+    for (NodeExpr* expr : func->exprs)
+    {
+        fold_expr(expr);
+    }
+}
+
+void ConstantFolder::fold_var(NodeTermVar* var)
+{
+    if (std::holds_alternative<NodeVarListSubscript*>(var->var))
+    {
+        fold_expr(std::get<NodeVarListSubscript*>(var->var)->expr);
+    }
+}
+
+void ConstantFolder::fold_scope(NodeScope* scope)
+{
+    size_t num_locals = m_locals.size();
+    size_t num_consts = m_local_consts.size();
+
+    for (NodeStmt* stmt : scope->stmts)
+    {
+        fold_stmt(stmt);
+    }
+
+    m_locals.resize(num_locals);
+    m_local_consts.resize(num_consts);
+
+    // Constants were replaced where used, so they don't take a slot
+    std::erase_if(scope->stmts, is_const_decl);
+}
+
+void ConstantFolder::fold_body(NodeStmt* stmt)
+{
+    size_t num_locals = m_locals.size();
+    size_t num_consts = m_local_consts.size();
+
+    fold_stmt(stmt);
+
+    m_locals.resize(num_locals);
+    m_local_consts.resize(num_consts);
+
+    // Constant on its own can't be used by anything
+    if (is_const_decl(stmt))
+    {
+        NodeScope* scope = m_allocator.alloc<NodeScope>();
+        scope->line = stmt->line;
+        stmt->var = scope;
+    }
+}
+
+void ConstantFolder::check_switch_case(NodeStmtIf* stmt_if)
+{
+    // Each case's if compares the switch's value with the case's value, and the next case is its else
+    NodeExpr* value = std::get<NodeExprBin*>(stmt_if->expr->var)->rhs;
+    fold_expr(value);
+    std::optional<Constant> constant = const_from_expr(value);
+    if (!constant.has_value())
+    {
+        return;
+    }
+
+    NodeStmt* next = stmt_if->else_stmt;
+    while (next != nullptr && std::holds_alternative<NodeStmtIf*>(next->var) && std::get<NodeStmtIf*>(next->var)->is_switch_case)
+    {
+        NodeStmtIf* next_if = std::get<NodeStmtIf*>(next->var);
+        NodeExpr* next_value = std::get<NodeExprBin*>(next_if->expr->var)->rhs;
+        fold_expr(next_value);
+        std::optional<Constant> next_constant = const_from_expr(next_value);
+        if (next_constant.has_value() && const_equals(constant.value(), next_constant.value()))
+        {
+            compilation_error("Switch already has a case with this value", next_value->line);
+        }
+        next = next_if->else_stmt;
+    }
+}
+
+void ConstantFolder::fold_func_def(NodeFunctionDef* func_def)
+{
+    m_locals.clear();
+    m_local_consts.clear();
+
+    if (std::holds_alternative<NodeFunctionDefVoid*>(func_def->var))
+    {
+        const NodeFunctionDefVoid* func_void = std::get<NodeFunctionDefVoid*>(func_def->var);
+        for (const Token& param : func_void->params)
+        {
+            m_locals.push_back(param.value.value());
+        }
+        fold_scope(func_void->scope);
+    }
+    else
+    {
+        const NodeFunctionDefRet* func_ret = std::get<NodeFunctionDefRet*>(func_def->var);
+        for (const Token& param : func_ret->params)
+        {
+            m_locals.push_back(param.value.value());
+        }
+        fold_scope(func_ret->scope);
+    }
+}
+
+bool ConstantFolder::is_local(const std::string& name)
+{
+    return std::find(m_locals.begin(), m_locals.end(), name) != m_locals.end();
+}
+
+void ConstantFolder::fix_var(const NodeTermVar* var)
+{
+    const std::string& name = std::holds_alternative<NodeVarIdent*>(var->var) ?
+        std::get<NodeVarIdent*>(var->var)->ident.value.value() : std::get<NodeVarListSubscript*>(var->var)->ident.value.value();
+
+    if (!is_local(name))
+    {
+        m_fixed_globals.insert(name);
+    }
+}
+
+const NodeTerm* ConstantFolder::find_const(const std::string& name)
+{
+    std::vector<std::pair<std::string, const NodeTerm*>>::const_iterator local = std::find_if(m_local_consts.cbegin(), m_local_consts.cend(),
+        [&](const std::pair<std::string, const NodeTerm*>& local_const){ return local_const.first == name; });
+    if (local != m_local_consts.cend())
+    {
+        return local->second;
+    }
+
+    // Locals hide globals, and globals can only use those declared before them
+    std::map<std::string, std::pair<const NodeTerm*, size_t>>::const_iterator global = m_global_consts.find(name);
+    if (is_local(name) || global == m_global_consts.cend() || global->second.second >= m_global_index)
+    {
+        return nullptr;
+    }
+    return global->second.first;
+}
+
+void ConstantFolder::check_assignable(const NodeTermVar* var, size_t line)
+{
+    const std::string& name = std::holds_alternative<NodeVarIdent*>(var->var) ?
+        std::get<NodeVarIdent*>(var->var)->ident.value.value() : std::get<NodeVarListSubscript*>(var->var)->ident.value.value();
+
+    if (find_const(name) != nullptr)
+    {
+        compilation_error(std::string("Constant can't be assigned to: ") + name, line);
+    }
+}
+
+void ConstantFolder::check_declarable(const std::string& name, bool is_const, size_t line)
+{
+    // Constants are left out of the generator, so it can't find them declared twice in a function
+    if ((is_const && is_local(name)) || std::find_if(m_local_consts.cbegin(), m_local_consts.cend(),
+        [&](const std::pair<std::string, const NodeTerm*>& local_const){ return local_const.first == name; }) != m_local_consts.cend())
+    {
+        compilation_error(std::string("Identifier already used: ") + name, line);
+    }
+}
+
+void ConstantFolder::set_const_term(NodeTerm* term, const Constant& constant)
+{
+    if (std::holds_alternative<double>(constant.var))
+    {
+        NodeTermNumLit* num_lit = m_allocator.alloc<NodeTermNumLit>();
+        num_lit->num_lit = Token{.type = TokenType_::num_lit, .value = num_to_string(std::get<double>(constant.var)), .line = term->line};
+        num_lit->line = term->line;
+        term->var = num_lit;
+    }
+    else if (std::holds_alternative<bool>(constant.var))
+    {
+        NodeTermBoolLit* bool_lit = m_allocator.alloc<NodeTermBoolLit>();
+        bool_lit->bool_ = Token{.type = TokenType_::bool_lit, .value = std::get<bool>(constant.var) ? "true" : "false", .line = term->line};
+        bool_lit->line = term->line;
+        term->var = bool_lit;
+    }
+    else if (std::holds_alternative<ConstVec>(constant.var))
+    {
+        const ConstVec& vec = std::get<ConstVec>(constant.var);
+        NodeDefinedFunc* func = m_allocator.alloc<NodeDefinedFunc>();
+        func->ident = Token{.type = TokenType_::ident, .value = "vec", .line = term->line};
+        func->line = term->line;
+        for (double component : {vec.x, vec.y, vec.z})
+        {
+            NodeTerm* component_term = m_allocator.alloc<NodeTerm>();
+            component_term->line = term->line;
+            set_const_term(component_term, Constant{.var = component});
+
+            NodeExpr* expr = m_allocator.alloc<NodeExpr>();
+            expr->var = component_term;
+            expr->line = term->line;
+            func->exprs.push_back(expr);
+        }
+
+        NodeTermCallFunc* call_func = m_allocator.alloc<NodeTermCallFunc>();
+        call_func->func = func;
+        call_func->line = term->line;
+        term->var = call_func;
+    }
+    else
+    {
+        NodeTermNullLit* null_lit = m_allocator.alloc<NodeTermNullLit>();
+        null_lit->line = term->line;
+        term->var = null_lit;
+    }
+}
+
+void ConstantFolder::set_value_term(NodeTerm* term, const EvalValue& value)
+{
+    if (std::holds_alternative<Constant>(value.var))
+    {
+        set_const_term(term, std::get<Constant>(value.var));
+        return;
+    }
+
+    NodeTermListLit* list_lit = m_allocator.alloc<NodeTermListLit>();
+    list_lit->line = term->line;
+    for (const EvalValue& elem : std::get<std::vector<EvalValue>>(value.var))
+    {
+        NodeTerm* elem_term = m_allocator.alloc<NodeTerm>();
+        elem_term->line = term->line;
+        set_value_term(elem_term, elem);
+
+        NodeExpr* expr = m_allocator.alloc<NodeExpr>();
+        expr->var = elem_term;
+        expr->line = term->line;
+        list_lit->exprs.push_back(expr);
+    }
+    term->var = list_lit;
+}
+
+void ConstantFolder::set_literal_term(NodeTerm* term, const NodeTerm* literal)
+{
+    if (std::holds_alternative<NodeTermParen*>(literal->var))
+    {
+        set_literal_term(term, literal_term(std::get<NodeTermParen*>(literal->var)->expr));
+    }
+    else if (std::holds_alternative<NodeTermPatternLit*>(literal->var))
+    {
+        NodeTermPatternLit* pattern_lit = m_allocator.alloc<NodeTermPatternLit>();
+        *pattern_lit = *std::get<NodeTermPatternLit*>(literal->var);
+        term->var = pattern_lit;
+    }
+    else if (std::holds_alternative<NodeTermListLit*>(literal->var))
+    {
+        NodeTermListLit* list_lit = m_allocator.alloc<NodeTermListLit>();
+        list_lit->line = term->line;
+        for (const NodeExpr* elem : std::get<NodeTermListLit*>(literal->var)->exprs)
+        {
+            NodeTerm* elem_term = m_allocator.alloc<NodeTerm>();
+            elem_term->line = term->line;
+            set_literal_term(elem_term, std::get<NodeTerm*>(elem->var));
+
+            NodeExpr* expr = m_allocator.alloc<NodeExpr>();
+            expr->var = elem_term;
+            expr->line = term->line;
+            list_lit->exprs.push_back(expr);
+        }
+        term->var = list_lit;
+    }
+    else
+    {
+        set_const_term(term, const_from_term(literal).value());
+    }
+}
+
+void ConstantFolder::set_subscript_term(NodeTerm* term, const NodeTerm* literal, NodeExpr* index)
+{
+    // Constant index picks the element now, and Selection Distillation gives null past the ends of the list
+    std::optional<Constant> index_value = const_from_expr(index);
+    if (std::holds_alternative<NodeTermListLit*>(literal->var) && index_value.has_value() &&
+        std::holds_alternative<double>(index_value.value().var) && is_exact_num(std::get<double>(index_value.value().var)))
+    {
+        const std::vector<NodeExpr*>& elems = std::get<NodeTermListLit*>(literal->var)->exprs;
+        double num = std::get<double>(index_value.value().var);
+        if (num < 0 || num >= elems.size())
+        {
+            set_const_term(term, Constant{.var = ConstNull{}});
+        }
+        else
+        {
+            set_literal_term(term, std::get<NodeTerm*>(elems[(size_t)num]->var));
+        }
+        return;
+    }
+
+    // Otherwise the literal is indexed when the spell runs, as (literal).constant subscript(index)
+    NodeTerm* list_term = m_allocator.alloc<NodeTerm>();
+    list_term->line = term->line;
+    set_literal_term(list_term, literal);
+
+    NodeExpr* list_expr = m_allocator.alloc<NodeExpr>();
+    list_expr->var = list_term;
+    list_expr->line = term->line;
+
+    NodeDefinedFunc* func = m_allocator.alloc<NodeDefinedFunc>();
+    func->ident = Token{.type = TokenType_::ident, .value = const_subscript_func, .line = term->line};
+    func->exprs.push_back(index);
+    func->line = term->line;
+
+    NodeTermCallFunc* call_func = m_allocator.alloc<NodeTermCallFunc>();
+    call_func->func = func;
+    call_func->line = term->line;
+
+    NodeTerm* call_term = m_allocator.alloc<NodeTerm>();
+    call_term->var = call_func;
+    call_term->line = term->line;
+
+    NodeExpr* call_expr = m_allocator.alloc<NodeExpr>();
+    call_expr->var = call_term;
+    call_expr->line = term->line;
+
+    NodeExprBin* expr_bin = m_allocator.alloc<NodeExprBin>();
+    expr_bin->op_type = TokenType_::dot;
+    expr_bin->lhs = list_expr;
+    expr_bin->rhs = call_expr;
+    expr_bin->line = term->line;
+
+    NodeExpr* expr = m_allocator.alloc<NodeExpr>();
+    expr->var = expr_bin;
+    expr->line = term->line;
+
+    NodeTermParen* paren = m_allocator.alloc<NodeTermParen>();
+    paren->expr = expr;
+    paren->line = term->line;
+    term->var = paren;
+}
\ No newline at end of file
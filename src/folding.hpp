@@ -0,0 +1,85 @@
+#pragma once
+
+#include <map>
+#include <set>
+
+#include "parser.hpp"
+#include "constant.hpp"
+#include "evaluation.hpp"
+#include "inlining.hpp"
+
+// Value of an already folded expression, if it's a literal
+std::optional<Constant> const_from_expr(const NodeExpr* expr);
+// Result of calling an inbuilt function that only depends on its arguments, if it can be computed at compile time
+std::optional<Constant> fold_inbuilt_call(const std::string& func_name, const std::vector<Constant>& args);
+
+// Hidden member that indexes into a constant list, since it has no variable to subscript
+const std::string const_subscript_func = "constant subscript";
+
+class ConstantFolder {
+public:
+    ConstantFolder(NodeProg* prog);
+
+    void fold();
+
+    // Folds everything constant inside of expression, returns value of expression if the whole thing is constant
+    std::optional<Constant> fold_expr(NodeExpr* expr);
+    std::optional<Constant> fold_term(NodeTerm* term);
+    void fold_stmt(NodeStmt* stmt);
+    void fold_func_def(NodeFunctionDef* func_def);
+
+    // Replaces contents of term with literal of constant
+    void set_const_term(NodeTerm* term, const Constant& constant);
+
+    // Globals that were never written to and replaced by their values where used
+    std::vector<std::string> const_globals;
+    // Calls to declared functions replaced by their results
+    size_t num_evaluated_calls = 0;
+    // Declared functions that had calls replaced by their results
+    std::set<FuncKey> evaluated_funcs;
+private:
+    void fold_prog();
+    // Finds globals set to a constant that are never written to, returns whether any new ones were found
+    bool find_const_globals();
+
+    std::optional<Constant> fold_inbuilt_func(NodeDefinedFunc* func);
+    void fold_func_args(NodeDefinedFunc* func);
+    void fold_var(NodeTermVar* var);
+    void fold_scope(NodeScope* scope);
+    // Folds body of if, while or for, which declares nothing outside of it even if it isn't a scope
+    void fold_body(NodeStmt* stmt);
+    // Errors if a later case of the switch has the same value as this one, since it could never run
+    void check_switch_case(NodeStmtIf* stmt_if);
+
+    // Whether identifier refers to a local variable or param where it's used
+    bool is_local(const std::string& name);
+    // Called when variable is written to or used in a way a literal can't replace
+    void fix_var(const NodeTermVar* var);
+    // Literal of constant with name where it's used, or null if it isn't a constant there
+    const NodeTerm* find_const(const std::string& name);
+    // Errors if variable is a constant
+    void check_assignable(const NodeTermVar* var, size_t line);
+    // Errors if local or constant with name can't be declared where it is
+    void check_declarable(const std::string& name, bool is_const, size_t line);
+
+    // Replaces contents of term with literal of constant, but value can also be a list of constants
+    void set_value_term(NodeTerm* term, const EvalValue& value);
+    // Replaces contents of term with a copy of literal
+    void set_literal_term(NodeTerm* term, const NodeTerm* literal);
+    // Replaces contents of term with element index of list literal
+    void set_subscript_term(NodeTerm* term, const NodeTerm* literal, NodeExpr* index);
+
+    NodeProg* m_prog;
+    ArenaAllocator m_allocator;
+
+    // Locals and params declared in the function being folded
+    std::vector<std::string> m_locals;
+    // Index of the global being declared, since globals can only use those declared before them
+    size_t m_global_index;
+    std::set<std::string> m_fixed_globals;
+    // Value and index of each constant global
+    std::map<std::string, std::pair<Constant, size_t>> m_global_values;
+    // Literal and index of each global declared with const, and literal of each local one in scope
+    std::map<std::string, std::pair<const NodeTerm*, size_t>> m_global_consts;
+    std::vector<std::pair<std::string, const NodeTerm*>> m_local_consts;
+};
\ No newline at end of file
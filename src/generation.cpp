@@ -3,9 +3,13 @@
 #include <sstream>
 
 #include "util.hpp"
+#include "folding.hpp"
+#include "inlining.hpp"
+#include "effects.hpp"
+#include "invariance.hpp"
 
-Generator::Generator(const NodeProg* prog)
-    :m_prog(prog)
+Generator::Generator(const NodeProg* prog, UnrollGoal unroll_goal, size_t unroll_budget, Profile profile)
+    :m_prog(prog), m_liveness(prog), m_unroll_goal(unroll_goal), m_unroll_budget(unroll_budget), m_profile(std::move(profile))
 { }
 
 std::vector<Pattern> Generator::generate()
@@ -488,6 +492,10 @@ bool Generator::gen_inbuilt_func(const NodeDefinedFunc* func, bool is_void, bool
                 try_gen_x_exprs(func->exprs, 1, func->line);
                 locators_distillation();
                 return true;
+            } else if (func_name == const_subscript_func) {
+                try_gen_x_exprs(func->exprs, 1, func->line);
+                selection_distillation();
+                return true;
             }
         }
         else
@@ -927,6 +935,12 @@ bool Generator::gen_call_func(const NodeDefinedFunc* func)
         compilation_error(std::string("No function defined with this name with the passed number of parameters: ") + func->ident.value.value(), func->line);
     }
 
+    if (iter->is_inlined)
+    {
+        gen_inline_call(*iter, func);
+        return iter->is_void;
+    }
+
     // Generate expressions
     for (NodeExpr* expr : func->exprs)
     {
@@ -952,6 +966,210 @@ bool Generator::gen_call_func(const NodeDefinedFunc* func)
     return iter->is_void;
 }
 
+void Generator::gen_inline_call(const Func& func, const NodeDefinedFunc* call)
+{
+    // Save state of function being inlined into
+    size_t frame_var_start = m_frame_var_start;
+    size_t var_num = m_vars.size();
+    size_t scope_num = m_scopes.size();
+    bool was_unreachable = m_unreachable;
+
+    const std::vector<Token>& params = std::holds_alternative<NodeFunctionDefVoid*>(func.def->var) ?
+        std::get<NodeFunctionDefVoid*>(func.def->var)->params : std::get<NodeFunctionDefRet*>(func.def->var)->params;
+    const NodeScope* scope = std::holds_alternative<NodeFunctionDefVoid*>(func.def->var) ?
+        std::get<NodeFunctionDefVoid*>(func.def->var)->scope : std::get<NodeFunctionDefRet*>(func.def->var)->scope;
+
+    // Generate expressions, which become params. Params the body never uses are left off the stack, instead of being
+    // copied there just to be popped by the return, as long as leaving out their expression can't change anything
+    std::vector<bool> is_param_kept;
+    for (size_t i = 0; i < call->exprs.size(); ++i)
+    {
+        is_param_kept.push_back(uses_var(scope->stmts, params[i].value.value()) || !can_speculate_expr(call->exprs[i]));
+        if (is_param_kept.back())
+        {
+            gen_expr(call->exprs[i]);
+        }
+    }
+
+    // Frame starts after the expressions, since they can move variables off the stack
+    size_t num_kept = std::count(is_param_kept.begin(), is_param_kept.end(), true);
+    InlineFrame frame {.stack_base = m_stack_size - num_kept, .is_void = func.is_void};
+
+    m_frame_var_start = m_vars.size();
+
+    size_t stack_loc = frame.stack_base;
+    for (size_t i = 0; i < params.size(); ++i)
+    {
+        if (is_param_kept[i])
+        {
+            m_vars.push_back(Var{.name = params[i].value.value(), .stack_loc = stack_loc++, .is_global = false});
+        }
+    }
+
+    gen_inline_stmts({InlineRest{.stmts = &scope->stmts, .start = 0, .ends_scope = false}}, frame);
+
+    // Only return value is left
+    m_stack_size = frame.stack_base + (func.is_void ? 0 : 1);
+
+    m_frame_var_start = frame_var_start;
+    m_vars.resize(var_num);
+    m_scopes.resize(scope_num);
+    m_unreachable = was_unreachable || m_unreachable;
+}
+
+void Generator::gen_inline_stmts(std::vector<InlineRest> rest, const InlineFrame& frame)
+{
+    while (!rest.empty())
+    {
+        InlineRest curr = rest.back();
+        rest.pop_back();
+
+        bool entered_scope = false;
+        for (size_t i = curr.start; i < curr.stmts->size(); ++i)
+        {
+            const NodeStmt* stmt = curr.stmts->at(i);
+
+            if (!contains_return(stmt))
+            {
+                gen_stmt(stmt);
+                continue;
+            }
+
+            if (std::holds_alternative<NodeStmtReturn*>(stmt->var))
+            {
+                gen_inline_return(std::get<NodeStmtReturn*>(stmt->var), frame, stmt->line);
+                return;
+            }
+
+            rest.push_back(InlineRest{.stmts = curr.stmts, .start = i + 1, .ends_scope = curr.ends_scope});
+
+            // Scope's statements are followed by the rest
+            if (std::holds_alternative<NodeScope*>(stmt->var))
+            {
+                begin_scope();
+                rest.push_back(InlineRest{.stmts = &std::get<NodeScope*>(stmt->var)->stmts, .start = 0, .ends_scope = true});
+                entered_scope = true;
+                break;
+            }
+
+            // Otherwise it's an if, and the rest of the statements go in whichever branch can reach them
+            const NodeStmtIf* stmt_if = std::get<NodeStmtIf*>(stmt->var);
+            std::optional<Constant> condition = const_from_expr(stmt_if->expr);
+            bool was_unreachable = m_unreachable;
+            bool runs_stmt = !condition.has_value() || const_is_truthy(condition.value());
+            bool runs_else = !condition.has_value() || !const_is_truthy(condition.value());
+
+            // Evaluate expression, which is left out along with the jump if it's constant
+            m_unreachable = was_unreachable || condition.has_value();
+            gen_expr(stmt_if->expr);
+            augurs_purification();
+            --m_stack_size;
+
+            // Both branches start from the same stack, even if one moved variables off of it
+            size_t stack_size = m_stack_size;
+            std::vector<Var> vars = m_vars;
+            std::vector<Scope> scopes = m_scopes;
+
+            // Generate statement
+            add_pattern(PatternType::introspection, 0);
+            m_unreachable = was_unreachable || !runs_stmt;
+            gen_inline_branch(stmt_if->stmt, rest, frame);
+            bool stmt_unreachable = m_unreachable || !runs_stmt;
+            m_unreachable = was_unreachable || condition.has_value();
+            add_pattern(PatternType::retrospection, 0);
+
+            m_stack_size = stack_size;
+            m_vars = std::move(vars);
+            m_scopes = std::move(scopes);
+
+            // Generate else statement, which is needed even if there's no else for the rest of the statements
+            add_pattern(PatternType::introspection, 0);
+            m_unreachable = was_unreachable || !runs_else;
+            gen_inline_branch(stmt_if->else_stmt, rest, frame);
+            bool else_unreachable = m_unreachable || !runs_else;
+            m_unreachable = was_unreachable || condition.has_value();
+            add_pattern(PatternType::retrospection, 0);
+
+            // Perform bool comparison and execute
+            add_pattern(PatternType::augurs_exaltation, 0);
+            add_pattern(PatternType::hermes_gambit, 0);
+
+            m_unreachable = was_unreachable || (stmt_unreachable && else_unreachable);
+            return;
+        }
+
+        if (entered_scope)
+        {
+            continue;
+        }
+
+        // Ran out of statements, so the scope they were in ends
+        if (curr.ends_scope)
+        {
+            end_scope();
+        }
+    }
+
+    // Reached end of function without returning
+    gen_inline_return(nullptr, frame, 0);
+}
+
+void Generator::gen_inline_branch(const NodeStmt* branch, std::vector<InlineRest> rest, const InlineFrame& frame)
+{
+    if (branch == nullptr)
+    {
+        gen_inline_stmts(rest, frame);
+        return;
+    }
+
+    begin_scope();
+
+    if (std::holds_alternative<NodeScope*>(branch->var))
+    {
+        rest.push_back(InlineRest{.stmts = &std::get<NodeScope*>(branch->var)->stmts, .start = 0, .ends_scope = true});
+        gen_inline_stmts(rest, frame);
+    }
+    else
+    {
+        std::vector<NodeStmt*> branch_stmts {const_cast<NodeStmt*>(branch)};
+        rest.push_back(InlineRest{.stmts = &branch_stmts, .start = 0, .ends_scope = true});
+        gen_inline_stmts(rest, frame);
+    }
+}
+
+void Generator::gen_inline_return(const NodeStmtReturn* stmt_ret, const InlineFrame& frame, size_t line)
+{
+    bool has_ret_value = stmt_ret != nullptr && stmt_ret->expr.has_value();
+
+    // Error check for passing/not passing expression into return
+    if (stmt_ret != nullptr && frame.is_void && has_ret_value)
+    {
+        compilation_error("Returning expression from void function", line);
+    }
+
+    if (stmt_ret != nullptr && !frame.is_void && !has_ret_value)
+    {
+        compilation_error("Return must have expression in non-void functions", line);
+    }
+
+    if (has_ret_value)
+    {
+        gen_expr(stmt_ret->expr.value());
+    }
+    // Non-void functions return null by default
+    else if (!frame.is_void)
+    {
+        nullary_reflection();
+    }
+
+    // Remove params and locals, keeping return value if there is one
+    size_t pop_count = m_stack_size - frame.stack_base - (frame.is_void ? 0 : 1);
+    if (pop_count > 0)
+    {
+        add_pattern(PatternType::bookkeepers_gambit, -pop_count, std::string(pop_count, 'v') + (frame.is_void ? "" : "-"));
+    }
+}
+
 void Generator::gen_bin_expr(const NodeExprBin* expr_bin)
 {
     // If binary expression is a type of assignment
@@ -974,6 +1192,11 @@ void Generator::gen_bin_expr(const NodeExprBin* expr_bin)
         return;
     }
 
+    if ((expr_bin->op_type == TokenType_::double_amp || expr_bin->op_type == TokenType_::double_bar) && try_gen_short_circuit(expr_bin))
+    {
+        return;
+    }
+
     gen_expr(expr_bin->lhs);
 
     // If binary expression is calling a member function
@@ -1056,7 +1279,7 @@ void Generator::gen_bin_expr(const NodeExprBin* expr_bin)
 
 Generator::Var Generator::gen_var_ident(const std::string ident_name, size_t line, bool dont_gen_if_global, bool leave_copy)
 {
-    std::vector<Var>::iterator iter = std::find_if(m_vars.begin(), m_vars.end(),
+    std::vector<Var>::iterator iter = std::find_if(m_vars.begin() + m_frame_var_start, m_vars.end(),
         [&](const Var& var){ return var.name == ident_name; });
     
     if (iter == m_vars.end())
@@ -1102,22 +1325,52 @@ void Generator::gen_var(const NodeTermVar* var)
 {
     struct VarVisitor {
         Generator& gen;
-        VarVisitor (Generator& _gen) :gen(_gen) {}
+        bool is_last_read;
+        VarVisitor (Generator& _gen, bool _is_last_read) :gen(_gen), is_last_read(_is_last_read) {}
         
         void operator()(const NodeVarIdent* var_ident)
         {
-            gen.gen_var_ident(var_ident->ident.value.value(), var_ident->line);
+            // Variable of a loop being unrolled is known, or known relative to what it holds
+            std::optional<Induction> induction = gen.find_induction(var_ident->ident.value.value());
+            if (induction.has_value() && !induction.value().is_offset)
+            {
+                gen.gen_constant(Constant{.var = induction.value().value});
+                return;
+            }
+
+            gen_read(var_ident->ident.value.value(), var_ident->line);
+
+            if (induction.has_value() && induction.value().value != 0)
+            {
+                gen.numerical_reflection(num_to_string(induction.value().value));
+                gen.additive_distillation();
+            }
         }
 
         void operator()(const NodeVarListSubscript* var_list)
         {
-            gen.gen_var_ident(var_list->ident.value.value(), var_list->line);
+            gen_read(var_list->ident.value.value(), var_list->line);
             gen.gen_expr(var_list->expr);
             gen.selection_distillation();
         }
+
+        // Last read of a local takes its value instead of a copy
+        void gen_read(const std::string& name, size_t line)
+        {
+            Var var = gen.gen_var_ident(name, line, false, !is_last_read);
+            if (is_last_read && !var.is_global)
+            {
+                gen.free_var_slot(name);
+
+                if (!gen.m_unreachable)
+                {
+                    ++gen.num_moved_reads;
+                }
+            }
+        }
     };
 
-    VarVisitor visitor(*this);
+    VarVisitor visitor(*this, m_liveness.is_last_read(var) && !m_in_common_expr);
     std::visit(visitor, var->var);
 }
 
@@ -1228,383 +1481,1629 @@ void Generator::gen_term(const NodeTerm* term)
                 compilation_error("Calling void function as non-void function", call_func->line);
             }
         }
+        void operator()(const NodeTermTernary* term_ternary)
+        {
+            gen.gen_select(term_ternary->expr, term_ternary->then_expr, term_ternary->else_expr);
+        }
     };
 
     TermVisitor visitor(*this);
     std::visit(visitor, term->var);
 }
 
-void Generator::gen_expr(const NodeExpr* expr)
+void Generator::gen_select(const NodeExpr* condition, const NodeExpr* then_expr, const NodeExpr* else_expr)
 {
-    struct ExprVisitor {
-        Generator& gen;
-        ExprVisitor (Generator& _gen) :gen(_gen) {}
-        
-        void operator()(const NodeTerm* term)
-        {
-            gen.gen_term(term);
-        }
+    // If condition is constant, only the value it picks is generated
+    std::optional<Constant> const_condition = const_from_expr(condition);
+    if (const_condition.has_value())
+    {
+        bool is_then = const_is_truthy(const_condition.value());
+        measure([&](){ gen_expr(is_then ? else_expr : then_expr); });
+        gen_expr(is_then ? then_expr : else_expr);
+        return;
+    }
 
-        void operator()(const NodeExprBin* expr_bin)
-        {
-            gen.gen_bin_expr(expr_bin);
-        }
-    };
+    gen_expr(condition);
+    augurs_purification();
 
-    ExprVisitor visitor(*this);
-    std::visit(visitor, expr->var);
+    if (is_select_branchless(then_expr, else_expr))
+    {
+        gen_expr(then_expr);
+        gen_expr(else_expr);
+        augurs_exaltation();
+        return;
+    }
+
+    gen_branches([&](){ gen_expr(then_expr); }, [&](){ gen_expr(else_expr); });
 }
 
-void Generator::gen_stmt(const NodeStmt* stmt)
+void Generator::gen_branches(const std::function<void()>& gen_then, const std::function<void()>& gen_else)
 {
-    struct StmtVisitor {
-        Generator& gen;
-        StmtVisitor(Generator& _gen) :gen(_gen) {}
+    // Condition is used up before either branch runs
+    --m_stack_size;
+    size_t stack_size = m_stack_size;
 
-        void operator()(const NodeStmtCallFunction* call_func)
-        {
-            // Try to gen void inbuilt func first, then non-void inbuilt func, then defined func
-            if (!gen.gen_inbuilt_func(call_func->func, true, false))
-            {
-                if (gen.gen_inbuilt_func(call_func->func, false, false) || !gen.gen_call_func(call_func->func))
-                {
-                    gen.pop();
-                }
-            }
-        }
+    add_pattern(PatternType::introspection, 0);
+    gen_then();
+    add_pattern(PatternType::retrospection, 0);
 
-        void operator()(const NodeStmtReturn* stmt_ret)
-        {
-            // Error check for passing/not passing expression into return
-            if (gen.generating_void_function && stmt_ret->expr.has_value())
-            {
-                compilation_error("Returning expression from void function", stmt_ret->line);
-            }
+    m_stack_size = stack_size;
 
-            if (!gen.generating_void_function && !stmt_ret->expr.has_value())
-            {
-                compilation_error("Return must have expression in non-void functions", stmt_ret->line);
-            }
+    add_pattern(PatternType::introspection, 0);
+    gen_else();
+    add_pattern(PatternType::retrospection, 0);
 
-            // Generate expression if there is one
-            if (stmt_ret->expr.has_value())
-            {
-                gen.gen_expr(stmt_ret->expr.value());
-            }
+    add_pattern(PatternType::augurs_exaltation, 0);
+    add_pattern(PatternType::hermes_gambit, 0);
+}
 
-            // Remove scope items from stack
-            gen.end_scopes_return(stmt_ret->expr.has_value());
+static bool is_bool_expr(const NodeExpr* expr);
 
-            // If there's an expression on the stack, swap it with jump iota
-            if (stmt_ret->expr.has_value())
-            {
-                gen.jesters_gambit();
-            }
+static bool is_bool_term(const NodeTerm* term)
+{
+    if (std::holds_alternative<NodeTermBoolLit*>(term->var))
+    {
+        return true;
+    }
+    if (std::holds_alternative<NodeTermParen*>(term->var))
+    {
+        return is_bool_expr(std::get<NodeTermParen*>(term->var)->expr);
+    }
+    if (std::holds_alternative<NodeTermUn*>(term->var))
+    {
+        const NodeTermUn* term_un = std::get<NodeTermUn*>(term->var);
+        return term_un->op_type == TokenType_::not_ && is_bool_term(term_un->term);
+    }
+    if (std::holds_alternative<NodeTermTernary*>(term->var))
+    {
+        const NodeTermTernary* term_ternary = std::get<NodeTermTernary*>(term->var);
+        return is_bool_expr(term_ternary->then_expr) && is_bool_expr(term_ternary->else_expr);
+    }
+    return false;
+}
 
-            // Execute jump iota
-            gen.add_pattern(PatternType::hermes_gambit, 0);
-        }
+// Whether expression always gives a bool, as long as it doesn't mishap
+static bool is_bool_expr(const NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        return is_bool_term(std::get<NodeTerm*>(expr->var));
+    }
 
-        void operator()(const NodeExpr* stmt_expr)
-        {
-            gen.gen_expr(stmt_expr);
-            gen.pop();
-        }
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+    switch (expr_bin->op_type)
+    {
+    case TokenType_::double_eq:
+    case TokenType_::not_eq_:
+    case TokenType_::angle_open:
+    case TokenType_::angle_close:
+    case TokenType_::oangle_eq:
+    case TokenType_::cangle_eq:
+        return true;
+    case TokenType_::double_amp:
+    case TokenType_::double_bar:
+    case TokenType_::caret:
+        return is_bool_expr(expr_bin->lhs) && is_bool_expr(expr_bin->rhs);
+    default:
+        return false;
+    }
+}
 
-        void operator()(const NodeStmtLet* stmt_let)
-        {
-            if (std::find_if(gen.m_vars.cbegin(), gen.m_vars.cend(), [&](const Var& var){return var.name == stmt_let->ident.value.value();}) != gen.m_vars.cend())
-            {
-                compilation_error(std::string("Identifier already used: ") + stmt_let->ident.value.value(), stmt_let->line);
-            }
+bool Generator::try_gen_short_circuit(const NodeExprBin* expr_bin)
+{
+    // Numbers and lists are combined bitwise, so only a bool on the left can decide the result by itself
+    if (!is_bool_expr(expr_bin->lhs))
+    {
+        return false;
+    }
 
-            gen.gen_expr(stmt_let->expr);
-            gen.m_vars.push_back(Var{.name = stmt_let->ident.value.value(), .stack_loc = gen.m_stack_size - 1, .is_global = false});
-        }
+    // Jumping adds both code lists' introspection and retrospection, Augur's Exaltation, Hermes' Gambit and the bool
+    // for the side that isn't evaluated, in place of Conjunction or Disjunction Distillation. Right side is only
+    // evaluated regardless when it can't mishap, since the left side is often what keeps it from doing so, like
+    // n != null && n.size() > 0
+    if (can_speculate_expr(expr_bin->rhs) && measure([&](){ gen_expr(expr_bin->rhs); }) <= 6)
+    {
+        return false;
+    }
 
-        void operator()(const NodeStmtIf* stmt_if)
-        {
-            // Evaluate expression
-            gen.gen_expr(stmt_if->expr);
-            gen.augurs_purification();
-            --gen.m_stack_size;
+    gen_expr(expr_bin->lhs);
+    if (expr_bin->op_type == TokenType_::double_amp)
+    {
+        gen_branches([&](){ gen_expr(expr_bin->rhs); }, [&](){ false_reflection(); });
+    }
+    else
+    {
+        gen_branches([&](){ true_reflection(); }, [&](){ gen_expr(expr_bin->rhs); });
+    }
+    return true;
+}
 
-            // Generate statement
-            gen.add_pattern(PatternType::introspection, 0);
-            gen.begin_scope();
-            gen.gen_stmt(stmt_if->stmt);
-            gen.end_scope();
-            gen.add_pattern(PatternType::retrospection, 0);
+bool Generator::is_select_branchless(const NodeExpr* then_expr, const NodeExpr* else_expr)
+{
+    // Value that isn't picked is still evaluated
+    if (!can_speculate_expr(then_expr) || !can_speculate_expr(else_expr))
+    {
+        return false;
+    }
 
-            // Potentially generate else statement
-            if (stmt_if->else_stmt == nullptr)
-            {
-                gen.vacant_reflection();
-                --gen.m_stack_size;
-            }
-            else
-            {
+    // Branching adds both code lists' introspection and retrospection, Augur's Exaltation and Hermes' Gambit around
+    // the value it evaluates, where selecting only adds Augur's Exaltation
+    size_t then_size = measure([&](){ gen_expr(then_expr); });
+    size_t else_size = measure([&](){ gen_expr(else_expr); });
+    return then_size + else_size + 1 <= std::max(then_size, else_size) + 6;
+}
+
+// Assignment that's all statement does, where variable isn't subscripted
+static const NodeExprBin* find_plain_assignment(const NodeStmt* stmt)
+{
+    if (std::holds_alternative<NodeScope*>(stmt->var) && std::get<NodeScope*>(stmt->var)->stmts.size() == 1)
+    {
+        stmt = std::get<NodeScope*>(stmt->var)->stmts.front();
+    }
+
+    if (!std::holds_alternative<NodeExpr*>(stmt->var) || !std::holds_alternative<NodeExprBin*>(std::get<NodeExpr*>(stmt->var)->var))
+    {
+        return nullptr;
+    }
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(std::get<NodeExpr*>(stmt->var)->var);
+    if (expr_bin->op_type != TokenType_::eq || !std::holds_alternative<NodeTerm*>(expr_bin->lhs->var) ||
+        !std::holds_alternative<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var) ||
+        !std::holds_alternative<NodeVarIdent*>(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var)->var))
+    {
+        return nullptr;
+    }
+    return expr_bin;
+}
+
+static const std::string& assigned_name(const NodeExprBin* assignment)
+{
+    return std::get<NodeVarIdent*>(std::get<NodeTermVar*>(std::get<NodeTerm*>(assignment->lhs->var)->var)->var)->ident.value.value();
+}
+
+bool Generator::try_gen_select_assignment(const NodeStmtIf* stmt_if)
+{
+    if (const_from_expr(stmt_if->expr).has_value())
+    {
+        return false;
+    }
+
+    const NodeExprBin* then_assignment = find_plain_assignment(stmt_if->stmt);
+    if (then_assignment == nullptr)
+    {
+        return false;
+    }
+
+    const NodeExpr* else_value;
+    if (stmt_if->else_stmt != nullptr)
+    {
+        const NodeExprBin* else_assignment = find_plain_assignment(stmt_if->else_stmt);
+        if (else_assignment == nullptr || assigned_name(else_assignment) != assigned_name(then_assignment))
+        {
+            return false;
+        }
+        else_value = else_assignment->rhs;
+    }
+    // Without an else, the variable keeps its value, which is only worth it if nothing jumps
+    else
+    {
+        else_value = then_assignment->lhs;
+        if (!is_select_branchless(then_assignment->rhs, else_value))
+        {
+            return false;
+        }
+    }
+
+    NodeTermTernary term_ternary;
+    term_ternary.expr = stmt_if->expr;
+    term_ternary.then_expr = then_assignment->rhs;
+    term_ternary.else_expr = const_cast<NodeExpr*>(else_value);
+    term_ternary.line = stmt_if->line;
+    NodeTerm term;
+    term.var = &term_ternary;
+    term.line = stmt_if->line;
+    NodeExpr value;
+    value.var = &term;
+    value.line = stmt_if->line;
+
+    gen_assignment(std::get<NodeTermVar*>(std::get<NodeTerm*>(then_assignment->lhs->var)->var), &value, TokenType_::eq, stmt_if->line);
+    pop();
+    return true;
+}
+
+// Variable compared with a constant by condition, with value set to the constant, if that's all the condition does
+static const NodeExpr* compared_var(const NodeExpr* condition, const NodeExpr*& value)
+{
+    if (!std::holds_alternative<NodeExprBin*>(condition->var) || std::get<NodeExprBin*>(condition->var)->op_type != TokenType_::double_eq)
+    {
+        return nullptr;
+    }
+
+    auto is_var_ident = [](const NodeExpr* expr) {
+        return std::holds_alternative<NodeTerm*>(expr->var) &&
+            std::holds_alternative<NodeTermVar*>(std::get<NodeTerm*>(expr->var)->var) &&
+            std::holds_alternative<NodeVarIdent*>(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr->var)->var)->var);
+    };
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(condition->var);
+    if (is_var_ident(expr_bin->lhs) && const_from_expr(expr_bin->rhs).has_value())
+    {
+        value = expr_bin->rhs;
+        return expr_bin->lhs;
+    }
+    if (is_var_ident(expr_bin->rhs) && const_from_expr(expr_bin->lhs).has_value())
+    {
+        value = expr_bin->lhs;
+        return expr_bin->rhs;
+    }
+    return nullptr;
+}
+
+static const std::string& var_expr_name(const NodeExpr* expr)
+{
+    return std::get<NodeVarIdent*>(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr->var)->var)->var)->ident.value.value();
+}
+
+bool Generator::try_gen_jump_table(const NodeStmtIf* stmt_if)
+{
+    const NodeExpr* var = nullptr;
+    std::vector<const NodeExpr*> values;
+    std::vector<const NodeStmt*> stmts;
+    const NodeStmt* default_stmt = nullptr;
+
+    // Whatever follows the last condition comparing the same variable runs when none of them match
+    for (const NodeStmtIf* curr = stmt_if; curr != nullptr;)
+    {
+        const NodeExpr* value;
+        const NodeExpr* curr_var = compared_var(curr->expr, value);
+        if (curr_var == nullptr || (var != nullptr && var_expr_name(curr_var) != var_expr_name(var)) ||
+            m_hoisted_exprs.count(curr->expr) > 0)
+        {
+            break;
+        }
+
+        var = var == nullptr ? curr_var : var;
+        values.push_back(value);
+        stmts.push_back(curr->stmt);
+        default_stmt = curr->else_stmt;
+        curr = default_stmt != nullptr && std::holds_alternative<NodeStmtIf*>(default_stmt->var) ?
+            std::get<NodeStmtIf*>(default_stmt->var) : nullptr;
+    }
+
+    // Below this, comparing with each case costs about as much as building the lists
+    if (values.size() < 3)
+    {
+        return false;
+    }
+
+    bool was_unreachable = m_unreachable;
+    size_t stack_size = m_stack_size;
+
+    // Code for each case, after the code for no match since not finding the value gives an index of -1. Each runs
+    // once the lists and value have been used up
+    bool all_return = default_stmt != nullptr;
+    for (size_t i = 0; i <= stmts.size(); ++i)
+    {
+        const NodeStmt* stmt = i == 0 ? default_stmt : stmts[i - 1];
+        if (stmt == nullptr)
+        {
+            vacant_reflection();
+            continue;
+        }
+
+        size_t num_lists = m_stack_size;
+        m_stack_size = stack_size;
+
+        add_pattern(PatternType::introspection, 0);
+        begin_scope();
+        gen_stmt(stmt);
+        end_scope();
+        all_return = all_return && m_unreachable;
+        m_unreachable = was_unreachable;
+        add_pattern(PatternType::retrospection, 0);
+
+        m_stack_size = num_lists + 1;
+    }
+    numerical_reflection(std::to_string(stmts.size() + 1));
+    flocks_gambit(stmts.size() + 1);
+
+    // Position of the variable's value among the cases picks the code, the same way comparing with each in order would
+    for (const NodeExpr* value : values)
+    {
+        gen_expr(value);
+    }
+    numerical_reflection(std::to_string(values.size()));
+    flocks_gambit(values.size());
+    gen_expr(var);
+    locators_distillation();
+    numerical_reflection("1");
+    additive_distillation();
+    selection_distillation();
+    add_pattern(PatternType::hermes_gambit, -1);
+
+    if (!was_unreachable)
+    {
+        ++num_jump_tables;
+    }
+
+    m_unreachable = was_unreachable || all_return;
+    return true;
+}
+
+void Generator::gen_expr(const NodeExpr* expr)
+{
+    // Value was already computed before the loop it's in, or earlier in its block
+    std::map<const NodeExpr*, std::string>::iterator hoisted = m_hoisted_exprs.find(expr);
+    if (hoisted != m_hoisted_exprs.end())
+    {
+        gen_var_ident(hoisted->second, expr->line);
+        return;
+    }
+
+    // Expression using variables of unrolled loops may be constant
+    if (!m_inductions.empty() && !const_from_expr(expr).has_value())
+    {
+        std::optional<Constant> value = induction_value(expr);
+        if (value.has_value())
+        {
+            gen_constant(value.value());
+            return;
+        }
+    }
+
+    struct ExprVisitor {
+        Generator& gen;
+        ExprVisitor (Generator& _gen) :gen(_gen) {}
+        
+        void operator()(const NodeTerm* term)
+        {
+            gen.gen_term(term);
+        }
+
+        void operator()(const NodeExprBin* expr_bin)
+        {
+            gen.gen_bin_expr(expr_bin);
+        }
+    };
+
+    ExprVisitor visitor(*this);
+    std::visit(visitor, expr->var);
+}
+
+void Generator::gen_stmt(const NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        Generator& gen;
+        StmtVisitor(Generator& _gen) :gen(_gen) {}
+
+        void operator()(const NodeStmtCallFunction* call_func)
+        {
+            // Try to gen void inbuilt func first, then non-void inbuilt func, then defined func
+            if (!gen.gen_inbuilt_func(call_func->func, true, false))
+            {
+                if (gen.gen_inbuilt_func(call_func->func, false, false) || !gen.gen_call_func(call_func->func))
+                {
+                    gen.pop();
+                }
+            }
+        }
+
+        void operator()(const NodeStmtReturn* stmt_ret)
+        {
+            // Error check for passing/not passing expression into return
+            if (gen.generating_void_function && stmt_ret->expr.has_value())
+            {
+                compilation_error("Returning expression from void function", stmt_ret->line);
+            }
+
+            if (!gen.generating_void_function && !stmt_ret->expr.has_value())
+            {
+                compilation_error("Return must have expression in non-void functions", stmt_ret->line);
+            }
+
+            // Returning result of another function can be done by jumping to it
+            if (stmt_ret->expr.has_value() && std::holds_alternative<NodeTerm*>(stmt_ret->expr.value()->var))
+            {
+                const NodeTerm* term = std::get<NodeTerm*>(stmt_ret->expr.value()->var);
+                if (std::holds_alternative<NodeTermCallFunc*>(term->var) &&
+                    gen.try_gen_tail_call(std::get<NodeTermCallFunc*>(term->var)->func, false))
+                {
+                    return;
+                }
+            }
+
+            // Generate expression if there is one
+            if (stmt_ret->expr.has_value())
+            {
+                gen.gen_expr(stmt_ret->expr.value());
+            }
+
+            // Remove scope items from stack
+            gen.end_scopes_return(stmt_ret->expr.has_value());
+
+            // If there's an expression on the stack, swap it with jump iota
+            if (stmt_ret->expr.has_value())
+            {
+                gen.jesters_gambit();
+            }
+
+            // Execute jump iota
+            gen.add_pattern(PatternType::hermes_gambit, 0);
+
+            // Nothing after a return can run
+            gen.m_unreachable = true;
+        }
+
+        void operator()(const NodeExpr* stmt_expr)
+        {
+            gen.gen_expr(stmt_expr);
+            gen.pop();
+        }
+
+        void operator()(const NodeStmtLet* stmt_let)
+        {
+            if (std::find_if(gen.m_vars.cbegin() + gen.m_frame_var_start, gen.m_vars.cend(), [&](const Var& var){return var.name == stmt_let->ident.value.value();}) != gen.m_vars.cend())
+            {
+                compilation_error(std::string("Identifier already used: ") + stmt_let->ident.value.value(), stmt_let->line);
+            }
+
+            // Variable that's never used doesn't need a slot, but its expression is still checked for errors
+            if (gen.m_liveness.is_dead(stmt_let))
+            {
+                gen.measure([&](){ gen.gen_expr(stmt_let->expr); });
+                gen.m_vars.push_back(Var{.name = stmt_let->ident.value.value(), .stack_loc = gen.m_stack_size, .is_global = false, .is_moved = true});
+
+                if (!gen.m_unreachable)
+                {
+                    ++gen.num_dead_lets;
+                }
+                return;
+            }
+
+            gen.gen_expr(stmt_let->expr);
+            gen.m_vars.push_back(Var{.name = stmt_let->ident.value.value(), .stack_loc = gen.m_stack_size - 1, .is_global = false});
+        }
+
+        void operator()(const NodeStmtIf* stmt_if)
+        {
+            // Branches that only set the same variable become one assignment
+            if (gen.try_gen_select_assignment(stmt_if))
+            {
+                return;
+            }
+
+            // Long chains comparing a variable with constants look up which code to run
+            if (gen.try_gen_jump_table(stmt_if))
+            {
+                return;
+            }
+
+            // If condition is constant, only the branch that runs is generated, and without a jump
+            std::optional<Constant> condition = const_from_expr(stmt_if->expr);
+            bool was_unreachable = gen.m_unreachable;
+            bool runs_stmt = !condition.has_value() || const_is_truthy(condition.value());
+            bool runs_else = !condition.has_value() || !const_is_truthy(condition.value());
+
+            // Evaluate expression
+            gen.m_unreachable = was_unreachable || condition.has_value();
+            gen.gen_expr(stmt_if->expr);
+            gen.augurs_purification();
+            --gen.m_stack_size;
+
+            // Generate statement
+            gen.add_pattern(PatternType::introspection, 0);
+            gen.m_unreachable = was_unreachable || !runs_stmt;
+            gen.begin_scope();
+            gen.gen_stmt(stmt_if->stmt);
+            gen.end_scope();
+            bool stmt_returns = gen.m_unreachable;
+            gen.m_unreachable = was_unreachable || condition.has_value();
+            gen.add_pattern(PatternType::retrospection, 0);
+
+            // Potentially generate else statement, where a branch that can't run counts as returning
+            bool else_returns = !runs_else;
+            if (stmt_if->else_stmt == nullptr)
+            {
+                gen.vacant_reflection();
+                --gen.m_stack_size;
+            }
+            else
+            {
                 gen.add_pattern(PatternType::introspection, 0);
+                gen.m_unreachable = was_unreachable || !runs_else;
                 gen.begin_scope();
                 gen.gen_stmt(stmt_if->else_stmt);
                 gen.end_scope(); 
+                else_returns = gen.m_unreachable;
+                gen.m_unreachable = was_unreachable || condition.has_value();
                 gen.add_pattern(PatternType::retrospection, 0);
             }
             
             // Perform bool comparison and execute
             gen.add_pattern(PatternType::augurs_exaltation, 0);
             gen.add_pattern(PatternType::hermes_gambit, 0);
+
+            // Code after is unreachable if both branches return
+            gen.m_unreachable = was_unreachable || ((stmt_returns || !runs_stmt) && else_returns);
         }
 
         void operator()(const NodeStmtWhile* stmt_while)
         {
-            // Add jump iota to stack for loop
-            gen.vacant_reflection();
-            gen.add_pattern(PatternType::iris_gambit, 0);
+            gen.gen_while(stmt_while, [&](){ gen.gen_stmt(stmt_while->stmt); });
+        }
+
+        void operator()(const NodeStmtFor* stmt_for)
+        {
+            if (std::find_if(gen.m_vars.cbegin() + gen.m_frame_var_start, gen.m_vars.cend(), [&](const Var& var){return var.name == stmt_for->ident.value.value();}) != gen.m_vars.cend())
+            {
+                compilation_error(std::string("Identifier already used: ") + stmt_for->ident.value.value(), stmt_for->line);
+            }
+
+            gen.gen_for(stmt_for);
+        }
+
+        void operator()(const NodeScope* stmt_scope)
+        {
+            gen.begin_scope();
+
+            gen.gen_stmts(stmt_scope->stmts, false);
+
+            gen.end_scope();
+        }
+    };
+
+    StmtVisitor visitor(*this);
+    std::visit(visitor, stmt->var);
+}
+
+void Generator::gen_stmts(const std::vector<NodeStmt*>& stmts, bool is_func_scope)
+{
+    ValueNumbering numbering(stmts, visible_globals());
+    std::vector<std::vector<NumberedExpr>> repeated = numbering.find();
+    std::vector<const NodeExpr*> common_exprs;
+
+    for (size_t i = 0; i < stmts.size(); ++i)
+    {
+        gen_common_exprs(repeated, i, common_exprs);
+
+        // Void call is in tail position if followed by an empty return, or if it ends a void function
+        if (std::holds_alternative<NodeStmtCallFunction*>(stmts[i]->var) && generating_void_function)
+        {
+            bool is_tail = (i + 1 == stmts.size() && is_func_scope) || (i + 1 < stmts.size() &&
+                std::holds_alternative<NodeStmtReturn*>(stmts[i + 1]->var) && !std::get<NodeStmtReturn*>(stmts[i + 1]->var)->expr.has_value());
+
+            if (is_tail && try_gen_tail_call(std::get<NodeStmtCallFunction*>(stmts[i]->var)->func, true))
+            {
+                continue;
+            }
+        }
+
+        // Loop stepping the variable declared right before it may be generated as copies of its body
+        if (i > 0 && std::holds_alternative<NodeStmtWhile*>(stmts[i]->var) && std::holds_alternative<NodeStmtLet*>(stmts[i - 1]->var))
+        {
+            const NodeStmtLet* stmt_let = std::get<NodeStmtLet*>(stmts[i - 1]->var);
+            bool var_used_after = uses_var(std::vector<NodeStmt*>(stmts.begin() + i + 1, stmts.end()), stmt_let->ident.value.value());
+            if (try_gen_unrolled_loop(stmt_let, stmts[i], var_used_after))
+            {
+                continue;
+            }
+        }
+
+        gen_stmt(stmts[i]);
+    }
+
+    // Locals holding the values are popped with the scope
+    for (const NodeExpr* expr : common_exprs)
+    {
+        m_hoisted_exprs.erase(expr);
+    }
+}
+
+bool Generator::try_gen_tail_call(const NodeDefinedFunc* func, bool is_void)
+{
+    std::vector<Func>::iterator iter = std::find_if(m_funcs.begin(), m_funcs.end(), [&](const Func& _func){
+        return _func.name == func->ident.value.value() && (size_t)_func.num_params == func->exprs.size();});
+
+    // Inbuilt functions are called before declared ones with the same name, and inlined functions don't have a jump
+    if (iter == m_funcs.end() || iter->is_inlined || iter->is_void != is_void ||
+        is_inbuilt_func(func, false) || (is_void && is_inbuilt_func(func, true)))
+    {
+        return false;
+    }
+
+    // Generate expressions, which become params
+    for (NodeExpr* expr : func->exprs)
+    {
+        gen_expr(expr);
+    }
+
+    size_t stack_size = m_stack_size - func->exprs.size();
+
+    // Remove this function's params and locals, leaving its jump iota under the new params
+    size_t num_args = func->exprs.size();
+    size_t num_params = num_unmoved_params();
+    size_t pop_count = m_stack_size - m_scopes[m_function_start_scope].stack_size - num_params - 1 - num_args;
+    if (num_params + pop_count > 0)
+    {
+        add_pattern(PatternType::bookkeepers_gambit, -(num_params + pop_count),
+            // Pop parameters if they exist
+            (num_params != 0 ? (std::string(num_params, 'v') + '-') : std::string()) +
+            // Pop rest of scope
+            std::string(pop_count, 'v') +
+            // Preserve new params
+            std::string(num_args, '-'));
+    }
+
+    // Bring jump iota to top of stack
+    if (num_args == 1)
+    {
+        jesters_gambit();
+    }
+    else if (num_args > 1)
+    {
+        numerical_reflection(std::to_string(num_args));
+        fishermans_gambit();
+    }
+
+    // Jump to function
+    muninns_reflection();
+    numerical_reflection(std::to_string(iter->stack_loc));
+    selection_distillation();
+    add_pattern(PatternType::hermes_gambit, -1);
+
+    if (!m_unreachable)
+    {
+        tail_calls.push_back(std::make_pair(iter->name, func->line));
+    }
+
+    // Nothing after a jump can run, but keep stack the same as a normal call for the rest of the function
+    m_unreachable = true;
+    m_stack_size = stack_size + (is_void ? 0 : 1);
+
+    return true;
+}
+
+bool Generator::is_inbuilt_func(const NodeDefinedFunc* func, bool is_void)
+{
+    // Generate without output to see if it's recognized
+    bool was_unreachable = m_unreachable;
+    size_t stack_size = m_stack_size;
+    std::vector<Var> vars = m_vars;
+    std::vector<Scope> scopes = m_scopes;
+    size_t num_unreachable = num_unreachable_patterns;
+    m_unreachable = true;
+
+    bool is_inbuilt = gen_inbuilt_func(func, is_void, false);
+
+    m_unreachable = was_unreachable;
+    m_stack_size = stack_size;
+    m_vars = std::move(vars);
+    m_scopes = std::move(scopes);
+    num_unreachable_patterns = num_unreachable;
+
+    return is_inbuilt;
+}
+
+void Generator::gen_func_def(const NodeFunctionDef* func_def, bool is_unreachable)
+{
+    // Visitor to extract function info
+    struct FuncDefVisitor {
+        Generator& gen;
+        bool& is_void;
+        std::vector<Token>& params;
+        NodeScope*& scope;
+        FuncDefVisitor (Generator& _gen, bool& _is_void, std::vector<Token>& _params, NodeScope*& _scope) :gen(_gen), is_void(_is_void), params(_params), scope(_scope) {}
+        
+        void operator()(const NodeFunctionDefVoid* func_void)
+        {
+            is_void = true;
+            params = func_void->params;
+            scope = func_void->scope;
+        }
+
+        void operator()(const NodeFunctionDefRet* func_ret)
+        {
+            is_void = false;
+            params = func_ret->params;
+            scope = func_ret->scope;
+        }
+    };
+
+    // Extract function info
+    bool is_void;
+    std::vector<Token> params;
+    NodeScope* scope;
+    FuncDefVisitor visitor(*this, is_void, params, scope);
+    std::visit(visitor, func_def->var);
+
+    generating_void_function = is_void;
+    m_unreachable = is_unreachable;
+    m_function_start_scope = m_scopes.size();
+    m_function_num_params = params.size();
+
+    add_pattern(PatternType::introspection, 0);
+
+    // Get jump iota to function, and exit function
+    add_pattern(PatternType::introspection, 0);
+    add_pattern(PatternType::charons_gambit, 0);
+    add_pattern(PatternType::retrospection, 0);
+    add_pattern(PatternType::flocks_disintegration, 0);
+    add_pattern(PatternType::iris_gambit, 0);
+
+    begin_scope();
+
+    // Treat top of the stack as params
+    for (Token param : params)
+    {
+        m_vars.push_back(Var{.name = param.value.value(), .stack_loc = m_stack_size, .is_global = false});
+        ++m_stack_size;
+    }
+
+    // Account for jump iota from iris' gambit
+    ++m_stack_size;
+
+    // Generate stmts in function
+    gen_stmts(scope->stmts, true);
+
+    // If function isn't void, then provide null return value by default
+    if (is_void)
+    {
+        // Pop scope items, but not jump iota since it will be used for return
+        end_scopes_return(false);
+        // Return
+        add_pattern(PatternType::hermes_gambit, -1);
+        // Remove local vars from scope
+        m_vars.resize(m_scopes.back().var_num);
+        // Pop scope
+        m_scopes.pop_back();
+    }
+    else
+    {
+        // Remove excess from stack
+        end_scopes_return(false);
+        // Add null to stack
+        nullary_reflection();
+        // Swap jump iota forward
+        jesters_gambit();
+        // Return
+        add_pattern(PatternType::hermes_gambit, -1);
+        // Remove local vars from scope
+        m_vars.resize(m_scopes.back().var_num);
+        // Pop scope
+        m_scopes.pop_back();
+    }
+
+    // Default return is left out if every path already returned, but function itself still needs to be closed
+    m_unreachable = is_unreachable;
+
+    add_pattern(PatternType::retrospection, 1);
+    add_pattern(PatternType::hermes_gambit, 0);
+
+    m_unreachable = false;
+}
+
+void Generator::gen_prog()
+{
+    // Gen global var exprs
+    for (NodeGlobalLet* global_let : m_prog->vars)
+    {
+        if (std::find_if(m_global_vars.cbegin(), m_global_vars.cend(), [&](const Var& var){return var.name == global_let->ident.value.value();}) != m_global_vars.cend())
+        {
+            compilation_error(std::string("Global identifier already used: ") + global_let->ident.value.value(), global_let->line);
+        }
+
+        gen_expr(global_let->expr);
+
+        // Register temporarily as local var so they can reference other global vars during declaration
+        m_vars.push_back(Var{.name = global_let->ident.value.value(), .stack_loc = m_vars.size(), .is_global = false});
+    }
+
+    // Clear temp local vars
+    m_vars.clear();
+
+    // Mark global variables as declared
+    for (NodeGlobalLet* global_let : m_prog->vars)
+    {
+        m_global_vars.push_back(Var{.name = global_let->ident.value.value(), .stack_loc = m_global_vars.size(), .is_global = true});
+    }
+
+    // Account for main's jump iota
+    ++m_stack_size;
+
+    // Visitor for declaring functions
+    struct FuncDefVisitor {
+        Generator& gen;
+        FuncDefVisitor (Generator& _gen) :gen(_gen) {}
+        
+        void operator()(const NodeFunctionDefVoid* func_void)
+        {
+            gen.dec_func(true, func_void->ident.value.value(), func_void->params.size(), func_void->line);
+        }
+
+        void operator()(const NodeFunctionDefRet* func_ret)
+        {
+            gen.dec_func(false, func_ret->ident.value.value(), func_ret->params.size(), func_ret->line);
+        }
+    };
+    FuncDefVisitor visitor(*this);
+
+    // Gen function declarations
+    for (NodeFunctionDef* func_def : m_prog->funcs)
+    {
+        std::visit(visitor, func_def->var);
+        m_funcs.back().def = func_def;
+    }
+
+    choose_inlined_funcs();
+
+    // Gen functions, inlined ones are generated where they're called instead
+    size_t num_stored_funcs = 0;
+    for (const Func& func : m_funcs)
+    {
+        if (!func.is_inlined)
+        {
+            gen_func_def(func.def);
+            ++num_stored_funcs;
+        }
+    }
+
+    // Store functions and global vars in list in raven's mind
+    if (m_global_vars.size() + num_stored_funcs > 0)
+    {
+        if (m_global_vars.size() + num_stored_funcs == 1)
+        {
+            singles_purification();
+        }
+        else
+        {
+            numerical_reflection(std::to_string(m_global_vars.size() + num_stored_funcs));
+            flocks_gambit(m_global_vars.size() + num_stored_funcs);
+        }
+
+        huginns_gambit();
+    }
+
+    // Remove accounting of jump iota so it isn't double counted
+    --m_stack_size;
+
+    // Gen main
+    gen_func_def(m_prog->main_);
+
+    // Execute main
+    add_pattern(PatternType::iris_gambit, -1);
+}
+
+
+
+void Generator::choose_inlined_funcs()
+{
+    CallGraph call_graph(m_prog);
+
+    for (Func& func : m_funcs)
+    {
+        FuncKey key(func.name, func.num_params);
+        const NodeScope* scope = std::holds_alternative<NodeFunctionDefVoid*>(func.def->var) ?
+            std::get<NodeFunctionDefVoid*>(func.def->var)->scope : std::get<NodeFunctionDefRet*>(func.def->var)->scope;
+
+        // Functions main can't reach anymore, like ones every call to was run at compile time, are left out whatever they do
+        if (!call_graph.is_reachable(key))
+        {
+            func.is_inlined = true;
+            uncalled_funcs.push_back(key);
+            continue;
+        }
+
+        if (call_graph.is_recursive(key) || !can_inline_returns(scope->stmts))
+        {
+            continue;
+        }
+
+        // Measure function by generating it without output
+        size_t stack_size = m_stack_size;
+        size_t num_unreachable = num_unreachable_patterns;
+        gen_func_def(func.def, true);
+        size_t func_size = num_unreachable_patterns - num_unreachable;
+        m_stack_size = stack_size;
+        num_unreachable_patterns = num_unreachable;
+
+        // Each call costs 4 patterns, while inlining saves the 7 patterns of the function's setup and default return,
+        // but needs 1 to remove the params and locals. Small functions are always worth it for the patterns saved
+        // each time they're ran, unless they never run, while hot ones are worth growing the focus by the budget
+        size_t num_calls = call_graph.num_calls(key);
+        size_t body_size = func_size - 7;
+        size_t inlined_size = num_calls * (body_size + 1);
+        size_t stored_size = func_size + 4 * num_calls;
+        bool is_small = body_size <= 12 && !m_profile.is_cold_func(func.name);
+        bool is_hot = m_profile.is_hot_func(func.name) && inlined_size <= stored_size + m_unroll_budget;
+        if (num_calls <= 1 || is_small || is_hot || inlined_size <= stored_size)
+        {
+            func.is_inlined = true;
+            inlined_funcs.push_back(func.name);
+        }
+    }
+
+    // Give stored functions their new place in raven's mind
+    size_t stack_loc = m_global_vars.size();
+    for (Func& func : m_funcs)
+    {
+        if (!func.is_inlined)
+        {
+            func.stack_loc = stack_loc++;
+        }
+    }
+}
+
+void Generator::gen_while(const NodeStmtWhile* stmt_while, const std::function<void()>& gen_body)
+{
+    // If condition is constant, either nothing is generated or the condition check is left out
+    std::optional<Constant> condition = const_from_expr(stmt_while->expr);
+    bool was_unreachable = m_unreachable;
+    bool never_runs = condition.has_value() && !const_is_truthy(condition.value());
+
+    m_unreachable = was_unreachable || never_runs;
+
+    // Compute values that can't change in the loop once, beneath the loop's jump iota. Loops that never ran when
+    // profiled are left smaller instead
+    begin_scope();
+    std::vector<const NodeExpr*> hoisted_exprs;
+    if (!never_runs && !m_profile.is_cold_line(stmt_while->line))
+    {
+        hoisted_exprs = gen_loop_invariants(stmt_while);
+    }
+
+    gen_loop(condition, was_unreachable, [&](){ gen_expr(stmt_while->expr); }, gen_body);
+
+    // Remove hoisted values
+    end_scope();
+    for (const NodeExpr* expr : hoisted_exprs)
+    {
+        m_hoisted_exprs.erase(expr);
+    }
+}
+
+void Generator::gen_loop(const std::optional<Constant>& condition, bool was_unreachable, const std::function<void()>& gen_condition,
+    const std::function<void()>& gen_body)
+{
+    bool never_runs = condition.has_value() && !const_is_truthy(condition.value());
+    bool runs_forever = condition.has_value() && const_is_truthy(condition.value());
+
+    m_unreachable = was_unreachable || never_runs;
+
+    // Add jump iota to stack for loop
+    vacant_reflection();
+    add_pattern(PatternType::iris_gambit, 0);
+
+    // Gen condition
+    m_unreachable = was_unreachable || condition.has_value();
+    gen_condition();
+    m_unreachable = was_unreachable || never_runs;
+
+    // Account for condition not being on stack when generating loop body
+    --m_stack_size;
+
+    // If true, gen statements and loop
+    add_pattern(PatternType::introspection, 0);
+    begin_scope();
+    gen_body();
+    end_scope();
+    gemini_decomposition();
+    add_pattern(PatternType::hermes_gambit, 0);
+    m_unreachable = was_unreachable || never_runs;
+    add_pattern(PatternType::retrospection, 0);
+
+    // If false, do nothing
+    m_unreachable = was_unreachable || condition.has_value();
+    vacant_reflection();
+
+    // Actually make comparison and execute
+    add_pattern(PatternType::augurs_exaltation, -2);
+    m_unreachable = was_unreachable || never_runs;
+    add_pattern(PatternType::hermes_gambit, 0);
+
+    // Loop that never ends can only be left by returning
+    m_unreachable = was_unreachable || never_runs || runs_forever;
+
+    // Remove leftover jump iota from stack
+    pop();
+
+    m_unreachable = was_unreachable || runs_forever;
+}
+
+void Generator::gen_for(const NodeStmtFor* stmt_for)
+{
+    if (assigns_outer_local(stmt_for->stmt))
+    {
+        gen_indexed_for(stmt_for);
+        return;
+    }
+
+    bool was_unreachable = m_unreachable;
+
+    // Body starts with the stack under the list, which is missing any variables the list took, plus the element
+    gen_expr(stmt_for->expr);
+    size_t stack_size = m_stack_size - 1;
+    m_stack_size = stack_size;
+    add_pattern(PatternType::introspection, 0);
+    begin_scope();
+    m_vars.push_back(Var{.name = stmt_for->ident.value.value(), .stack_loc = m_stack_size, .is_global = false});
+    ++m_stack_size;
+
+    gen_body_stmts(stmt_for->stmt);
+
+    // Thoth's Gambit collects the whole stack left after each element, and puts the stack back anyway, so clearing it
+    // is cheaper than popping the body's locals, and nothing is collected
+    flocks_reflection();
+    add_pattern(PatternType::flocks_gambit, 0);
+    pop();
+    m_vars.resize(m_scopes.back().var_num);
+    m_scopes.pop_back();
+
+    // List might be empty, so code after the loop runs even if the body returns
+    m_unreachable = was_unreachable;
+    add_pattern(PatternType::retrospection, 0);
+
+    // Run body for each element, then pop the empty list of what was collected. List has to be on top, but is made
+    // first so the body is generated knowing which variables it moved
+    m_stack_size = stack_size + 2;
+    jesters_gambit();
+    add_pattern(PatternType::thoths_gambit, -1);
+    pop();
+}
+
+void Generator::gen_indexed_for(const NodeStmtFor* stmt_for)
+{
+    // Names can't be written in code, so they never clash with variables
+    std::string list_name = "for list " + std::to_string(m_vars.size());
+    std::string index_name = "for index " + std::to_string(m_vars.size());
+
+    if (!m_unreachable)
+    {
+        ++num_indexed_for_loops;
+    }
+
+    begin_scope();
+    gen_expr(stmt_for->expr);
+    m_vars.push_back(Var{.name = list_name, .stack_loc = m_stack_size - 1, .is_global = false});
+    numerical_reflection("0");
+    m_vars.push_back(Var{.name = index_name, .stack_loc = m_stack_size - 1, .is_global = false});
+
+    gen_loop(std::nullopt, m_unreachable, [&]() {
+        gen_var_ident(index_name, stmt_for->line);
+        gen_var_ident(list_name, stmt_for->line);
+        length_purification();
+        minimus_distillation();
+    }, [&]() {
+        gen_var_ident(list_name, stmt_for->line);
+        gen_var_ident(index_name, stmt_for->line);
+        selection_distillation();
+        m_vars.push_back(Var{.name = stmt_for->ident.value.value(), .stack_loc = m_stack_size - 1, .is_global = false});
+
+        gen_body_stmts(stmt_for->stmt);
+
+        // Step index in its slot
+        numerical_reflection("1");
+        Var index = gen_var_ident(index_name, stmt_for->line, false, false);
+        additive_distillation();
+        numerical_reflection(std::to_string(-(int)m_stack_size + (int)index.stack_loc + 1));
+        fishermans_gambit();
+    });
+
+    end_scope();
+}
+
+bool Generator::assigns_outer_local(const NodeStmt* stmt) const
+{
+    for (size_t i = m_frame_var_start; i < m_vars.size(); ++i)
+    {
+        VarUses uses(m_vars[i].name);
+        uses.add_stmt(stmt);
+        if (uses.is_assigned)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Generator::gen_body_stmts(const NodeStmt* stmt)
+{
+    // Scope's locals are removed with the body's scope
+    if (std::holds_alternative<NodeScope*>(stmt->var))
+    {
+        gen_stmts(std::get<NodeScope*>(stmt->var)->stmts, false);
+    }
+    else
+    {
+        gen_stmt(stmt);
+    }
+}
+
+std::vector<const NodeExpr*> Generator::gen_loop_invariants(const NodeStmtWhile* stmt_while)
+{
+    LoopInvariants invariants(stmt_while, visible_globals());
+
+    std::vector<const NodeExpr*> hoisted_exprs;
+    for (const NodeExpr* expr : invariants.find())
+    {
+        // Same expression can be found twice in an inlined body, and ones already hoisted by an outer loop are just reads
+        if (m_hoisted_exprs.count(expr) > 0)
+        {
+            continue;
+        }
+
+        size_t expr_size = measure([&](){ gen_expr(expr); });
+
+        // Reading the hoisted value back costs 2 patterns
+        if (expr_size <= 2)
+        {
+            continue;
+        }
+
+        gen_expr(expr);
+
+        std::string name = "loop invariant " + std::to_string(m_hoisted_exprs.size());
+        m_vars.push_back(Var{.name = name, .stack_loc = m_stack_size - 1, .is_global = false});
+        m_hoisted_exprs[expr] = name;
+        hoisted_exprs.push_back(expr);
+
+        if (!m_unreachable)
+        {
+            ++num_hoisted_exprs;
+        }
+    }
+
+    return hoisted_exprs;
+}
+
+void Generator::gen_common_exprs(const std::vector<std::vector<NumberedExpr>>& repeated, size_t stmt_index,
+    std::vector<const NodeExpr*>& common_exprs)
+{
+    struct Candidate {
+        size_t size;
+        // Evaluations that still happen, the first one being computed
+        std::vector<NumberedExpr> evals;
+    };
+
+    // Evaluations inside ones already replaced by reads never happen
+    std::set<const NodeExpr*> reused;
+    auto is_reused = [&](const NumberedExpr& eval){
+        return std::any_of(eval.outer_exprs.begin(), eval.outer_exprs.end(), [&](const NodeExpr* outer){
+            return m_hoisted_exprs.count(outer) > 0 || reused.count(outer) > 0; });
+    };
+    auto remaining_evals = [&](const std::vector<NumberedExpr>& evaluations){
+        std::vector<NumberedExpr> evals;
+        for (const NumberedExpr& eval : evaluations)
+        {
+            // First one has to be computable before its statement, any before it are left as they are
+            if (!is_reused(eval) && (!evals.empty() || eval.can_compute_early))
+            {
+                evals.push_back(eval);
+            }
+        }
+        return evals;
+    };
+
+    std::vector<Candidate> candidates;
+    for (const std::vector<NumberedExpr>& evaluations : repeated)
+    {
+        // Expressions hoisted out of a loop are already just reads
+        if (std::any_of(evaluations.begin(), evaluations.end(), [&](const NumberedExpr& eval){ return m_hoisted_exprs.count(eval.expr) > 0; }))
+        {
+            continue;
+        }
+
+        std::vector<NumberedExpr> evals = remaining_evals(evaluations);
+        if (evals.size() < 2 || evals.front().stmt_index != stmt_index)
+        {
+            continue;
+        }
+
+        m_in_common_expr = true;
+        size_t size = measure([&](){ gen_expr(evals.front().expr); });
+        m_in_common_expr = false;
+        candidates.push_back(Candidate{.size = size, .evals = std::move(evals)});
+    }
+
+    // Larger expressions first, so the ones inside them are only counted where they're still evaluated
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b){ return a.size > b.size; });
+
+    std::vector<std::vector<NumberedExpr>> chosen;
+    for (Candidate& candidate : candidates)
+    {
+        std::vector<NumberedExpr> evals = remaining_evals(candidate.evals);
+        size_t num_evals = evals.size();
+
+        // Each evaluation becomes a read costing 2 patterns, and the local is popped at the end of the scope
+        if (num_evals < 2 || evals.front().stmt_index != stmt_index || (num_evals - 1) * candidate.size <= 2 * num_evals + 1)
+        {
+            continue;
+        }
+
+        for (size_t i = 1; i < num_evals; ++i)
+        {
+            reused.insert(evals[i].expr);
+        }
+        chosen.push_back(std::move(evals));
+    }
+
+    // Expressions inside others have to be computed first
+    std::sort(chosen.begin(), chosen.end(), [](const std::vector<NumberedExpr>& a, const std::vector<NumberedExpr>& b){
+        return a.front().order < b.front().order; });
+
+    for (const std::vector<NumberedExpr>& evals : chosen)
+    {
+        m_in_common_expr = true;
+        gen_expr(evals.front().expr);
+        m_in_common_expr = false;
+
+        std::string name = "common expression " + std::to_string(m_hoisted_exprs.size());
+        m_vars.push_back(Var{.name = name, .stack_loc = m_stack_size - 1, .is_global = false});
+        for (const NumberedExpr& eval : evals)
+        {
+            m_hoisted_exprs[eval.expr] = name;
+            common_exprs.push_back(eval.expr);
+        }
+
+        if (!m_unreachable)
+        {
+            ++num_common_exprs;
+        }
+    }
+}
+
+std::set<std::string> Generator::visible_globals() const
+{
+    std::set<std::string> globals;
+    for (const Var& var : m_global_vars)
+    {
+        if (std::find_if(m_vars.begin() + m_frame_var_start, m_vars.end(), [&](const Var& local){ return local.name == var.name; }) == m_vars.end())
+        {
+            globals.insert(var.name);
+        }
+    }
+    return globals;
+}
+
+void Generator::try_gen_x_exprs(std::vector<NodeExpr*> exprs, int correct_amount, size_t line)
+{
+    if (exprs.size() != correct_amount)
+    {
+        compilation_error("Incorrect number of arguments passed into function", line);
+    }
 
-            // Gen condition
-            gen.gen_expr(stmt_while->expr);
+    for (NodeExpr* expr : exprs)
+    {
+        gen_expr(expr);
+    }
+}
 
-            // Account for condition not being on stack when generating loop body
-            --gen.m_stack_size;
+void Generator::pop(int amount)
+{
+    if (amount <= 0)
+    {
+        return;
+    }
 
-            // If true, gen statements and loop
-            gen.add_pattern(PatternType::introspection, 0);
-            gen.begin_scope();
-            gen.gen_stmt(stmt_while->stmt);
-            gen.end_scope();
-            gen.gemini_decomposition();
-            gen.add_pattern(PatternType::hermes_gambit, 0);
-            gen.add_pattern(PatternType::retrospection, 0);
+    add_pattern(PatternType::bookkeepers_gambit, -amount, std::string(amount, 'v'));
+}
 
-            // If false, do nothing
-            gen.vacant_reflection();
+size_t Generator::measure(const std::function<void()>& gen)
+{
+    // Generate without output, counting what would have been output
+    bool was_unreachable = m_unreachable;
+    size_t stack_size = m_stack_size;
+    // Variables moved off the stack while measuring are still there
+    std::vector<Var> vars = m_vars;
+    std::vector<Scope> scopes = m_scopes;
+    size_t num_unreachable = num_unreachable_patterns;
+    m_unreachable = true;
 
-            // Actually make comparison and execute
-            gen.add_pattern(PatternType::augurs_exaltation, -2);
-            gen.add_pattern(PatternType::hermes_gambit, 0);
+    gen();
+    size_t size = num_unreachable_patterns - num_unreachable;
 
-            // Remove leftover jump iota from stack
-            gen.pop();
-        }
+    m_unreachable = was_unreachable;
+    m_stack_size = stack_size;
+    m_vars = std::move(vars);
+    m_scopes = std::move(scopes);
+    num_unreachable_patterns = num_unreachable;
 
-        void operator()(const NodeScope* stmt_scope)
-        {
-            gen.begin_scope();
+    return size;
+}
 
-            for (NodeStmt* stmt : stmt_scope->stmts)
-            {
-                gen.gen_stmt(stmt);
-            }
+bool Generator::try_gen_unrolled_loop(const NodeStmtLet* stmt_let, const NodeStmt* loop_stmt, bool var_used_after)
+{
+    // Copies of the body past this many are never worth it
+    static const size_t max_iterations = 64;
 
-            gen.end_scope();
-        }
-    };
+    const NodeStmtWhile* stmt_while = std::get<NodeStmtWhile*>(loop_stmt->var);
+    std::optional<InductionLoop> loop = find_induction_loop(stmt_let, stmt_while, max_iterations);
+    if (!loop.has_value() || m_vars.empty() || m_vars.back().name != loop.value().name)
+    {
+        return false;
+    }
 
-    StmtVisitor visitor(*this);
-    std::visit(visitor, stmt->var);
-}
+    size_t stack_loc = m_vars.back().stack_loc;
+    size_t num_iterations = loop.value().values.size();
 
-void Generator::gen_func_def(const NodeFunctionDef* func_def)
-{
-    // Visitor to extract function info
-    struct FuncDefVisitor {
-        Generator& gen;
-        bool& is_void;
-        std::vector<Token>& params;
-        NodeScope*& scope;
-        FuncDefVisitor (Generator& _gen, bool& _is_void, std::vector<Token>& _params, NodeScope*& _scope) :gen(_gen), is_void(_is_void), params(_params), scope(_scope) {}
-        
-        void operator()(const NodeFunctionDefVoid* func_void)
-        {
-            is_void = true;
-            params = func_void->params;
-            scope = func_void->scope;
-        }
+    // Variable only needs its final value if something reads it after the loop
+    bool assigns_final = var_used_after && loop.value().final_value != std::get<double>(const_from_expr(stmt_let->expr).value().var);
+    auto gen_full = [&]() {
+        gen_unrolled_body(loop.value(), stack_loc, num_iterations);
 
-        void operator()(const NodeFunctionDefRet* func_ret)
+        if (assigns_final)
         {
-            is_void = false;
-            params = func_ret->params;
-            scope = func_ret->scope;
+            gen_assignment(loop.value().var, (float)loop.value().final_value, TokenType_::eq, stmt_while->line);
+            pop();
         }
     };
+    auto gen_partial = [&](size_t factor) {
+        gen_while(stmt_while, [&]() {
+            gen_unrolled_body(loop.value(), stack_loc, factor);
 
-    // Extract function info
-    bool is_void;
-    std::vector<Token> params;
-    NodeScope* scope;
-    FuncDefVisitor visitor(*this, is_void, params, scope);
-    std::visit(visitor, func_def->var);
+            gen_assignment(loop.value().var, (float)(loop.value().step * factor), TokenType_::plus_eq, stmt_while->line);
+            pop();
+        });
+    };
 
-    generating_void_function = is_void;
-    m_function_start_scope = m_scopes.size();
-    m_function_num_params = params.size();
+    // Decide how many copies of the body to make the first time the loop is seen
+    std::map<const NodeStmt*, size_t>::iterator decided = m_unroll_factors.find(loop_stmt);
+    if (decided == m_unroll_factors.end())
+    {
+        // Profile picks the goal for loops it knows are hot or cold
+        UnrollGoal goal = m_profile.is_hot_line(loop_stmt->line) ? UnrollGoal::evals :
+            m_profile.is_cold_line(loop_stmt->line) ? UnrollGoal::focus_size : m_unroll_goal;
 
-    add_pattern(PatternType::introspection, 0);
+        size_t factor = 0;
+        size_t loop_size = measure([&](){ gen_stmt(loop_stmt); });
+        size_t allowed_size = loop_size + (goal == UnrollGoal::evals ? m_unroll_budget : 0);
 
-    // Get jump iota to function, and exit function
-    add_pattern(PatternType::introspection, 0);
-    add_pattern(PatternType::charons_gambit, 0);
-    add_pattern(PatternType::retrospection, 0);
-    add_pattern(PatternType::flocks_disintegration, 0);
-    add_pattern(PatternType::iris_gambit, 0);
+        // Values assigned by the generator have to survive being stored as a float
+        bool values_fit = (float)loop.value().final_value == loop.value().final_value &&
+            (float)loop.value().step == loop.value().step;
 
-    begin_scope();
+        if ((!assigns_final || values_fit) && measure(gen_full) <= allowed_size)
+        {
+            factor = num_iterations;
+        }
+        // Partially unrolled loop still runs every copy of the body, so it's only smaller when minimizing evals
+        else if (goal == UnrollGoal::evals && values_fit)
+        {
+            for (size_t try_factor = num_iterations / 2; try_factor >= 2; --try_factor)
+            {
+                if (num_iterations % try_factor == 0 && (float)(loop.value().step * try_factor) == loop.value().step * try_factor &&
+                    measure([&](){ gen_partial(try_factor); }) <= allowed_size)
+                {
+                    factor = try_factor;
+                    break;
+                }
+            }
+        }
 
-    // Treat top of the stack as params
-    for (Token param : params)
-    {
-        m_vars.push_back(Var{.name = param.value.value(), .stack_loc = m_stack_size, .is_global = false});
-        ++m_stack_size;
+        decided = m_unroll_factors.emplace(loop_stmt, factor).first;
     }
 
-    // Account for jump iota from iris' gambit
-    ++m_stack_size;
-
-    // Generate stmts in function
-    for (NodeStmt* stmt : scope->stmts)
+    size_t factor = decided->second;
+    if (factor == 0)
     {
-        gen_stmt(stmt);
+        return false;
     }
 
-    // If function isn't void, then provide null return value by default
-    if (is_void)
+    if (factor == num_iterations)
     {
-        // Pop scope items, but not jump iota since it will be used for return
-        end_scopes_return(false);
-        // Return
-        add_pattern(PatternType::hermes_gambit, -1);
-        // Remove local vars from scope
-        m_vars.resize(m_scopes.back().var_num);
-        // Pop scope
-        m_scopes.pop_back();
+        gen_full();
     }
     else
     {
-        // Remove excess from stack
-        end_scopes_return(false);
-        // Add null to stack
-        nullary_reflection();
-        // Swap jump iota forward
-        jesters_gambit();
-        // Return
-        add_pattern(PatternType::hermes_gambit, -1);
-        // Remove local vars from scope
-        m_vars.resize(m_scopes.back().var_num);
-        // Pop scope
-        m_scopes.pop_back();
+        gen_partial(factor);
     }
-    add_pattern(PatternType::retrospection, 1);
-    add_pattern(PatternType::hermes_gambit, 0);
+
+    if (!m_unreachable)
+    {
+        ++num_unrolled_loops;
+    }
+    return true;
 }
 
-void Generator::gen_prog()
+void Generator::gen_unrolled_body(const InductionLoop& loop, size_t stack_loc, size_t factor)
 {
-    // Gen global var exprs
-    for (NodeGlobalLet* global_let : m_prog->vars)
+    bool is_partial = factor != loop.values.size();
+
+    for (size_t i = 0; i < factor; ++i)
     {
-        if (std::find_if(m_global_vars.cbegin(), m_global_vars.cend(), [&](const Var& var){return var.name == global_let->ident.value.value();}) != m_global_vars.cend())
+        if (is_partial)
         {
-            compilation_error(std::string("Global identifier already used: ") + global_let->ident.value.value(), global_let->line);
+            m_inductions[stack_loc] = Induction{.value = loop.step * i, .is_offset = true};
+        }
+        else
+        {
+            m_inductions[stack_loc] = Induction{.value = loop.values[i], .is_offset = false};
         }
 
-        gen_expr(global_let->expr);
-
-        // Register temporarily as local var so they can reference other global vars during declaration
-        m_vars.push_back(Var{.name = global_let->ident.value.value(), .stack_loc = m_vars.size(), .is_global = false});
+        begin_scope();
+        gen_stmts(loop.body, false);
+        end_scope();
     }
 
-    // Clear temp local vars
-    m_vars.clear();
+    m_inductions.erase(stack_loc);
+}
 
-    // Mark global variables as declared
-    for (NodeGlobalLet* global_let : m_prog->vars)
+std::optional<Generator::Induction> Generator::find_induction(const std::string& name)
+{
+    std::vector<Var>::iterator iter = std::find_if(m_vars.begin() + m_frame_var_start, m_vars.end(),
+        [&](const Var& var){ return var.name == name; });
+    if (iter == m_vars.end())
     {
-        m_global_vars.push_back(Var{.name = global_let->ident.value.value(), .stack_loc = m_global_vars.size(), .is_global = true});
+        return {};
     }
 
-    // Account for main's jump iota
-    ++m_stack_size;
+    std::map<size_t, Induction>::iterator induction = m_inductions.find(iter->stack_loc);
+    if (induction == m_inductions.end())
+    {
+        return {};
+    }
+    return induction->second;
+}
 
-    // Visitor for declaring functions
-    struct FuncDefVisitor {
-        Generator& gen;
-        FuncDefVisitor (Generator& _gen) :gen(_gen) {}
-        
-        void operator()(const NodeFunctionDefVoid* func_void)
-        {
-            gen.dec_func(true, func_void->ident.value.value(), func_void->params.size(), func_void->line);
-        }
+std::optional<Constant> Generator::induction_value(const NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        return induction_value(std::get<NodeTerm*>(expr->var));
+    }
 
-        void operator()(const NodeFunctionDefRet* func_ret)
-        {
-            gen.dec_func(false, func_ret->ident.value.value(), func_ret->params.size(), func_ret->line);
-        }
-    };
-    FuncDefVisitor visitor(*this);
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
 
-    // Gen function declarations
-    for (NodeFunctionDef* func_def : m_prog->funcs)
+    // Assignments and member functions are never constant
+    switch (expr_bin->op_type)
     {
-        std::visit(visitor, func_def->var);
+    case TokenType_::eq:
+    case TokenType_::plus_eq:
+    case TokenType_::dash_eq:
+    case TokenType_::star_eq:
+    case TokenType_::fslash_eq:
+    case TokenType_::mod_eq:
+    case TokenType_::dot:
+        return {};
+    default:
+        break;
     }
 
-    // Gen functions
-    for (NodeFunctionDef* func_def : m_prog->funcs)
+    std::optional<Constant> lhs = induction_value(expr_bin->lhs);
+    if (!lhs.has_value())
+    {
+        return {};
+    }
+    std::optional<Constant> rhs = induction_value(expr_bin->rhs);
+    if (!rhs.has_value())
     {
-        gen_func_def(func_def);
+        return {};
     }
 
-    // Store functions and global vars in list in raven's mind
-    if (m_global_vars.size() + m_funcs.size() > 0)
+    return fold_bin_op(expr_bin->op_type, lhs.value(), rhs.value());
+}
+
+std::optional<Constant> Generator::induction_value(const NodeTerm* term)
+{
+    if (std::holds_alternative<NodeTermNumLit*>(term->var))
+    {
+        return const_from_num_lit(std::get<NodeTermNumLit*>(term->var)->num_lit.value.value());
+    }
+    else if (std::holds_alternative<NodeTermBoolLit*>(term->var))
+    {
+        return Constant{.var = std::get<NodeTermBoolLit*>(term->var)->bool_.value == "true"};
+    }
+    else if (std::holds_alternative<NodeTermNullLit*>(term->var))
+    {
+        return Constant{.var = ConstNull{}};
+    }
+    else if (std::holds_alternative<NodeTermParen*>(term->var))
+    {
+        return induction_value(std::get<NodeTermParen*>(term->var)->expr);
+    }
+    else if (std::holds_alternative<NodeTermTernary*>(term->var))
     {
-        if (m_global_vars.size() + m_funcs.size() == 1)
+        const NodeTermTernary* term_ternary = std::get<NodeTermTernary*>(term->var);
+        std::optional<Constant> condition = induction_value(term_ternary->expr);
+        if (!condition.has_value())
         {
-            singles_purification();
+            return {};
         }
-        else
+        return induction_value(const_is_truthy(condition.value()) ? term_ternary->then_expr : term_ternary->else_expr);
+    }
+    else if (std::holds_alternative<NodeTermUn*>(term->var))
+    {
+        const NodeTermUn* term_un = std::get<NodeTermUn*>(term->var);
+        if (term_un->op_type == TokenType_::double_plus || term_un->op_type == TokenType_::double_dash)
         {
-            numerical_reflection(std::to_string(m_global_vars.size() + m_funcs.size()));
-            flocks_gambit(m_global_vars.size() + m_funcs.size());
+            return {};
         }
 
-        huginns_gambit();
+        std::optional<Constant> operand = induction_value(term_un->term);
+        if (!operand.has_value())
+        {
+            return {};
+        }
+        return fold_un_op(term_un->op_type, operand.value());
     }
+    else if (std::holds_alternative<NodeTermVar*>(term->var))
+    {
+        const NodeTermVar* var = std::get<NodeTermVar*>(term->var);
+        if (!std::holds_alternative<NodeVarIdent*>(var->var))
+        {
+            return {};
+        }
 
-    // Remove accounting of jump iota so it isn't double counted
-    --m_stack_size;
-
-    // Gen main
-    gen_func_def(m_prog->main_);
+        std::optional<Induction> induction = find_induction(std::get<NodeVarIdent*>(var->var)->ident.value.value());
+        if (!induction.has_value() || induction.value().is_offset)
+        {
+            return {};
+        }
+        return Constant{.var = induction.value().value};
+    }
 
-    // Execute main
-    add_pattern(PatternType::iris_gambit, -1);
+    return {};
 }
 
-
-
-void Generator::try_gen_x_exprs(std::vector<NodeExpr*> exprs, int correct_amount, size_t line)
+void Generator::gen_constant(const Constant& constant)
 {
-    if (exprs.size() != correct_amount)
+    if (std::holds_alternative<double>(constant.var))
     {
-        compilation_error("Incorrect number of arguments passed into function", line);
+        numerical_reflection(num_to_string(std::get<double>(constant.var)));
     }
-
-    for (NodeExpr* expr : exprs)
+    else if (std::holds_alternative<bool>(constant.var))
     {
-        gen_expr(expr);
+        if (std::get<bool>(constant.var))
+        {
+            true_reflection();
+        }
+        else
+        {
+            false_reflection();
+        }
+    }
+    else if (std::holds_alternative<ConstVec>(constant.var))
+    {
+        const ConstVec& vec = std::get<ConstVec>(constant.var);
+        numerical_reflection(num_to_string(vec.x));
+        numerical_reflection(num_to_string(vec.y));
+        numerical_reflection(num_to_string(vec.z));
+        vector_exaltation();
+    }
+    else
+    {
+        nullary_reflection();
     }
 }
 
-void Generator::pop(int amount)
+void Generator::free_var_slot(const std::string& name)
 {
-    if (amount <= 0)
+    std::vector<Var>::iterator moved = std::find_if(m_vars.begin() + m_frame_var_start, m_vars.end(),
+        [&](const Var& var){ return var.name == name; });
+    moved->is_moved = true;
+
+    for (Var& var : m_vars)
     {
-        return;
+        if (var.stack_loc > moved->stack_loc)
+        {
+            --var.stack_loc;
+        }
     }
 
-    add_pattern(PatternType::bookkeepers_gambit, -amount, std::string(amount, 'v'));
+    // Scopes started above the slot now start one lower
+    for (Scope& scope : m_scopes)
+    {
+        if (scope.stack_size > moved->stack_loc)
+        {
+            --scope.stack_size;
+        }
+    }
+}
+
+size_t Generator::num_unmoved_params() const
+{
+    std::vector<Var>::const_iterator params = m_vars.begin() + m_scopes[m_function_start_scope].var_num;
+    return std::count_if(params, params + m_function_num_params, [](const Var& var){ return !var.is_moved; });
 }
 
 void Generator::begin_scope()
@@ -1625,13 +3124,15 @@ void Generator::end_scope()
 void Generator::end_scopes_return(bool has_ret_value)
 {
     size_t pop_count = m_stack_size - m_scopes[m_function_start_scope].stack_size - (has_ret_value ? 1 : 0) - 1;
+    // Params that were moved at their last read are already gone
+    size_t num_params = num_unmoved_params();
 
     // Bookkeepr's Gambit all stack elements except possible ret value and jump iota
     add_pattern(PatternType::bookkeepers_gambit, 0,
         // Preserve parameters if they exist
-        (m_function_num_params != 0 ? (std::string(m_function_num_params, 'v') + '-') : std::string()) +
+        (num_params != 0 ? (std::string(num_params, 'v') + '-') : std::string()) +
         // Pop rest of scope
-        std::string(pop_count - m_function_num_params, 'v') +
+        std::string(pop_count - num_params, 'v') +
         // Preserve return value if it exists
         (has_ret_value ? "-" : ""));
 }
@@ -2070,11 +3571,6 @@ void Generator::nullary_reflection()
 
 void Generator::numerical_reflection(std::string value)
 {
-    if (value.find('.') != std::string::npos)
-    {
-        has_non_integer_num = true;
-    }
-
     add_pattern(PatternType::numerical_reflection, 1, value);
 }
 
@@ -2488,6 +3984,14 @@ void Generator::white_suns_zenith()
 
 void Generator::add_pattern(PatternType pattern_type, size_t stack_size_net, std::optional<std::string> value)
 {
-    m_output.push_back(Pattern{.type = pattern_type, .value = value});
+    // Keep track of stack even when unreachable so the rest of the function is generated the same
+    if (m_unreachable)
+    {
+        ++num_unreachable_patterns;
+    }
+    else
+    {
+        m_output.push_back(Pattern{.type = pattern_type, .value = value});
+    }
     m_stack_size += stack_size_net;
 }
\ No newline at end of file
@@ -1,7 +1,15 @@
 #pragma once
 
 #include "parser.hpp"
+#include "constant.hpp"
+#include "liveness.hpp"
+#include "numbering.hpp"
+#include "unrolling.hpp"
+#include "inlining.hpp"
+#include "profile.hpp"
 
+#include <functional>
+#include <map>
 #include <sstream>
 #include <stack>
 
@@ -196,9 +204,13 @@ public:
         std::string name;
         size_t stack_loc;
         bool is_global;
+        // Set once the variable has no slot on the stack, after its last use took its value, or if it was never used
+        bool is_moved = false;
     };
 
-    Generator(const NodeProg* root);
+    // Budget is how many patterns unrolling a loop can add to the focus when minimizing evals
+    Generator(const NodeProg* root, UnrollGoal unroll_goal = UnrollGoal::focus_size, size_t unroll_budget = 100,
+        Profile profile = Profile());
 
     std::vector<Pattern> generate();
 
@@ -211,9 +223,18 @@ public:
     Var gen_var_ident(const std::string ident_name, size_t line, bool dont_gen_if_global = false, bool leave_copy = true);
     void gen_var(const NodeTermVar* var);
     void gen_term(const NodeTerm* term);
+    // Generates then expression's value if condition is truthy, else expression's value otherwise
+    void gen_select(const NodeExpr* condition, const NodeExpr* then_expr, const NodeExpr* else_expr);
     void gen_expr(const NodeExpr* expr);
     void gen_stmt(const NodeStmt* stmt);
-    void gen_func_def(const NodeFunctionDef* func_def);
+    // Generates statements of a scope, with void calls right before the function returns done as tail calls
+    void gen_stmts(const std::vector<NodeStmt*>& stmts, bool is_func_scope);
+    // Calls function by jumping straight to it with the current function's jump iota, so it returns to this
+    // function's caller. Returns false if function can't be called this way
+    bool try_gen_tail_call(const NodeDefinedFunc* func, bool is_void);
+    bool is_inbuilt_func(const NodeDefinedFunc* func, bool is_void);
+    // Unreachable functions are still generated for error checking and measuring, but not output
+    void gen_func_def(const NodeFunctionDef* func_def, bool is_unreachable = false);
     void gen_prog();
     
     void try_gen_x_exprs(std::vector<NodeExpr*> exprs, int correct_amount, size_t line);
@@ -399,7 +420,28 @@ public:
 
     void add_pattern(PatternType pattern_type, size_t stack_size_net, std::optional<std::string> value = std::nullopt);
 
-    bool has_non_integer_num = false;
+    // Patterns left out because they could never run
+    size_t num_unreachable_patterns = 0;
+    // Functions generated at every call instead of being stored
+    std::vector<std::string> inlined_funcs {};
+    // Functions left out since nothing main runs calls them anymore
+    std::vector<FuncKey> uncalled_funcs {};
+    // Names and lines of calls turned into jumps
+    std::vector<std::pair<std::string, size_t>> tail_calls {};
+    // Expressions computed once before a loop instead of every time through it
+    size_t num_hoisted_exprs = 0;
+    // Expressions computed once and read back wherever else they're evaluated in the same block
+    size_t num_common_exprs = 0;
+    // Loops generated as copies of their body
+    size_t num_unrolled_loops = 0;
+    // For loops generated as loops over indices, since they set variables from outside them
+    size_t num_indexed_for_loops = 0;
+    // Reads that took a variable's value off the stack instead of copying it
+    size_t num_moved_reads = 0;
+    // Lets left out because their variable was never used
+    size_t num_dead_lets = 0;
+    // If-else chains and switches that pick their code from a list instead of comparing with each case in turn
+    size_t num_jump_tables = 0;
 
     bool generating_void_function = false;
 private:
@@ -409,14 +451,102 @@ private:
         std::string name;
         int num_params;
         size_t stack_loc;
+        const NodeFunctionDef* def = nullptr;
+        bool is_inlined = false;
     };
 
+    // Function body being generated in place of a call
+    struct InlineFrame {
+        size_t stack_base;
+        bool is_void;
+    };
+
+    // Statements left to generate in an inlined body, and whether they end a scope
+    struct InlineRest {
+        const std::vector<NodeStmt*>* stmts;
+        size_t start;
+        bool ends_scope;
+    };
+
+    void choose_inlined_funcs();
+    void gen_inline_call(const Func& func, const NodeDefinedFunc* call);
+    // Generates the rest of an inlined body, innermost statements last, with any return skipping everything after it
+    void gen_inline_stmts(std::vector<InlineRest> rest, const InlineFrame& frame);
+    // Generates branch of an if followed by the rest of the body
+    void gen_inline_branch(const NodeStmt* branch, std::vector<InlineRest> rest, const InlineFrame& frame);
+    // Removes inlined function's params and locals from the stack, leaving the return value
+    void gen_inline_return(const NodeStmtReturn* stmt_ret, const InlineFrame& frame, size_t line);
+
+    // Generates both branches as code lists, and runs the one picked by the bool on top of the stack
+    void gen_branches(const std::function<void()>& gen_then, const std::function<void()>& gen_else);
+    // Generates && or || that only evaluates its right side if its left side doesn't decide the result, returns
+    // false if it should evaluate both sides
+    bool try_gen_short_circuit(const NodeExprBin* expr_bin);
+    // Whether evaluating both values and keeping one is cheaper than jumping to the code for one
+    bool is_select_branchless(const NodeExpr* then_expr, const NodeExpr* else_expr);
+    // Generates if that only sets a variable in each branch as one assignment of a selected value, returns false if
+    // it isn't one
+    bool try_gen_select_assignment(const NodeStmtIf* stmt_if);
+    // Generates if-else chain comparing one variable with a constant in each condition as a lookup of the code to run
+    // in a list, returns false if it isn't one or is too short to be worth it
+    bool try_gen_jump_table(const NodeStmtIf* stmt_if);
+
+    // Generates loop invariant expressions worth hoisting as hidden locals, returns the expressions hoisted
+    std::vector<const NodeExpr*> gen_loop_invariants(const NodeStmtWhile* stmt_while);
+    // Generates expressions repeated in a block that are first evaluated in the statement at index, and are worth
+    // computing once as hidden locals right before it. Adds the evaluations that read the locals to common exprs
+    void gen_common_exprs(const std::vector<std::vector<NumberedExpr>>& repeated, size_t stmt_index,
+        std::vector<const NodeExpr*>& common_exprs);
+    // Names that refer to globals where code is being generated
+    std::set<std::string> visible_globals() const;
+    // Number of patterns gen outputs, without outputting them
+    size_t measure(const std::function<void()>& gen);
+
+    void gen_while(const NodeStmtWhile* stmt_while, const std::function<void()>& gen_body);
+    // Generates loop that runs body while condition is truthy. Condition is its value if it's constant, and was
+    // unreachable is whether code before the loop was
+    void gen_loop(const std::optional<Constant>& condition, bool was_unreachable, const std::function<void()>& gen_condition,
+        const std::function<void()>& gen_body);
+    // Generates for loop as Thoth's Gambit over the list, or as a loop over its indices if the body sets a local
+    // declared outside it, since Thoth's Gambit puts the stack back the way it was before each element
+    void gen_for(const NodeStmtFor* stmt_for);
+    void gen_indexed_for(const NodeStmtFor* stmt_for);
+    // Whether statement assigns a local declared outside of it, or one of its elements
+    bool assigns_outer_local(const NodeStmt* stmt) const;
+    // Generates statements of a loop body in the scope already begun for it
+    void gen_body_stmts(const NodeStmt* stmt);
+    // Generates loop stepping the variable declared by let as copies of its body if that's worth it, returns false if
+    // the loop should be generated normally. Var used after is whether the statements after the loop use the variable
+    bool try_gen_unrolled_loop(const NodeStmtLet* stmt_let, const NodeStmt* loop_stmt, bool var_used_after);
+    // Generates body of loop factor times, with the variable's value in each copy known
+    void gen_unrolled_body(const InductionLoop& loop, size_t stack_loc, size_t factor);
+
+    // Variable of a loop being unrolled, as its value in the copy of the body being generated, or if the loop is only
+    // partially unrolled, as an offset from the value the variable holds
+    struct Induction {
+        double value;
+        bool is_offset;
+    };
+
+    // Induction of variable if it's a local stepped by a loop being unrolled
+    std::optional<Induction> find_induction(const std::string& name);
+    // Value of expression if it's made only of literals and variables of fully unrolled loops
+    std::optional<Constant> induction_value(const NodeExpr* expr);
+    std::optional<Constant> induction_value(const NodeTerm* term);
+    void gen_constant(const Constant& constant);
+
+    // Forgets local's slot after its value was taken off the stack, moving everything above it down
+    void free_var_slot(const std::string& name);
+    // Params of the function being generated that haven't been moved off the stack, which are under its jump iota
+    size_t num_unmoved_params() const;
+
     struct Scope {
         size_t stack_size;
         size_t var_num;
     };
 
     const NodeProg* m_prog;
+    Liveness m_liveness;
     std::vector<Pattern> m_output;
     size_t m_stack_size = 0;
     std::vector<Var> m_vars {};
@@ -426,4 +556,24 @@ private:
 
     size_t m_function_start_scope;
     size_t m_function_num_params;
+    // Variables before this belong to the function an inlined body was generated in, and can't be seen by it
+    size_t m_frame_var_start = 0;
+    // Expressions hoisted out of loops or computed once in blocks being generated, and the names of the locals holding their values
+    std::map<const NodeExpr*, std::string> m_hoisted_exprs {};
+    // Set while generating an expression ahead of where it's evaluated, where reads can't be last reads
+    bool m_in_common_expr = false;
+
+    UnrollGoal m_unroll_goal;
+    size_t m_unroll_budget;
+    // Hot code is allowed to grow the focus by the unroll budget to evaluate fewer patterns, cold code is kept small
+    Profile m_profile;
+    // Inductions of loops being unrolled, by the stack location of their variable
+    std::map<size_t, Induction> m_inductions {};
+    // Number of copies of its body each loop is generated with, 0 for loops left as they are. Each loop is only measured
+    // once, so that nested loops don't get measured again for every copy of the loops around them
+    std::map<const NodeStmt*, size_t> m_unroll_factors {};
+
+    // Set when every path to the code being generated has returned, or the code is in a branch that never runs.
+    // Patterns aren't output while set
+    bool m_unreachable = false;
 };
\ No newline at end of file
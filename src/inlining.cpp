@@ -0,0 +1,376 @@
+#include "inlining.hpp"
+
+#include <algorithm>
+
+FuncKey func_key(const NodeFunctionDef* func_def)
+{
+    if (std::holds_alternative<NodeFunctionDefVoid*>(func_def->var))
+    {
+        const NodeFunctionDefVoid* func_void = std::get<NodeFunctionDefVoid*>(func_def->var);
+        return FuncKey(func_void->ident.value.value(), func_void->params.size());
+    }
+    else
+    {
+        const NodeFunctionDefRet* func_ret = std::get<NodeFunctionDefRet*>(func_def->var);
+        return FuncKey(func_ret->ident.value.value(), func_ret->params.size());
+    }
+}
+
+CallGraph::CallGraph(const NodeProg* prog)
+{
+    for (const NodeFunctionDef* func_def : prog->funcs)
+    {
+        m_curr_func = func_key(func_def);
+        m_callees[m_curr_func];
+
+        if (std::holds_alternative<NodeFunctionDefVoid*>(func_def->var))
+        {
+            add_calls_scope(std::get<NodeFunctionDefVoid*>(func_def->var)->scope);
+        }
+        else
+        {
+            add_calls_scope(std::get<NodeFunctionDefRet*>(func_def->var)->scope);
+        }
+    }
+
+    m_main = func_key(prog->main_);
+    m_curr_func = m_main;
+    add_calls_scope(std::get<NodeFunctionDefVoid*>(prog->main_->var)->scope);
+}
+
+size_t CallGraph::num_calls(const FuncKey& func) const
+{
+    std::map<FuncKey, size_t>::const_iterator iter = m_num_calls.find(func);
+    return iter == m_num_calls.end() ? 0 : iter->second;
+}
+
+bool CallGraph::is_recursive(const FuncKey& func) const
+{
+    // Search for function through everything it calls
+    std::set<FuncKey> visited;
+    std::vector<FuncKey> to_visit(m_callees.at(func).begin(), m_callees.at(func).end());
+
+    while (!to_visit.empty())
+    {
+        FuncKey curr = to_visit.back();
+        to_visit.pop_back();
+
+        if (curr == func)
+        {
+            return true;
+        }
+
+        if (visited.count(curr) > 0 || m_callees.count(curr) == 0)
+        {
+            continue;
+        }
+        visited.insert(curr);
+
+        to_visit.insert(to_visit.end(), m_callees.at(curr).begin(), m_callees.at(curr).end());
+    }
+
+    return false;
+}
+
+bool CallGraph::is_reachable(const FuncKey& func) const
+{
+    // Search for function through everything main calls
+    std::set<FuncKey> visited;
+    std::vector<FuncKey> to_visit = {m_main};
+
+    while (!to_visit.empty())
+    {
+        FuncKey curr = to_visit.back();
+        to_visit.pop_back();
+
+        if (curr == func)
+        {
+            return true;
+        }
+
+        if (visited.count(curr) > 0 || m_callees.count(curr) == 0)
+        {
+            continue;
+        }
+        visited.insert(curr);
+
+        to_visit.insert(to_visit.end(), m_callees.at(curr).begin(), m_callees.at(curr).end());
+    }
+
+    return false;
+}
+
+void CallGraph::add_calls_scope(const NodeScope* scope)
+{
+    for (const NodeStmt* stmt : scope->stmts)
+    {
+        add_calls_stmt(stmt);
+    }
+}
+
+void CallGraph::add_calls_stmt(const NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        CallGraph& graph;
+        StmtVisitor (CallGraph& _graph) :graph(_graph) {}
+
+        void operator()(const NodeStmtCallFunction* call_func)
+        {
+            graph.add_call(call_func->func);
+        }
+
+        void operator()(const NodeStmtReturn* stmt_ret)
+        {
+            if (stmt_ret->expr.has_value())
+            {
+                graph.add_calls_expr(stmt_ret->expr.value());
+            }
+        }
+
+        void operator()(const NodeExpr* stmt_expr)
+        {
+            graph.add_calls_expr(stmt_expr);
+        }
+
+        void operator()(const NodeStmtLet* stmt_let)
+        {
+            graph.add_calls_expr(stmt_let->expr);
+        }
+
+        void operator()(const NodeStmtIf* stmt_if)
+        {
+            graph.add_calls_expr(stmt_if->expr);
+            graph.add_calls_stmt(stmt_if->stmt);
+            if (stmt_if->else_stmt != nullptr)
+            {
+                graph.add_calls_stmt(stmt_if->else_stmt);
+            }
+        }
+
+        void operator()(const NodeStmtWhile* stmt_while)
+        {
+            graph.add_calls_expr(stmt_while->expr);
+            graph.add_calls_stmt(stmt_while->stmt);
+        }
+
+        void operator()(const NodeStmtFor* stmt_for)
+        {
+            graph.add_calls_expr(stmt_for->expr);
+            graph.add_calls_stmt(stmt_for->stmt);
+        }
+
+        void operator()(const NodeScope* stmt_scope)
+        {
+            graph.add_calls_scope(stmt_scope);
+        }
+    };
+
+    StmtVisitor visitor(*this);
+    std::visit(visitor, stmt->var);
+}
+
+void CallGraph::add_calls_expr(const NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        add_calls_term(std::get<NodeTerm*>(expr->var));
+        return;
+    }
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+    add_calls_expr(expr_bin->lhs);
+
+    // Member functions are always inbuilt, so only their arguments can call anything
+    if (expr_bin->op_type == TokenType_::dot && std::holds_alternative<NodeTerm*>(expr_bin->rhs->var) &&
+        std::holds_alternative<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var))
+    {
+        for (const NodeExpr* arg : std::get<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var)->func->exprs)
+        {
+            add_calls_expr(arg);
+        }
+        return;
+    }
+
+    add_calls_expr(expr_bin->rhs);
+}
+
+void CallGraph::add_calls_term(const NodeTerm* term)
+{
+    struct TermVisitor {
+        CallGraph& graph;
+        TermVisitor (CallGraph& _graph) :graph(_graph) {}
+
+        void operator()(const NodeTermUn* term_un)
+        {
+            graph.add_calls_term(term_un->term);
+        }
+
+        void operator()(const NodeTermUnPost* term_un_post)
+        {
+            graph.add_calls_var(term_un_post->vari);
+        }
+
+        void operator()(const NodeTermNumLit*) {}
+
+        void operator()(const NodeTermListLit* term_list_lit)
+        {
+            for (const NodeExpr* expr : term_list_lit->exprs)
+            {
+                graph.add_calls_expr(expr);
+            }
+        }
+
+        void operator()(const NodeTermPatternLit*) {}
+
+        void operator()(const NodeTermBoolLit*) {}
+
+        void operator()(const NodeTermNullLit*) {}
+
+        void operator()(const NodeTermVar* term_var)
+        {
+            graph.add_calls_var(term_var);
+        }
+
+        void operator()(const NodeTermParen* term_paren)
+        {
+            graph.add_calls_expr(term_paren->expr);
+        }
+
+        void operator()(const NodeTermCallFunc* call_func)
+        {
+            graph.add_call(call_func->func);
+        }
+
+        void operator()(const NodeTermTernary* term_ternary)
+        {
+            graph.add_calls_expr(term_ternary->expr);
+            graph.add_calls_expr(term_ternary->then_expr);
+            graph.add_calls_expr(term_ternary->else_expr);
+        }
+    };
+
+    TermVisitor visitor(*this);
+    std::visit(visitor, term->var);
+}
+
+void CallGraph::add_calls_var(const NodeTermVar* var)
+{
+    if (std::holds_alternative<NodeVarListSubscript*>(var->var))
+    {
+        add_calls_expr(std::get<NodeVarListSubscript*>(var->var)->expr);
+    }
+}
+
+void CallGraph::add_call(const NodeDefinedFunc* func)
+{
+    for (const NodeExpr* expr : func->exprs)
+    {
+        add_calls_expr(expr);
+    }
+
+    // Inbuilt functions are recorded too, but never looked up
+    FuncKey callee(func->ident.value.value(), func->exprs.size());
+    m_callees[m_curr_func].insert(callee);
+    ++m_num_calls[callee];
+}
+
+bool contains_return(const NodeStmt* stmt)
+{
+    if (std::holds_alternative<NodeStmtReturn*>(stmt->var))
+    {
+        return true;
+    }
+    else if (std::holds_alternative<NodeStmtIf*>(stmt->var))
+    {
+        const NodeStmtIf* stmt_if = std::get<NodeStmtIf*>(stmt->var);
+        return contains_return(stmt_if->stmt) || (stmt_if->else_stmt != nullptr && contains_return(stmt_if->else_stmt));
+    }
+    else if (std::holds_alternative<NodeStmtWhile*>(stmt->var))
+    {
+        return contains_return(std::get<NodeStmtWhile*>(stmt->var)->stmt);
+    }
+    else if (std::holds_alternative<NodeStmtFor*>(stmt->var))
+    {
+        return contains_return(std::get<NodeStmtFor*>(stmt->var)->stmt);
+    }
+    else if (std::holds_alternative<NodeScope*>(stmt->var))
+    {
+        const std::vector<NodeStmt*>& stmts = std::get<NodeScope*>(stmt->var)->stmts;
+        return std::any_of(stmts.begin(), stmts.end(), contains_return);
+    }
+
+    return false;
+}
+
+bool always_returns(const NodeStmt* stmt)
+{
+    if (std::holds_alternative<NodeStmtReturn*>(stmt->var))
+    {
+        return true;
+    }
+    else if (std::holds_alternative<NodeStmtIf*>(stmt->var))
+    {
+        const NodeStmtIf* stmt_if = std::get<NodeStmtIf*>(stmt->var);
+        return stmt_if->else_stmt != nullptr && always_returns(stmt_if->stmt) && always_returns(stmt_if->else_stmt);
+    }
+    else if (std::holds_alternative<NodeScope*>(stmt->var))
+    {
+        const std::vector<NodeStmt*>& stmts = std::get<NodeScope*>(stmt->var)->stmts;
+        return std::any_of(stmts.begin(), stmts.end(), always_returns);
+    }
+
+    return false;
+}
+
+bool can_inline_returns(const std::vector<NodeStmt*>& stmts)
+{
+    for (const NodeStmt* stmt : stmts)
+    {
+        if (std::holds_alternative<NodeStmtIf*>(stmt->var) && contains_return(stmt))
+        {
+            const NodeStmtIf* stmt_if = std::get<NodeStmtIf*>(stmt->var);
+
+            // Rest of the function goes in the branch that doesn't always return, so only one can
+            if (!always_returns(stmt_if->stmt) && (stmt_if->else_stmt == nullptr || !always_returns(stmt_if->else_stmt)))
+            {
+                return false;
+            }
+
+            // Check inside of branches
+            for (const NodeStmt* branch : {stmt_if->stmt, stmt_if->else_stmt})
+            {
+                if (branch == nullptr)
+                {
+                    continue;
+                }
+
+                std::vector<NodeStmt*> branch_stmts = std::holds_alternative<NodeScope*>(branch->var) ?
+                    std::get<NodeScope*>(branch->var)->stmts : std::vector<NodeStmt*>{const_cast<NodeStmt*>(branch)};
+                if (!can_inline_returns(branch_stmts))
+                {
+                    return false;
+                }
+            }
+        }
+        else if (std::holds_alternative<NodeScope*>(stmt->var))
+        {
+            if (!can_inline_returns(std::get<NodeScope*>(stmt->var)->stmts))
+            {
+                return false;
+            }
+        }
+        // Returns in loops would need a jump iota to leave the loop
+        else if ((std::holds_alternative<NodeStmtWhile*>(stmt->var) || std::holds_alternative<NodeStmtFor*>(stmt->var)) && contains_return(stmt))
+        {
+            return false;
+        }
+
+        // Nothing after this can run
+        if (always_returns(stmt))
+        {
+            break;
+        }
+    }
+
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "parser.hpp"
+
+// Functions are told apart by name and number of params
+typedef std::pair<std::string, size_t> FuncKey;
+
+FuncKey func_key(const NodeFunctionDef* func_def);
+
+// Which declared functions call which, used to decide what can be inlined
+class CallGraph {
+public:
+    CallGraph(const NodeProg* prog);
+
+    // Number of places in the code calling function
+    size_t num_calls(const FuncKey& func) const;
+    // Whether function can end up calling itself
+    bool is_recursive(const FuncKey& func) const;
+    // Whether main can end up calling function
+    bool is_reachable(const FuncKey& func) const;
+private:
+    void add_calls_scope(const NodeScope* scope);
+    void add_calls_stmt(const NodeStmt* stmt);
+    void add_calls_expr(const NodeExpr* expr);
+    void add_calls_term(const NodeTerm* term);
+    void add_calls_var(const NodeTermVar* var);
+    void add_call(const NodeDefinedFunc* func);
+
+    std::map<FuncKey, std::set<FuncKey>> m_callees;
+    std::map<FuncKey, size_t> m_num_calls;
+    FuncKey m_curr_func;
+    FuncKey m_main;
+};
+
+bool contains_return(const NodeStmt* stmt);
+// Whether every path through statement hits a return
+bool always_returns(const NodeStmt* stmt);
+// Whether returns in statements only show up where an inlined body can skip the rest of the function without a jump
+// iota, meaning no returns in loops and at most one branch of an if with a return can reach the code after it
+bool can_inline_returns(const std::vector<NodeStmt*>& stmts);
\ No newline at end of file
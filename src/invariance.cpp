@@ -0,0 +1,590 @@
+#include "invariance.hpp"
+
+#include <algorithm>
+
+#include "effects.hpp"
+#include "inlining.hpp"
+
+LoopInvariants::LoopInvariants(const NodeStmtWhile* stmt_while, std::set<std::string> globals)
+    :m_stmt_while(stmt_while), m_globals(std::move(globals))
+{ }
+
+std::vector<const NodeExpr*> LoopInvariants::find()
+{
+    add_writes_expr(m_stmt_while->expr);
+    add_writes_stmt(m_stmt_while->stmt);
+
+    // Condition is evaluated at least once, so hoisting it can't cause a mishap that wouldn't happen anyway
+    m_in_condition = true;
+    find_in_expr(m_stmt_while->expr);
+    m_in_condition = false;
+
+    find_in_stmt(m_stmt_while->stmt);
+
+    return m_invariants;
+}
+
+void LoopInvariants::add_writes_stmt(const NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        LoopInvariants& invariants;
+        StmtVisitor (LoopInvariants& _invariants) :invariants(_invariants) {}
+
+        void operator()(const NodeStmtCallFunction* call_func)
+        {
+            for (const NodeExpr* expr : call_func->func->exprs)
+            {
+                invariants.add_writes_expr(expr);
+            }
+
+            invariants.add_call(call_func->func, true, false);
+        }
+
+        void operator()(const NodeStmtReturn* stmt_ret)
+        {
+            if (stmt_ret->expr.has_value())
+            {
+                invariants.add_writes_expr(stmt_ret->expr.value());
+            }
+        }
+
+        void operator()(const NodeExpr* stmt_expr)
+        {
+            invariants.add_writes_expr(stmt_expr);
+        }
+
+        void operator()(const NodeStmtLet* stmt_let)
+        {
+            invariants.add_writes_expr(stmt_let->expr);
+
+            // New variable could hide one from outside the loop, and holds a new value each time through
+            invariants.m_written_vars.insert(stmt_let->ident.value.value());
+        }
+
+        void operator()(const NodeStmtIf* stmt_if)
+        {
+            invariants.add_writes_expr(stmt_if->expr);
+            invariants.add_writes_stmt(stmt_if->stmt);
+            if (stmt_if->else_stmt != nullptr)
+            {
+                invariants.add_writes_stmt(stmt_if->else_stmt);
+            }
+        }
+
+        void operator()(const NodeStmtWhile* stmt_while)
+        {
+            invariants.add_writes_expr(stmt_while->expr);
+            invariants.add_writes_stmt(stmt_while->stmt);
+        }
+
+        void operator()(const NodeStmtFor* stmt_for)
+        {
+            invariants.add_writes_expr(stmt_for->expr);
+            invariants.m_written_vars.insert(stmt_for->ident.value.value());
+            invariants.add_writes_stmt(stmt_for->stmt);
+        }
+
+        void operator()(const NodeScope* stmt_scope)
+        {
+            for (const NodeStmt* stmt : stmt_scope->stmts)
+            {
+                invariants.add_writes_stmt(stmt);
+            }
+        }
+    };
+
+    StmtVisitor visitor(*this);
+    std::visit(visitor, stmt->var);
+}
+
+void LoopInvariants::add_writes_expr(const NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        add_writes_term(std::get<NodeTerm*>(expr->var));
+        return;
+    }
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+
+    switch (expr_bin->op_type)
+    {
+    case TokenType_::eq:
+    case TokenType_::plus_eq:
+    case TokenType_::dash_eq:
+    case TokenType_::star_eq:
+    case TokenType_::fslash_eq:
+    case TokenType_::mod_eq:
+        if (std::holds_alternative<NodeTerm*>(expr_bin->lhs->var) &&
+            std::holds_alternative<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var))
+        {
+            add_writes_var(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var));
+        }
+        add_writes_expr(expr_bin->rhs);
+        return;
+    case TokenType_::dot:
+        add_writes_expr(expr_bin->lhs);
+        if (std::holds_alternative<NodeTerm*>(expr_bin->rhs->var) &&
+            std::holds_alternative<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var))
+        {
+            const NodeDefinedFunc* func = std::get<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var)->func;
+            for (const NodeExpr* arg : func->exprs)
+            {
+                add_writes_expr(arg);
+            }
+            add_call(func, false, true);
+        }
+        return;
+    default:
+        add_writes_expr(expr_bin->lhs);
+        add_writes_expr(expr_bin->rhs);
+        return;
+    }
+}
+
+void LoopInvariants::add_writes_term(const NodeTerm* term)
+{
+    struct TermVisitor {
+        LoopInvariants& invariants;
+        TermVisitor (LoopInvariants& _invariants) :invariants(_invariants) {}
+
+        void operator()(const NodeTermUn* term_un)
+        {
+            if ((term_un->op_type == TokenType_::double_plus || term_un->op_type == TokenType_::double_dash) &&
+                std::holds_alternative<NodeTermVar*>(term_un->term->var))
+            {
+                invariants.add_writes_var(std::get<NodeTermVar*>(term_un->term->var));
+                return;
+            }
+
+            invariants.add_writes_term(term_un->term);
+        }
+
+        void operator()(const NodeTermUnPost* term_un_post)
+        {
+            invariants.add_writes_var(term_un_post->vari);
+        }
+
+        void operator()(const NodeTermNumLit*) {}
+
+        void operator()(const NodeTermListLit* term_list_lit)
+        {
+            for (const NodeExpr* expr : term_list_lit->exprs)
+            {
+                invariants.add_writes_expr(expr);
+            }
+        }
+
+        void operator()(const NodeTermPatternLit*) {}
+
+        void operator()(const NodeTermBoolLit*) {}
+
+        void operator()(const NodeTermNullLit*) {}
+
+        void operator()(const NodeTermVar* term_var)
+        {
+            if (std::holds_alternative<NodeVarListSubscript*>(term_var->var))
+            {
+                invariants.add_writes_expr(std::get<NodeVarListSubscript*>(term_var->var)->expr);
+            }
+        }
+
+        void operator()(const NodeTermParen* term_paren)
+        {
+            invariants.add_writes_expr(term_paren->expr);
+        }
+
+        void operator()(const NodeTermCallFunc* call_func)
+        {
+            for (const NodeExpr* expr : call_func->func->exprs)
+            {
+                invariants.add_writes_expr(expr);
+            }
+            invariants.add_call(call_func->func, false, false);
+        }
+
+        void operator()(const NodeTermTernary* term_ternary)
+        {
+            invariants.add_writes_expr(term_ternary->expr);
+            invariants.add_writes_expr(term_ternary->then_expr);
+            invariants.add_writes_expr(term_ternary->else_expr);
+        }
+    };
+
+    TermVisitor visitor(*this);
+    std::visit(visitor, term->var);
+}
+
+void LoopInvariants::add_writes_var(const NodeTermVar* var)
+{
+    if (std::holds_alternative<NodeVarIdent*>(var->var))
+    {
+        m_written_vars.insert(std::get<NodeVarIdent*>(var->var)->ident.value.value());
+    }
+    else
+    {
+        const NodeVarListSubscript* subscript = std::get<NodeVarListSubscript*>(var->var);
+        m_written_vars.insert(subscript->ident.value.value());
+        add_writes_expr(subscript->expr);
+    }
+}
+
+void LoopInvariants::add_call(const NodeDefinedFunc* func, bool is_void, bool is_member)
+{
+    switch (inbuilt_effect(func->ident.value.value(), is_void, is_member))
+    {
+    case Effect::changes_world:
+        m_changes_world = true;
+        break;
+    case Effect::unknown:
+        m_calls_unknown = true;
+        m_changes_world = true;
+        break;
+    default:
+        break;
+    }
+}
+
+bool LoopInvariants::find_in_stmts(const std::vector<NodeStmt*>& stmts)
+{
+    for (const NodeStmt* stmt : stmts)
+    {
+        if (!find_in_stmt(stmt))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool LoopInvariants::find_in_stmt(const NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        LoopInvariants& invariants;
+        const NodeStmt* stmt;
+        StmtVisitor (LoopInvariants& _invariants, const NodeStmt* _stmt) :invariants(_invariants), stmt(_stmt) {}
+
+        bool operator()(const NodeStmtCallFunction* call_func)
+        {
+            for (const NodeExpr* expr : call_func->func->exprs)
+            {
+                invariants.find_in_expr(expr);
+            }
+            return true;
+        }
+
+        // Returned value is only evaluated once, when leaving the loop
+        bool operator()(const NodeStmtReturn*)
+        {
+            return false;
+        }
+
+        bool operator()(const NodeExpr* stmt_expr)
+        {
+            invariants.find_in_expr(stmt_expr);
+            return true;
+        }
+
+        bool operator()(const NodeStmtLet* stmt_let)
+        {
+            invariants.find_in_expr(stmt_let->expr);
+            return true;
+        }
+
+        // Only the conditions of ifs and loops are always evaluated
+        bool operator()(const NodeStmtIf* stmt_if)
+        {
+            invariants.find_in_expr(stmt_if->expr);
+            return !contains_return(stmt);
+        }
+
+        bool operator()(const NodeStmtWhile* stmt_while)
+        {
+            invariants.find_in_expr(stmt_while->expr);
+            return !contains_return(stmt);
+        }
+
+        bool operator()(const NodeStmtFor* stmt_for)
+        {
+            invariants.find_in_expr(stmt_for->expr);
+            return !contains_return(stmt);
+        }
+
+        bool operator()(const NodeScope* stmt_scope)
+        {
+            return invariants.find_in_stmts(stmt_scope->stmts);
+        }
+    };
+
+    StmtVisitor visitor(*this, stmt);
+    return std::visit(visitor, stmt->var);
+}
+
+void LoopInvariants::find_in_expr(const NodeExpr* expr)
+{
+    if (is_invariant_expr(expr))
+    {
+        m_invariants.push_back(expr);
+        return;
+    }
+
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        find_in_term(std::get<NodeTerm*>(expr->var));
+        return;
+    }
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+
+    switch (expr_bin->op_type)
+    {
+    case TokenType_::eq:
+    case TokenType_::plus_eq:
+    case TokenType_::dash_eq:
+    case TokenType_::star_eq:
+    case TokenType_::fslash_eq:
+    case TokenType_::mod_eq:
+        // Variable being assigned isn't evaluated as an expression, but its subscript is
+        if (std::holds_alternative<NodeTerm*>(expr_bin->lhs->var) &&
+            std::holds_alternative<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var))
+        {
+            find_in_var(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var));
+        }
+        find_in_expr(expr_bin->rhs);
+        return;
+    case TokenType_::dot:
+        // Member function can only be evaluated with its object
+        find_in_expr(expr_bin->lhs);
+        if (std::holds_alternative<NodeTerm*>(expr_bin->rhs->var) &&
+            std::holds_alternative<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var))
+        {
+            for (const NodeExpr* arg : std::get<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var)->func->exprs)
+            {
+                find_in_expr(arg);
+            }
+        }
+        return;
+    // Right side might not be evaluated
+    case TokenType_::double_amp:
+    case TokenType_::double_bar:
+        find_in_expr(expr_bin->lhs);
+        return;
+    default:
+        find_in_expr(expr_bin->lhs);
+        find_in_expr(expr_bin->rhs);
+        return;
+    }
+}
+
+void LoopInvariants::find_in_term(const NodeTerm* term)
+{
+    struct TermVisitor {
+        LoopInvariants& invariants;
+        TermVisitor (LoopInvariants& _invariants) :invariants(_invariants) {}
+
+        void operator()(const NodeTermUn* term_un)
+        {
+            invariants.find_in_term(term_un->term);
+        }
+
+        void operator()(const NodeTermUnPost* term_un_post)
+        {
+            invariants.find_in_var(term_un_post->vari);
+        }
+
+        void operator()(const NodeTermNumLit*) {}
+
+        void operator()(const NodeTermListLit* term_list_lit)
+        {
+            for (const NodeExpr* expr : term_list_lit->exprs)
+            {
+                invariants.find_in_expr(expr);
+            }
+        }
+
+        void operator()(const NodeTermPatternLit*) {}
+
+        void operator()(const NodeTermBoolLit*) {}
+
+        void operator()(const NodeTermNullLit*) {}
+
+        void operator()(const NodeTermVar* term_var)
+        {
+            invariants.find_in_var(term_var);
+        }
+
+        void operator()(const NodeTermParen* term_paren)
+        {
+            invariants.find_in_expr(term_paren->expr);
+        }
+
+        void operator()(const NodeTermCallFunc* call_func)
+        {
+            for (const NodeExpr* expr : call_func->func->exprs)
+            {
+                invariants.find_in_expr(expr);
+            }
+        }
+
+        // Only one of the values is evaluated
+        void operator()(const NodeTermTernary* term_ternary)
+        {
+            invariants.find_in_expr(term_ternary->expr);
+        }
+    };
+
+    TermVisitor visitor(*this);
+    std::visit(visitor, term->var);
+}
+
+void LoopInvariants::find_in_var(const NodeTermVar* var)
+{
+    if (std::holds_alternative<NodeVarListSubscript*>(var->var))
+    {
+        find_in_expr(std::get<NodeVarListSubscript*>(var->var)->expr);
+    }
+}
+
+bool LoopInvariants::is_invariant_expr(const NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        return is_invariant_term(std::get<NodeTerm*>(expr->var));
+    }
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+
+    switch (expr_bin->op_type)
+    {
+    case TokenType_::eq:
+    case TokenType_::plus_eq:
+    case TokenType_::dash_eq:
+    case TokenType_::star_eq:
+    case TokenType_::fslash_eq:
+    case TokenType_::mod_eq:
+        return false;
+    case TokenType_::dot:
+        if (!std::holds_alternative<NodeTerm*>(expr_bin->rhs->var) ||
+            !std::holds_alternative<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var))
+        {
+            return false;
+        }
+        return is_invariant_expr(expr_bin->lhs) &&
+            is_invariant_call(std::get<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var)->func, true);
+    case TokenType_::slash_forward:
+    case TokenType_::modulus:
+        if (!m_in_condition)
+        {
+            return false;
+        }
+        break;
+    default:
+        break;
+    }
+
+    return is_invariant_expr(expr_bin->lhs) && is_invariant_expr(expr_bin->rhs);
+}
+
+bool LoopInvariants::is_invariant_term(const NodeTerm* term)
+{
+    struct TermVisitor {
+        LoopInvariants& invariants;
+        TermVisitor (LoopInvariants& _invariants) :invariants(_invariants) {}
+
+        bool operator()(const NodeTermUn* term_un)
+        {
+            if (term_un->op_type == TokenType_::double_plus || term_un->op_type == TokenType_::double_dash)
+            {
+                return false;
+            }
+
+            return invariants.is_invariant_term(term_un->term);
+        }
+
+        bool operator()(const NodeTermUnPost*)
+        {
+            return false;
+        }
+
+        bool operator()(const NodeTermNumLit*)
+        {
+            return true;
+        }
+
+        bool operator()(const NodeTermListLit* term_list_lit)
+        {
+            return std::all_of(term_list_lit->exprs.begin(), term_list_lit->exprs.end(),
+                [&](const NodeExpr* expr){ return invariants.is_invariant_expr(expr); });
+        }
+
+        bool operator()(const NodeTermPatternLit*)
+        {
+            return true;
+        }
+
+        bool operator()(const NodeTermBoolLit*)
+        {
+            return true;
+        }
+
+        bool operator()(const NodeTermNullLit*)
+        {
+            return true;
+        }
+
+        bool operator()(const NodeTermVar* term_var)
+        {
+            if (std::holds_alternative<NodeVarIdent*>(term_var->var))
+            {
+                return invariants.is_invariant_var(std::get<NodeVarIdent*>(term_var->var)->ident.value.value());
+            }
+
+            const NodeVarListSubscript* subscript = std::get<NodeVarListSubscript*>(term_var->var);
+            return invariants.is_invariant_var(subscript->ident.value.value()) && invariants.is_invariant_expr(subscript->expr);
+        }
+
+        bool operator()(const NodeTermParen* term_paren)
+        {
+            return invariants.is_invariant_expr(term_paren->expr);
+        }
+
+        bool operator()(const NodeTermCallFunc* call_func)
+        {
+            return invariants.is_invariant_call(call_func->func, false);
+        }
+
+        bool operator()(const NodeTermTernary* term_ternary)
+        {
+            return invariants.is_invariant_expr(term_ternary->expr) && invariants.is_invariant_expr(term_ternary->then_expr) &&
+                invariants.is_invariant_expr(term_ternary->else_expr);
+        }
+    };
+
+    TermVisitor visitor(*this);
+    return std::visit(visitor, term->var);
+}
+
+bool LoopInvariants::is_invariant_var(const std::string& name)
+{
+    return m_written_vars.count(name) == 0 && (m_globals.count(name) == 0 || !m_calls_unknown);
+}
+
+bool LoopInvariants::is_invariant_call(const NodeDefinedFunc* func, bool is_member)
+{
+    std::string func_name = func->ident.value.value();
+
+    // Declared functions with the same name as inbuilt ones are never called
+    Effect effect = inbuilt_effect(func_name, false, is_member);
+    if (effect != Effect::pure && (effect != Effect::reads_world || m_changes_world))
+    {
+        return false;
+    }
+
+    if (!m_in_condition && !is_member && can_mishap_inbuilt(func_name))
+    {
+        return false;
+    }
+
+    return std::all_of(func->exprs.begin(), func->exprs.end(), [&](const NodeExpr* expr){ return is_invariant_expr(expr); });
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+
+// Finds expressions in a while loop whose value can't change while the loop runs
+class LoopInvariants {
+public:
+    // Globals are the names that refer to global variables where the loop is
+    LoopInvariants(const NodeStmtWhile* stmt_while, std::set<std::string> globals);
+
+    // Largest invariant expressions evaluated every time through the loop, in the order they're evaluated
+    std::vector<const NodeExpr*> find();
+private:
+    // Records variables written and calls made anywhere in the loop
+    void add_writes_stmt(const NodeStmt* stmt);
+    void add_writes_expr(const NodeExpr* expr);
+    void add_writes_term(const NodeTerm* term);
+    void add_writes_var(const NodeTermVar* var);
+    void add_call(const NodeDefinedFunc* func, bool is_void, bool is_member);
+
+    // Finds invariants in statements, returns false if the statements after these might not run
+    bool find_in_stmts(const std::vector<NodeStmt*>& stmts);
+    bool find_in_stmt(const NodeStmt* stmt);
+    void find_in_expr(const NodeExpr* expr);
+    void find_in_term(const NodeTerm* term);
+    void find_in_var(const NodeTermVar* var);
+
+    bool is_invariant_expr(const NodeExpr* expr);
+    bool is_invariant_term(const NodeTerm* term);
+    bool is_invariant_var(const std::string& name);
+    bool is_invariant_call(const NodeDefinedFunc* func, bool is_member);
+
+    const NodeStmtWhile* m_stmt_while;
+    std::set<std::string> m_globals;
+
+    std::set<std::string> m_written_vars;
+    // Set by calls that change the world, so nothing read from the world can be hoisted
+    bool m_changes_world = false;
+    // Set by calls to declared functions or ones that run iotas, which could write to any global
+    bool m_calls_unknown = false;
+    // Expressions in the loop's body might never be evaluated, so they can't be ones that could mishap on their values
+    bool m_in_condition = false;
+
+    std::vector<const NodeExpr*> m_invariants;
+};
\ No newline at end of file
@@ -0,0 +1,327 @@
+#include "liveness.hpp"
+
+#include <algorithm>
+
+#include "effects.hpp"
+
+Liveness::Liveness(const NodeProg* prog)
+{
+    // Leaving out a dead let can leave the variables it used unused too, so keep going until no more are found
+    size_t num_dead_lets;
+    do
+    {
+        num_dead_lets = m_dead_lets.size();
+        m_last_reads.clear();
+
+        for (const NodeFunctionDef* func_def : prog->funcs)
+        {
+            add_func(func_def);
+        }
+        add_func(prog->main_);
+    } while (m_dead_lets.size() > num_dead_lets);
+}
+
+bool Liveness::is_last_read(const NodeTermVar* var) const
+{
+    return m_last_reads.count(var) > 0;
+}
+
+bool Liveness::is_dead(const NodeStmtLet* stmt_let) const
+{
+    return m_dead_lets.count(stmt_let) > 0;
+}
+
+void Liveness::add_func(const NodeFunctionDef* func_def)
+{
+    const NodeScope* scope = std::holds_alternative<NodeFunctionDefVoid*>(func_def->var) ?
+        std::get<NodeFunctionDefVoid*>(func_def->var)->scope : std::get<NodeFunctionDefRet*>(func_def->var)->scope;
+    const std::vector<Token>& params = std::holds_alternative<NodeFunctionDefVoid*>(func_def->var) ?
+        std::get<NodeFunctionDefVoid*>(func_def->var)->params : std::get<NodeFunctionDefRet*>(func_def->var)->params;
+
+    m_locals.clear();
+    m_in_scope.clear();
+    m_region = 0;
+    m_num_regions = 0;
+
+    // Params are on the stack for the whole function, and the function takes them off when it returns, so moving them
+    // at their last read leaves less to pop
+    for (const Token& param : params)
+    {
+        m_in_scope.push_back(m_locals.size());
+        m_locals.push_back(Local{.name = param.value.value(), .stmt_let = nullptr, .region = m_region});
+    }
+
+    for (const NodeStmt* stmt : scope->stmts)
+    {
+        add_stmt(stmt);
+    }
+
+    for (const Local& local : m_locals)
+    {
+        if (local.last_read != nullptr)
+        {
+            m_last_reads.insert(local.last_read);
+        }
+
+        if (local.stmt_let != nullptr && local.num_uses == 0 && is_pure_expr(local.stmt_let->expr))
+        {
+            m_dead_lets.insert(local.stmt_let);
+        }
+    }
+}
+
+void Liveness::add_stmt(const NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        Liveness& liveness;
+        StmtVisitor (Liveness& _liveness) :liveness(_liveness) {}
+
+        void operator()(const NodeStmtCallFunction* call_func)
+        {
+            for (const NodeExpr* expr : call_func->func->exprs)
+            {
+                liveness.add_expr(expr);
+            }
+        }
+
+        void operator()(const NodeStmtReturn* stmt_ret)
+        {
+            if (stmt_ret->expr.has_value())
+            {
+                liveness.add_expr(stmt_ret->expr.value());
+            }
+        }
+
+        void operator()(const NodeExpr* stmt_expr)
+        {
+            liveness.add_expr(stmt_expr);
+        }
+
+        void operator()(const NodeStmtLet* stmt_let)
+        {
+            // Expression of a dead let is never generated
+            if (!liveness.is_dead(stmt_let))
+            {
+                liveness.add_expr(stmt_let->expr);
+            }
+
+            liveness.m_in_scope.push_back(liveness.m_locals.size());
+            liveness.m_locals.push_back(Local{.name = stmt_let->ident.value.value(), .stmt_let = stmt_let, .region = liveness.m_region});
+        }
+
+        void operator()(const NodeStmtIf* stmt_if)
+        {
+            liveness.add_expr(stmt_if->expr);
+            liveness.add_region_stmt(stmt_if->stmt);
+            if (stmt_if->else_stmt != nullptr)
+            {
+                liveness.add_region_stmt(stmt_if->else_stmt);
+            }
+        }
+
+        void operator()(const NodeStmtWhile* stmt_while)
+        {
+            // Condition is evaluated every time through the loop, so it's in the same region as the body
+            size_t region = liveness.m_region;
+            liveness.m_region = ++liveness.m_num_regions;
+            liveness.add_expr(stmt_while->expr);
+            liveness.add_region_stmt(stmt_while->stmt);
+            liveness.m_region = region;
+        }
+
+        // Variable holding each element isn't a let, so it's never moved
+        void operator()(const NodeStmtFor* stmt_for)
+        {
+            liveness.add_expr(stmt_for->expr);
+            liveness.add_region_stmt(stmt_for->stmt);
+        }
+
+        void operator()(const NodeScope* stmt_scope)
+        {
+            size_t num_in_scope = liveness.m_in_scope.size();
+            for (const NodeStmt* stmt : stmt_scope->stmts)
+            {
+                liveness.add_stmt(stmt);
+            }
+            liveness.m_in_scope.resize(num_in_scope);
+        }
+    };
+
+    StmtVisitor visitor(*this);
+    std::visit(visitor, stmt->var);
+}
+
+void Liveness::add_region_stmt(const NodeStmt* stmt)
+{
+    size_t region = m_region;
+    size_t num_in_scope = m_in_scope.size();
+    m_region = ++m_num_regions;
+
+    add_stmt(stmt);
+
+    m_region = region;
+    m_in_scope.resize(num_in_scope);
+}
+
+void Liveness::add_region_expr(const NodeExpr* expr)
+{
+    size_t region = m_region;
+    m_region = ++m_num_regions;
+
+    add_expr(expr);
+
+    m_region = region;
+}
+
+void Liveness::add_expr(const NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        add_term(std::get<NodeTerm*>(expr->var));
+        return;
+    }
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+
+    switch (expr_bin->op_type)
+    {
+    case TokenType_::eq:
+    case TokenType_::plus_eq:
+    case TokenType_::dash_eq:
+    case TokenType_::star_eq:
+    case TokenType_::fslash_eq:
+    case TokenType_::mod_eq:
+        // Value is generated before the variable it's assigned to is touched
+        add_expr(expr_bin->rhs);
+        if (std::holds_alternative<NodeTerm*>(expr_bin->lhs->var) &&
+            std::holds_alternative<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var))
+        {
+            add_write(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var));
+        }
+        return;
+    // Right side might not be evaluated
+    case TokenType_::double_amp:
+    case TokenType_::double_bar:
+        add_expr(expr_bin->lhs);
+        add_region_expr(expr_bin->rhs);
+        return;
+    default:
+        add_expr(expr_bin->lhs);
+        add_expr(expr_bin->rhs);
+        return;
+    }
+}
+
+void Liveness::add_term(const NodeTerm* term)
+{
+    struct TermVisitor {
+        Liveness& liveness;
+        TermVisitor (Liveness& _liveness) :liveness(_liveness) {}
+
+        void operator()(const NodeTermUn* term_un)
+        {
+            if ((term_un->op_type == TokenType_::double_plus || term_un->op_type == TokenType_::double_dash) &&
+                std::holds_alternative<NodeTermVar*>(term_un->term->var))
+            {
+                liveness.add_write(std::get<NodeTermVar*>(term_un->term->var));
+                return;
+            }
+
+            liveness.add_term(term_un->term);
+        }
+
+        void operator()(const NodeTermUnPost* term_un_post)
+        {
+            liveness.add_write(term_un_post->vari);
+        }
+
+        void operator()(const NodeTermNumLit*) {}
+
+        void operator()(const NodeTermListLit* term_list_lit)
+        {
+            for (const NodeExpr* expr : term_list_lit->exprs)
+            {
+                liveness.add_expr(expr);
+            }
+        }
+
+        void operator()(const NodeTermPatternLit*) {}
+
+        void operator()(const NodeTermBoolLit*) {}
+
+        void operator()(const NodeTermNullLit*) {}
+
+        void operator()(const NodeTermVar* term_var)
+        {
+            liveness.add_read(term_var);
+        }
+
+        void operator()(const NodeTermParen* term_paren)
+        {
+            liveness.add_expr(term_paren->expr);
+        }
+
+        void operator()(const NodeTermCallFunc* call_func)
+        {
+            for (const NodeExpr* expr : call_func->func->exprs)
+            {
+                liveness.add_expr(expr);
+            }
+        }
+        // Only one of the values is evaluated, like the branches of an if
+        void operator()(const NodeTermTernary* term_ternary)
+        {
+            liveness.add_expr(term_ternary->expr);
+            liveness.add_region_expr(term_ternary->then_expr);
+            liveness.add_region_expr(term_ternary->else_expr);
+        }
+    };
+
+    TermVisitor visitor(*this);
+    std::visit(visitor, term->var);
+}
+
+void Liveness::add_read(const NodeTermVar* var)
+{
+    if (std::holds_alternative<NodeVarIdent*>(var->var))
+    {
+        add_use(std::get<NodeVarIdent*>(var->var)->ident.value.value(), var);
+        return;
+    }
+
+    const NodeVarListSubscript* subscript = std::get<NodeVarListSubscript*>(var->var);
+    add_use(subscript->ident.value.value(), var);
+    add_expr(subscript->expr);
+}
+
+void Liveness::add_write(const NodeTermVar* var)
+{
+    if (std::holds_alternative<NodeVarIdent*>(var->var))
+    {
+        add_use(std::get<NodeVarIdent*>(var->var)->ident.value.value(), nullptr);
+        return;
+    }
+
+    const NodeVarListSubscript* subscript = std::get<NodeVarListSubscript*>(var->var);
+    add_use(subscript->ident.value.value(), nullptr);
+
+    bool was_in_assigned_subscript = m_in_assigned_subscript;
+    m_in_assigned_subscript = true;
+    add_expr(subscript->expr);
+    m_in_assigned_subscript = was_in_assigned_subscript;
+}
+
+void Liveness::add_use(const std::string& name, const NodeTermVar* read)
+{
+    // Locals can't share names with others in scope, but can with globals
+    std::vector<size_t>::reverse_iterator iter = std::find_if(m_in_scope.rbegin(), m_in_scope.rend(),
+        [&](size_t index){ return m_locals[index].name == name; });
+    if (iter == m_in_scope.rend())
+    {
+        return;
+    }
+
+    Local& local = m_locals[*iter];
+    ++local.num_uses;
+    local.last_read = (local.region == m_region && !m_in_assigned_subscript) ? read : nullptr;
+}
\ No newline at end of file
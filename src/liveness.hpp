@@ -0,0 +1,53 @@
+#pragma once
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+
+// Finds where each local variable or param is used for the last time, so its value can be taken off the stack there instead of
+// being copied and left for the end of its scope to pop
+class Liveness {
+public:
+    Liveness(const NodeProg* prog);
+
+    // Whether read is the last use of a local or param, and runs exactly once each time the local's let or function does
+    bool is_last_read(const NodeTermVar* var) const;
+    // Whether let's variable is never used, and its expression does nothing but make the value
+    bool is_dead(const NodeStmtLet* stmt_let) const;
+private:
+    struct Local {
+        std::string name;
+        // Null for params
+        const NodeStmtLet* stmt_let;
+        // Code in the same region always runs the same number of times, regions are started by the branches of ifs and by loops
+        size_t region;
+        size_t num_uses = 0;
+        // Last use, if it's a read in the let's region
+        const NodeTermVar* last_read = nullptr;
+    };
+
+    void add_func(const NodeFunctionDef* func_def);
+    void add_stmt(const NodeStmt* stmt);
+    // Adds statement that might not run, or might run more than once
+    void add_region_stmt(const NodeStmt* stmt);
+    void add_region_expr(const NodeExpr* expr);
+    void add_expr(const NodeExpr* expr);
+    void add_term(const NodeTerm* term);
+    void add_read(const NodeTermVar* var);
+    void add_write(const NodeTermVar* var);
+    void add_use(const std::string& name, const NodeTermVar* read);
+
+    // Params and locals of the function being added, in the order they're declared
+    std::vector<Local> m_locals;
+    // Indices of locals that can be seen where uses are being added
+    std::vector<size_t> m_in_scope;
+    size_t m_region = 0;
+    size_t m_num_regions = 0;
+    // Set in subscripts of assignments, which are generated while the list is off the stack, so nothing can be moved
+    bool m_in_assigned_subscript = false;
+
+    std::set<const NodeTermVar*> m_last_reads;
+    std::set<const NodeStmtLet*> m_dead_lets;
+};
\ No newline at end of file
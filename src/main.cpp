@@ -11,17 +11,73 @@
 #include "util.hpp"
 #include "tokenization.hpp"
 #include "parser.hpp"
+#include "folding.hpp"
+#include "specialization.hpp"
 #include "generation.hpp"
+#include "scheduling.hpp"
 #include "optimization.hpp"
+#include "peephole.hpp"
+#include "numbers.hpp"
+#include "embedding.hpp"
+#include "profile.hpp"
 #include "assembler.hpp"
 
 int main(int argc, char** argv)
 {
     // Check to make sure proper args are given
-    if (argc != 3)
+    NumberGoal number_goal = NumberGoal::pattern_count;
+    UnrollGoal unroll_goal = UnrollGoal::focus_size;
+    size_t unroll_budget = 100;
+    size_t specialize_budget = 100;
+    std::optional<std::string> profile_path;
+    bool args_valid = argc >= 3;
+    for (int i = 3; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        std::string budget_prefix = "--unroll-budget=";
+        std::string specialize_prefix = "--specialize-budget=";
+        std::string profile_prefix = "--profile-use=";
+
+        if (arg == "--optimize=size")
+        {
+            number_goal = NumberGoal::encoded_size;
+        }
+        else if (arg == "--optimize=patterns")
+        {
+            number_goal = NumberGoal::pattern_count;
+        }
+        else if (arg == "--unroll=evals")
+        {
+            unroll_goal = UnrollGoal::evals;
+        }
+        else if (arg == "--unroll=size")
+        {
+            unroll_goal = UnrollGoal::focus_size;
+        }
+        else if (arg.rfind(budget_prefix, 0) == 0 && arg.size() > budget_prefix.size() &&
+            arg.find_first_not_of("0123456789", budget_prefix.size()) == std::string::npos)
+        {
+            unroll_budget = std::stoull(arg.substr(budget_prefix.size()));
+        }
+        else if (arg.rfind(specialize_prefix, 0) == 0 && arg.size() > specialize_prefix.size() &&
+            arg.find_first_not_of("0123456789", specialize_prefix.size()) == std::string::npos)
+        {
+            specialize_budget = std::stoull(arg.substr(specialize_prefix.size()));
+        }
+        else if (arg.rfind(profile_prefix, 0) == 0 && arg.size() > profile_prefix.size())
+        {
+            profile_path = arg.substr(profile_prefix.size());
+        }
+        else
+        {
+            args_valid = false;
+        }
+    }
+
+    if (!args_valid)
     {
         std::cerr << "Hex++ Compiler: Incorrect arguments. Correct arguments are:" << std::endl;
-        std::cerr << "<input.hxpp> <output.hexpattern>" << std::endl;
+        std::cerr << "<input.hxpp> <output.hexpattern> [--optimize=patterns|--optimize=size] [--unroll=size|--unroll=evals] [--unroll-budget=<patterns>] [--specialize-budget=<patterns>] [--profile-use=<profile>]" << std::endl;
         return EXIT_FAILURE;
     }
 
@@ -73,21 +129,155 @@ int main(int argc, char** argv)
         compilation_error("Failed to parse tokens", 0);
     }
 
+    // Fold constant expressions, not in scope so allocator doesn't destruct
+    ConstantFolder folder(prog);
+    folder.fold();
+
+    for (const std::string& global_name : folder.const_globals)
+    {
+        compilation_message("Replaced constant global " + global_name + " with its value.");
+    }
+
+    if (folder.num_evaluated_calls > 0)
+    {
+        compilation_message("Ran " + std::to_string(folder.num_evaluated_calls) + " calls to declared functions at compile time and replaced them with their results.");
+    }
+
+    // Copy functions for calls passing constants, not in scope so allocator doesn't destruct
+    Specializer specializer(prog, folder, specialize_budget);
+    specializer.specialize();
+
+    for (const std::pair<std::string, std::string>& func_names : specializer.specialized_funcs)
+    {
+        compilation_message("Specialized function " + func_names.second + " as " + func_names.first + " for the constants passed to it.");
+    }
+
+    // Read execution counts to tell hot code from cold
+    Profile profile;
+    if (profile_path.has_value())
+    {
+        profile = Profile(profile_path.value());
+        compilation_message("Optimizing with execution counts from \"" + profile_path.value() + "\".");
+    }
+
     // Generate hexes
     std::vector<Pattern> patterns;
-    bool found_non_integer_num;
     {
-        Generator generator(prog);
+        Generator generator(prog, unroll_goal, unroll_budget, std::move(profile));
         patterns = generator.generate();
-        found_non_integer_num = generator.has_non_integer_num;
+
+        if (generator.num_unreachable_patterns > 0)
+        {
+            compilation_message("Removed " + std::to_string(generator.num_unreachable_patterns) + " patterns from code that could never run.");
+        }
+
+        for (const std::string& func_name : generator.inlined_funcs)
+        {
+            compilation_message("Inlined function " + func_name + ".");
+        }
+
+        for (const FuncKey& func : generator.uncalled_funcs)
+        {
+            if (folder.evaluated_funcs.contains(func))
+            {
+                compilation_message("Removed function " + func.first + ", since every call to it was run at compile time.");
+            }
+            else
+            {
+                compilation_message("Removed function " + func.first + ", since it's never called.");
+            }
+        }
+
+        for (const std::pair<std::string, size_t>& tail_call : generator.tail_calls)
+        {
+            compilation_message("Call to " + tail_call.first + " on line " + std::to_string(tail_call.second) + " made into a jump.");
+        }
+
+        if (generator.num_hoisted_exprs > 0)
+        {
+            compilation_message("Moved " + std::to_string(generator.num_hoisted_exprs) + " expressions that never change out of loops.");
+        }
+
+        if (generator.num_common_exprs > 0)
+        {
+            compilation_message("Computed " + std::to_string(generator.num_common_exprs) + " repeated expressions once and reused their values.");
+        }
+
+        if (generator.num_unrolled_loops > 0)
+        {
+            compilation_message("Unrolled " + std::to_string(generator.num_unrolled_loops) + " loops into copies of their bodies.");
+        }
+
+        if (generator.num_indexed_for_loops > 0)
+        {
+            compilation_message(std::to_string(generator.num_indexed_for_loops) + " for loops set variables declared outside them, so they step through indices instead of using Thoth's Gambit.");
+        }
+
+        if (generator.num_jump_tables > 0)
+        {
+            compilation_message("Picked the case to run from a list in " + std::to_string(generator.num_jump_tables) + " switches and if-else chains instead of checking each case in turn.");
+        }
+
+        if (generator.num_moved_reads > 0)
+        {
+            compilation_message("Moved " + std::to_string(generator.num_moved_reads) + " variables off the stack at their last use instead of copying them.");
+        }
+
+        if (generator.num_dead_lets > 0)
+        {
+            compilation_message("Left out " + std::to_string(generator.num_dead_lets) + " variables that were never used.");
+        }
     }
 
     // Do post-gen optimization
     {
+        StackScheduler scheduler(patterns);
+        patterns = scheduler.schedule();
+
         Optimizer optimizer(patterns);
         patterns = optimizer.optimize();
+
+        std::string rules_used;
+        for (size_t i = 0; i < optimizer.rule_hits.size(); ++i)
+        {
+            if (optimizer.rule_hits[i] > 0)
+            {
+                rules_used += (rules_used.empty() ? "" : ", ") + peephole_rules()[i].name + " x" + std::to_string(optimizer.rule_hits[i]);
+            }
+        }
+        if (!rules_used.empty())
+        {
+            compilation_message("Peephole rules used: " + rules_used + ".");
+        }
+
+        // Before encoding numbers, since embedded ones are written exactly and don't need to be drawn
+        ConstantEmbedder embedder(patterns);
+        patterns = embedder.embed();
+
+        if (embedder.num_embedded > 0)
+        {
+            compilation_message("Embedded " + std::to_string(embedder.num_embedded) + " constant iotas in the spell instead of building them.");
+        }
+
+        if (embedder.num_scaled_axes > 0)
+        {
+            compilation_message("Built " + std::to_string(embedder.num_scaled_axes) + " constant vectors by scaling a vector reflection.");
+        }
+
+        // After optimizing, since numbers built from other numbers would just be folded back together
+        NumberEncoder encoder(patterns, number_goal, hexagon_exists);
+        patterns = encoder.encode();
+
+        if (encoder.num_rewritten > 0)
+        {
+            compilation_message("Rewrote " + std::to_string(encoder.num_rewritten) + " numbers to be built from ones that are easier to draw.");
+        }
     }
 
+    // Hexagon can only draw integers
+    bool found_non_integer_num = std::any_of(patterns.begin(), patterns.end(), [](const Pattern& pattern){
+        return pattern.type == PatternType::numerical_reflection && pattern.value.value().find('.') != std::string::npos; });
+
     // Assemble patterns into string output
     std::string code;
     {
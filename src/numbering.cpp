@@ -0,0 +1,405 @@
+#include "numbering.hpp"
+
+#include "effects.hpp"
+
+ValueNumbering::ValueNumbering(const std::vector<NodeStmt*>& stmts, std::set<std::string> globals)
+    :m_stmts(stmts), m_globals(std::move(globals))
+{ }
+
+std::vector<std::vector<NumberedExpr>> ValueNumbering::find()
+{
+    for (m_stmt_index = 0; m_stmt_index < m_stmts.size(); ++m_stmt_index)
+    {
+        m_stmt_changes = false;
+        add_stmt(m_stmts[m_stmt_index]);
+    }
+
+    std::vector<std::vector<NumberedExpr>> repeated;
+    for (std::pair<const size_t, std::vector<NumberedExpr>>& evaluations : m_evaluations)
+    {
+        if (evaluations.second.size() > 1)
+        {
+            repeated.push_back(std::move(evaluations.second));
+        }
+    }
+    return repeated;
+}
+
+void ValueNumbering::add_stmt(const NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        ValueNumbering& numbering;
+        StmtVisitor (ValueNumbering& _numbering) :numbering(_numbering) {}
+
+        void operator()(const NodeStmtCallFunction* call_func)
+        {
+            numbering.number_call(call_func->func, true, false);
+        }
+
+        void operator()(const NodeStmtReturn* stmt_ret)
+        {
+            if (stmt_ret->expr.has_value())
+            {
+                numbering.number_expr(stmt_ret->expr.value());
+            }
+        }
+
+        void operator()(const NodeExpr* stmt_expr)
+        {
+            numbering.number_expr(stmt_expr);
+        }
+
+        void operator()(const NodeStmtLet* stmt_let)
+        {
+            numbering.number_expr(stmt_let->expr);
+            // Name refers to a new variable from here on
+            numbering.write_var(stmt_let->ident.value.value());
+        }
+
+        void operator()(const NodeStmtIf* stmt_if)
+        {
+            numbering.number_expr(stmt_if->expr);
+            numbering.add_unnumbered_stmt(stmt_if->stmt);
+            if (stmt_if->else_stmt != nullptr)
+            {
+                numbering.add_unnumbered_stmt(stmt_if->else_stmt);
+            }
+        }
+
+        void operator()(const NodeStmtWhile* stmt_while)
+        {
+            // Condition runs again after the body, so it can't reuse anything
+            bool was_numbering = numbering.m_is_numbering;
+            numbering.m_is_numbering = false;
+            numbering.number_expr(stmt_while->expr);
+            numbering.add_stmt(stmt_while->stmt);
+            numbering.m_is_numbering = was_numbering;
+        }
+
+        void operator()(const NodeStmtFor* stmt_for)
+        {
+            // List is evaluated once, but the body runs once for each element
+            numbering.number_expr(stmt_for->expr);
+            numbering.write_var(stmt_for->ident.value.value());
+            numbering.add_unnumbered_stmt(stmt_for->stmt);
+        }
+
+        void operator()(const NodeScope* stmt_scope)
+        {
+            // Scope numbers its own statements when it's generated
+            for (const NodeStmt* stmt : stmt_scope->stmts)
+            {
+                numbering.add_unnumbered_stmt(stmt);
+            }
+        }
+    };
+
+    StmtVisitor visitor(*this);
+    std::visit(visitor, stmt->var);
+}
+
+void ValueNumbering::add_unnumbered_stmt(const NodeStmt* stmt)
+{
+    bool was_numbering = m_is_numbering;
+    m_is_numbering = false;
+    add_stmt(stmt);
+    m_is_numbering = was_numbering;
+}
+
+// Whether term is simple enough that it's never worth reusing
+static bool is_simple_term(const NodeTerm* term)
+{
+    return std::holds_alternative<NodeTermNumLit*>(term->var) || std::holds_alternative<NodeTermPatternLit*>(term->var) ||
+        std::holds_alternative<NodeTermBoolLit*>(term->var) || std::holds_alternative<NodeTermNullLit*>(term->var) ||
+        std::holds_alternative<NodeTermParen*>(term->var) || (std::holds_alternative<NodeTermVar*>(term->var) &&
+        std::holds_alternative<NodeVarIdent*>(std::get<NodeTermVar*>(term->var)->var));
+}
+
+std::optional<size_t> ValueNumbering::number_expr(const NodeExpr* expr)
+{
+    std::optional<size_t> num;
+
+    m_outer_exprs.push_back(expr);
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        num = number_term(std::get<NodeTerm*>(expr->var));
+    }
+    else
+    {
+        const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+
+        switch (expr_bin->op_type)
+        {
+        case TokenType_::eq:
+        case TokenType_::plus_eq:
+        case TokenType_::dash_eq:
+        case TokenType_::star_eq:
+        case TokenType_::fslash_eq:
+        case TokenType_::mod_eq:
+            // Value is generated before the variable it's assigned to is touched
+            number_expr(expr_bin->rhs);
+            if (std::holds_alternative<NodeTerm*>(expr_bin->lhs->var) &&
+                std::holds_alternative<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var))
+            {
+                add_write(std::get<NodeTermVar*>(std::get<NodeTerm*>(expr_bin->lhs->var)->var));
+            }
+            else
+            {
+                number_expr(expr_bin->lhs);
+            }
+            break;
+        case TokenType_::dot:
+        {
+            std::optional<size_t> lhs = number_expr(expr_bin->lhs);
+            if (!std::holds_alternative<NodeTerm*>(expr_bin->rhs->var) ||
+                !std::holds_alternative<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var))
+            {
+                number_expr(expr_bin->rhs);
+                break;
+            }
+
+            std::optional<std::string> call = number_call(std::get<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var)->func,
+                false, true);
+            if (lhs.has_value() && call.has_value())
+            {
+                num = number(std::to_string(lhs.value()) + "." + call.value());
+            }
+            break;
+        }
+        default:
+        {
+            std::optional<size_t> lhs = number_expr(expr_bin->lhs);
+
+            // Right side of && and || might not be evaluated
+            bool was_numbering = m_is_numbering;
+            if (expr_bin->op_type == TokenType_::double_amp || expr_bin->op_type == TokenType_::double_bar)
+            {
+                m_is_numbering = false;
+            }
+            std::optional<size_t> rhs = number_expr(expr_bin->rhs);
+            m_is_numbering = was_numbering;
+
+            if (lhs.has_value() && rhs.has_value())
+            {
+                num = number("(" + std::to_string(lhs.value()) + " " + std::to_string((int)expr_bin->op_type) + " " +
+                    std::to_string(rhs.value()) + ")");
+            }
+            break;
+        }
+        }
+    }
+    m_outer_exprs.pop_back();
+
+    if (!num.has_value())
+    {
+        return {};
+    }
+
+    if (m_is_numbering && (std::holds_alternative<NodeExprBin*>(expr->var) || !is_simple_term(std::get<NodeTerm*>(expr->var))))
+    {
+        m_evaluations[num.value()].push_back(NumberedExpr{.expr = expr, .stmt_index = m_stmt_index, .order = m_order,
+            .can_compute_early = !m_stmt_changes, .outer_exprs = m_outer_exprs});
+    }
+    ++m_order;
+    return num;
+}
+
+std::optional<size_t> ValueNumbering::number_term(const NodeTerm* term)
+{
+    struct TermVisitor {
+        ValueNumbering& numbering;
+        TermVisitor (ValueNumbering& _numbering) :numbering(_numbering) {}
+
+        std::optional<size_t> operator()(const NodeTermUn* term_un)
+        {
+            if ((term_un->op_type == TokenType_::double_plus || term_un->op_type == TokenType_::double_dash) &&
+                std::holds_alternative<NodeTermVar*>(term_un->term->var))
+            {
+                numbering.add_write(std::get<NodeTermVar*>(term_un->term->var));
+                return {};
+            }
+
+            std::optional<size_t> num = numbering.number_term(term_un->term);
+            if (!num.has_value())
+            {
+                return {};
+            }
+            return numbering.number(std::to_string((int)term_un->op_type) + " " + std::to_string(num.value()));
+        }
+
+        std::optional<size_t> operator()(const NodeTermUnPost* term_un_post)
+        {
+            numbering.add_write(term_un_post->vari);
+            return {};
+        }
+
+        std::optional<size_t> operator()(const NodeTermNumLit* term_num_lit)
+        {
+            return numbering.number("num " + term_num_lit->num_lit.value.value());
+        }
+
+        std::optional<size_t> operator()(const NodeTermListLit* term_list_lit)
+        {
+            std::string key = "[";
+            bool is_numbered = true;
+            for (const NodeExpr* expr : term_list_lit->exprs)
+            {
+                std::optional<size_t> num = numbering.number_expr(expr);
+                is_numbered = is_numbered && num.has_value();
+                key += (num.has_value() ? std::to_string(num.value()) : "") + ",";
+            }
+
+            if (!is_numbered)
+            {
+                return {};
+            }
+            return numbering.number(key + "]");
+        }
+
+        std::optional<size_t> operator()(const NodeTermPatternLit* term_pattern_lit)
+        {
+            return numbering.number("pattern " + term_pattern_lit->pattern_lit.value.value());
+        }
+
+        std::optional<size_t> operator()(const NodeTermBoolLit* term_bool_lit)
+        {
+            return numbering.number("bool " + term_bool_lit->bool_.value.value());
+        }
+
+        std::optional<size_t> operator()(const NodeTermNullLit*)
+        {
+            return numbering.number("null");
+        }
+
+        std::optional<size_t> operator()(const NodeTermVar* term_var)
+        {
+            return numbering.number_var(term_var);
+        }
+
+        std::optional<size_t> operator()(const NodeTermParen* term_paren)
+        {
+            return numbering.number_expr(term_paren->expr);
+        }
+
+        std::optional<size_t> operator()(const NodeTermCallFunc* call_func)
+        {
+            std::optional<std::string> key = numbering.number_call(call_func->func, false, false);
+            if (!key.has_value())
+            {
+                return {};
+            }
+            return numbering.number(key.value());
+        }
+        std::optional<size_t> operator()(const NodeTermTernary* term_ternary)
+        {
+            std::optional<size_t> condition = numbering.number_expr(term_ternary->expr);
+
+            // Only one of the values is evaluated
+            bool was_numbering = numbering.m_is_numbering;
+            numbering.m_is_numbering = false;
+            std::optional<size_t> then_value = numbering.number_expr(term_ternary->then_expr);
+            std::optional<size_t> else_value = numbering.number_expr(term_ternary->else_expr);
+            numbering.m_is_numbering = was_numbering;
+
+            if (!condition.has_value() || !then_value.has_value() || !else_value.has_value())
+            {
+                return {};
+            }
+            return numbering.number(std::to_string(condition.value()) + " ? " + std::to_string(then_value.value()) + " : " +
+                std::to_string(else_value.value()));
+        }
+    };
+
+    TermVisitor visitor(*this);
+    return std::visit(visitor, term->var);
+}
+
+std::optional<size_t> ValueNumbering::number_var(const NodeTermVar* var)
+{
+    if (std::holds_alternative<NodeVarIdent*>(var->var))
+    {
+        return number(var_key(std::get<NodeVarIdent*>(var->var)->ident.value.value()));
+    }
+
+    const NodeVarListSubscript* subscript = std::get<NodeVarListSubscript*>(var->var);
+    std::optional<size_t> index = number_expr(subscript->expr);
+    if (!index.has_value())
+    {
+        return {};
+    }
+    return number(var_key(subscript->ident.value.value()) + "[" + std::to_string(index.value()) + "]");
+}
+
+std::optional<std::string> ValueNumbering::number_call(const NodeDefinedFunc* func, bool is_void, bool is_member)
+{
+    std::string key = func->ident.value.value() + "(";
+    bool is_numbered = true;
+    for (const NodeExpr* expr : func->exprs)
+    {
+        std::optional<size_t> num = number_expr(expr);
+        is_numbered = is_numbered && num.has_value();
+        key += (num.has_value() ? std::to_string(num.value()) : "") + ",";
+    }
+    key += ")";
+
+    switch (inbuilt_effect(func->ident.value.value(), is_void, is_member))
+    {
+    case Effect::pure:
+        break;
+    case Effect::reads_world:
+        key += " world " + std::to_string(m_world_version);
+        break;
+    case Effect::varies:
+        return {};
+    case Effect::changes_world:
+        ++m_world_version;
+        m_stmt_changes = true;
+        return {};
+    case Effect::unknown:
+        ++m_world_version;
+        ++m_globals_version;
+        m_stmt_changes = true;
+        return {};
+    }
+
+    if (!is_numbered)
+    {
+        return {};
+    }
+    return key;
+}
+
+void ValueNumbering::add_write(const NodeTermVar* var)
+{
+    if (std::holds_alternative<NodeVarIdent*>(var->var))
+    {
+        write_var(std::get<NodeVarIdent*>(var->var)->ident.value.value());
+        return;
+    }
+
+    const NodeVarListSubscript* subscript = std::get<NodeVarListSubscript*>(var->var);
+    number_expr(subscript->expr);
+    write_var(subscript->ident.value.value());
+}
+
+size_t ValueNumbering::number(const std::string& key)
+{
+    return m_numbers.emplace(key, m_numbers.size()).first->second;
+}
+
+std::string ValueNumbering::var_key(const std::string& name)
+{
+    std::string key = "var " + name + " " + std::to_string(m_var_versions[name]);
+    // Declared functions can write to globals
+    if (m_globals.count(name) > 0)
+    {
+        key += " " + std::to_string(m_globals_version);
+    }
+    return key;
+}
+
+void ValueNumbering::write_var(const std::string& name)
+{
+    ++m_var_versions[name];
+    m_stmt_changes = true;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+
+// Evaluation of an expression in a block, where it has a value number
+struct NumberedExpr {
+    const NodeExpr* expr;
+    // Index of the statement it's in
+    size_t stmt_index;
+    // Position in the order expressions finish being evaluated
+    size_t order;
+    // Whether nothing before it in its statement changes anything, so it could be computed right before the statement
+    bool can_compute_early;
+    // Numbered expressions it's part of
+    std::vector<const NodeExpr*> outer_exprs;
+};
+
+// Numbers expressions evaluated every time a block of statements runs, so that expressions given the same number are sure
+// to have the same value. Writes to variables and calls that change the world give what they affect new numbers
+class ValueNumbering {
+public:
+    // Globals are the names that refer to global variables where the block is
+    ValueNumbering(const std::vector<NodeStmt*>& stmts, std::set<std::string> globals);
+
+    // Expressions evaluated more than once with the same value, each in the order they're evaluated
+    std::vector<std::vector<NumberedExpr>> find();
+private:
+    void add_stmt(const NodeStmt* stmt);
+    // Adds statement that might not run, or might run more than once, only keeping track of what it changes
+    void add_unnumbered_stmt(const NodeStmt* stmt);
+    // Value number of expression, empty if evaluating it does more than give a value
+    std::optional<size_t> number_expr(const NodeExpr* expr);
+    std::optional<size_t> number_term(const NodeTerm* term);
+    std::optional<size_t> number_var(const NodeTermVar* var);
+    // Numbers arguments of call, and returns the key of the call if it only gives a value
+    std::optional<std::string> number_call(const NodeDefinedFunc* func, bool is_void, bool is_member);
+    void add_write(const NodeTermVar* var);
+
+    size_t number(const std::string& key);
+    std::string var_key(const std::string& name);
+    void write_var(const std::string& name);
+
+    const std::vector<NodeStmt*>& m_stmts;
+    std::set<std::string> m_globals;
+
+    std::map<std::string, size_t> m_numbers;
+    std::map<std::string, size_t> m_var_versions;
+    size_t m_world_version = 0;
+    // Changed by calls that could write to any global
+    size_t m_globals_version = 0;
+
+    // Whether expressions being numbered are evaluated exactly once each time the block runs
+    bool m_is_numbering = true;
+    size_t m_stmt_index = 0;
+    // Set once something changes in the statement being numbered
+    bool m_stmt_changes = false;
+    size_t m_order = 0;
+    std::vector<const NodeExpr*> m_outer_exprs;
+
+    std::map<size_t, std::vector<NumberedExpr>> m_evaluations;
+};
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "numbers.hpp"
+
+#include <cmath>
+#include <numeric>
+
+// Besides its angles, every pattern in a focus stores its type and start direction, which take up about as much of
+// the /give command as this many angles
+static const size_t pattern_overhead = 28;
+// Past this, searching for factors takes too long
+static const long long max_factor = 1000000;
+// Past 2^53 doubles stop being able to hold every integer
+static const long long max_exact_num = 9007199254740992;
+
+// Angles needed to add num with w (+1), q (+5) and e (+10)
+static size_t num_add_angles(unsigned long long num)
+{
+    return num / 10 + num % 10 / 5 + num % 5;
+}
+
+// Angles after the sign prefix needed to draw a non-negative integer, using a (*2) between additions
+static size_t num_digit_angles(unsigned long long num)
+{
+    static std::map<unsigned long long, size_t> memo;
+
+    if (num == 0)
+    {
+        return 0;
+    }
+
+    std::map<unsigned long long, size_t>::iterator iter = memo.find(num);
+    if (iter != memo.end())
+    {
+        return iter->second;
+    }
+
+    size_t best = num_add_angles(num);
+
+    // Double a smaller number, then add whatever is left
+    for (unsigned long long rest = num % 2; rest <= num && rest <= 30; rest += 2)
+    {
+        unsigned long long half = (num - rest) / 2;
+        if (half == 0)
+        {
+            continue;
+        }
+
+        best = std::min(best, num_digit_angles(half) + 1 + num_add_angles(rest));
+    }
+
+    memo[num] = best;
+    return best;
+}
+
+size_t num_signature_length(long long num)
+{
+    // Prefix is aqaa for positive numbers and dedd for negative ones
+    return 4 + num_digit_angles(num < 0 ? -(unsigned long long)num : num);
+}
+
+// Splits decimal literal into numerator and denominator in lowest terms, if both fit
+static std::optional<std::pair<long long, long long>> num_lit_fraction(const std::string& num_lit)
+{
+    long long numerator = 0;
+    long long denominator = 1;
+    bool is_negative = false;
+    bool found_decimal = false;
+    size_t num_digits = 0;
+
+    for (size_t i = 0; i < num_lit.size(); ++i)
+    {
+        char c = num_lit[i];
+        if (c == '-' && i == 0)
+        {
+            is_negative = true;
+        }
+        else if (c == '.' && !found_decimal)
+        {
+            found_decimal = true;
+        }
+        else if (std::isdigit(c))
+        {
+            // Leave room to multiply by 10
+            if (++num_digits > max_num_lit_digits)
+            {
+                return {};
+            }
+
+            numerator = numerator * 10 + (c - '0');
+            if (found_decimal)
+            {
+                denominator *= 10;
+            }
+        }
+        else
+        {
+            return {};
+        }
+    }
+
+    if (num_digits == 0)
+    {
+        return {};
+    }
+
+    long long divisor = std::gcd(numerator, denominator);
+    numerator /= divisor;
+    denominator /= divisor;
+
+    return std::make_pair(is_negative ? -numerator : numerator, denominator);
+}
+
+NumberEncoder::NumberEncoder(std::vector<Pattern> patterns, NumberGoal goal, bool integers_only)
+    :m_patterns(std::move(patterns)), m_goal(goal), m_integers_only(integers_only)
+{ }
+
+std::vector<Pattern> NumberEncoder::encode()
+{
+    for (size_t i = 0; i < m_patterns.size(); ++i)
+    {
+        // Escaped patterns are pushed as they are
+        if (m_patterns[i].type == PatternType::consideration && i + 1 < m_patterns.size())
+        {
+            m_output.push_back(m_patterns[i]);
+            m_output.push_back(m_patterns[++i]);
+            continue;
+        }
+
+        if (m_patterns[i].type == PatternType::numerical_reflection)
+        {
+            size_t output_size = m_output.size();
+            encode_num(m_patterns[i].value.value());
+
+            if (m_output.size() != output_size + 1)
+            {
+                ++num_rewritten;
+            }
+            continue;
+        }
+
+        m_output.push_back(m_patterns[i]);
+    }
+
+    return m_output;
+}
+
+void NumberEncoder::encode_num(const std::string& num_lit)
+{
+    std::optional<std::pair<long long, long long>> fraction = num_lit_fraction(num_lit);
+    if (!fraction.has_value())
+    {
+        m_output.push_back(Pattern{.type = PatternType::numerical_reflection, .value = num_lit});
+        return;
+    }
+
+    long long numerator = fraction.value().first;
+    long long denominator = fraction.value().second;
+
+    if (denominator == 1)
+    {
+        std::optional<std::vector<Pattern>> cheaper = {};
+        if (m_goal == NumberGoal::encoded_size)
+        {
+            cheaper = cheaper_integer(numerator);
+        }
+
+        if (cheaper.has_value())
+        {
+            m_output.insert(m_output.end(), cheaper.value().begin(), cheaper.value().end());
+        }
+        else
+        {
+            m_output.push_back(Pattern{.type = PatternType::numerical_reflection, .value = std::to_string(numerator)});
+        }
+        return;
+    }
+
+    // Halving is the only way to draw fractions, so only ones over a power of 2 can be drawn exactly
+    bool is_drawable = (denominator & (denominator - 1)) == 0;
+    if (is_drawable && !m_integers_only)
+    {
+        m_output.push_back(Pattern{.type = PatternType::numerical_reflection, .value = num_lit});
+        return;
+    }
+
+    encode_num(std::to_string(numerator));
+    encode_num(std::to_string(denominator));
+    m_output.push_back(Pattern{.type = PatternType::division_distillation, .value = {}});
+}
+
+std::optional<std::vector<Pattern>> NumberEncoder::cheaper_integer(long long num)
+{
+    if (num > max_exact_num || num < -max_exact_num)
+    {
+        return {};
+    }
+
+    std::optional<std::vector<Pattern>> best = {};
+    size_t best_size = encoded_size(Pattern{.type = PatternType::numerical_reflection, .value = std::to_string(num)});
+
+    auto try_candidate = [&](long long lhs, long long rhs, PatternType op) {
+        std::vector<Pattern> candidate = {
+            Pattern{.type = PatternType::numerical_reflection, .value = std::to_string(lhs)},
+            Pattern{.type = PatternType::numerical_reflection, .value = std::to_string(rhs)},
+            Pattern{.type = op, .value = {}},
+        };
+
+        size_t size = encoded_size(candidate);
+        if (size < best_size)
+        {
+            best = candidate;
+            best_size = size;
+        }
+    };
+
+    long long magnitude = std::abs(num);
+
+    // Products
+    for (long long factor = 2; factor <= max_factor && factor * factor <= magnitude; ++factor)
+    {
+        if (magnitude % factor == 0)
+        {
+            try_candidate(num / factor, factor, PatternType::multiplicative_distillation);
+        }
+    }
+
+    // Sums and differences with small numbers
+    for (long long offset = 1; offset <= 64; ++offset)
+    {
+        try_candidate(num - offset, offset, PatternType::additive_distillation);
+        try_candidate(num + offset, offset, PatternType::subtractive_distillation);
+    }
+
+    // Powers
+    for (long long exponent = 2; num > 1 && exponent < 64; ++exponent)
+    {
+        long long base = std::llround(std::pow((double)num, 1.0 / exponent));
+        if (base < 2)
+        {
+            break;
+        }
+
+        if (std::pow((double)base, (double)exponent) == (double)num)
+        {
+            try_candidate(base, exponent, PatternType::power_distillation);
+        }
+    }
+
+    return best;
+}
+
+size_t NumberEncoder::encoded_size(const Pattern& pattern)
+{
+    switch (pattern.type)
+    {
+    case PatternType::numerical_reflection:
+        return pattern_overhead + num_signature_length(std::stoll(pattern.value.value()));
+    // waaw and wddw
+    case PatternType::additive_distillation:
+    case PatternType::subtractive_distillation:
+        return pattern_overhead + 4;
+    // waqaw, wdedw and wedew
+    case PatternType::multiplicative_distillation:
+    case PatternType::division_distillation:
+    case PatternType::power_distillation:
+        return pattern_overhead + 5;
+    default:
+        return pattern_overhead;
+    }
+}
+
+size_t NumberEncoder::encoded_size(const std::vector<Pattern>& patterns)
+{
+    size_t size = 0;
+    for (const Pattern& pattern : patterns)
+    {
+        size += encoded_size(pattern);
+    }
+    return size;
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "generation.hpp"
+
+// What to make smaller when there's a choice in how to draw a number
+enum class NumberGoal {
+    pattern_count,
+    encoded_size,
+};
+
+// Number of angles in the signature of the numerical reflection for an integer, including the sign prefix
+size_t num_signature_length(long long num);
+
+// Rewrites numerical reflections that can't be drawn exactly, or that are cheaper to build from other numbers
+class NumberEncoder {
+public:
+    // Numbers must be integers for Hexagon to draw them properly
+    NumberEncoder(std::vector<Pattern> patterns, NumberGoal goal, bool integers_only);
+
+    std::vector<Pattern> encode();
+
+    size_t num_rewritten = 0;
+private:
+    void encode_num(const std::string& num_lit);
+    // Cheapest patterns that build integer, if cheaper than drawing it directly
+    std::optional<std::vector<Pattern>> cheaper_integer(long long num);
+
+    // Size of pattern in a focus, measured in angles
+    size_t encoded_size(const Pattern& pattern);
+    size_t encoded_size(const std::vector<Pattern>& patterns);
+
+    std::vector<Pattern> m_patterns;
+    std::vector<Pattern> m_output;
+    NumberGoal m_goal;
+    bool m_integers_only;
+};
\ No newline at end of file
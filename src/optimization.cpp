@@ -1,331 +1,94 @@
 #include "optimization.hpp"
 
-#include "util.hpp"
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+#include <unordered_map>
 
-#define no_opt() no_optimization = true;add_pattern(consume());
+#include "util.hpp"
+#include "peephole.hpp"
+#include "shuffle_table.hpp"
 
 Optimizer::Optimizer (std::vector<Pattern> patterns)
-    :m_patterns(std::vector<Pattern>(patterns))
+    :rule_hits(peephole_rules().size()), m_patterns(std::vector<Pattern>(patterns))
 { }
 
 std::vector<Pattern> Optimizer::optimize()
 {
+    static const PeepholeMatcher matcher(peephole_rules());
+
     // Loop until no more optimizations are found
     while (true)
     {
-        bool found_optimizations = false;
+        bool found_optimizations = peephole_pass(matcher);
 
-        // TODO: Boolean optimizations, do boolean ops between boolean literals and when doing boolean logic that can be solved at compile time
-        // Loop over all patterns
-        while (peek().has_value())
+        // Peephole rules are done, see if any shuffles can be drawn shorter
+        if (!found_optimizations && !optimize_shuffles())
         {
-            bool no_optimization = false;
+            return m_output;
+        }
 
-            switch (peek().value().type)
+        m_patterns = std::vector<Pattern>(m_output);
+        m_output.clear();
+    }
+}
+
+bool Optimizer::peephole_pass(const PeepholeMatcher& matcher)
+{
+    // Patterns are kept in a gap buffer, where patterns before the gap are done and patterns after it are still to be
+    // matched. A rewrite puts its patterns back after the gap along with the few done patterns a rule could start at
+    // and still reach them, so cascading rewrites are found without scanning everything again
+    std::vector<Pattern> buffer = std::move(m_patterns);
+    size_t gap_start = 0;
+    size_t gap_end = 0;
+    bool found_optimizations = false;
+
+    while (gap_end < buffer.size())
+    {
+        std::optional<std::pair<size_t, PeepholeMatch>> match = matcher.match(buffer, gap_end);
+        if (!match.has_value())
+        {
+            if (gap_start != gap_end)
             {
-            case PatternType::jesters_gambit:
-                // Double swap, do nothing
-                if (peek(1).has_value() && peek(1).value().type == PatternType::jesters_gambit)
-                {
-                    consume(2);
-                }
-                else
-                {
-                    no_opt();
-                }
-                break;
-            case PatternType::gemini_decomposition:
-                // Copying value that will be immediately erased, don't copy
-                if (peek(1).has_value() && peek(1).value().type == PatternType::bookkeepers_gambit && peek(1).value().value.value().back() == 'v')
-                {
-                    consume();
-                    // Remove last char
-                    std::string new_val = consume().value.value();
-                    new_val.pop_back();
-                    add_pattern(PatternType::bookkeepers_gambit, new_val);
-                }
-                else
-                {
-                    no_opt();
-                }
-                break;
-            case PatternType::fishermans_gambit_II:
-                // Copying value that will be immediately erased, don't copy
-                if (peek(1).has_value() && peek(1).value().type == PatternType::bookkeepers_gambit && peek(1).value().value.value().back() == 'v')
-                {
-                    consume();
-                    add_pattern(PatternType::fishermans_gambit);
-                    // Remove last char
-                    std::string new_val = consume().value.value();
-                    new_val.pop_back();
-                    add_pattern(PatternType::bookkeepers_gambit, new_val);
-                }
-                else
-                {
-                    no_opt();
-                }
-                break;
-            case PatternType::introspection:
-                // List of pattern lits
-                if (peek(1).has_value() && peek(1).value().type == PatternType::pattern_lit &&
-                    peek(2).has_value() && peek(2).value().type == PatternType::retrospection &&
-                    peek(3).has_value() && peek(3).value().type == PatternType::flocks_disintegration)
-                {
-                    // Keep looking for more pattern lits
-                    int num_patterns = 1;
-                    while (peek(4 * num_patterns + 0).has_value() && peek(4 * num_patterns + 0).value().type == PatternType::introspection &&
-                           peek(4 * num_patterns + 1).has_value() && peek(4 * num_patterns + 1).value().type == PatternType::pattern_lit &&
-                           peek(4 * num_patterns + 2).has_value() && peek(4 * num_patterns + 2).value().type == PatternType::retrospection &&
-                           peek(4 * num_patterns + 3).has_value() && peek(4 * num_patterns + 3).value().type == PatternType::flocks_disintegration)
-                    {
-                        ++num_patterns;
-                    }
-
-                    // Check for flocks gambit with correct number of patterns
-                    if (peek(4 * num_patterns + 0).has_value() && peek(4 * num_patterns + 0).value().type == PatternType::numerical_reflection &&
-                        peek(4 * num_patterns + 0).value().value.value() == std::to_string(num_patterns) &&
-                        peek(4 * num_patterns + 1).has_value() && peek(4 * num_patterns + 1).value().type == PatternType::flocks_gambit)
-                    {
-                        // build combined pattern list
-                        add_pattern(PatternType::introspection);
-                        for (int i = 0; i < num_patterns; ++i)
-                        {
-                            add_pattern(PatternType::pattern_lit, peek(4 * i + 1).value().value);
-                        }
-                        add_pattern(PatternType::retrospection);
-
-                        // Consume patterns
-                        consume(4 * num_patterns + 2);
-                    }
-                    else
-                    {
-                        no_opt();
-                    }
-                }
-                else
-                {
-                    no_opt();
-                }
-                break;
-            case PatternType::bookkeepers_gambit:
-                // Dud bookkeepers, do nothing
-                if (peek().value().value.value().find('v') == std::string::npos)
-                {
-                    consume();
-                }
-                // Double bookkeepers, combine them
-                else if (peek(1).has_value() && peek(1).value().type == PatternType::bookkeepers_gambit)
-                {
-                    // Grab values of both bookkeepers to combine
-                    std::string first_val = consume().value.value();
-                    std::string second_val = consume().value.value();
-
-                    // Loop over first value from left to right
-                    int second_ind = second_val.length() - 1;
-                    for (int i = first_val.length() - 1; i >= 0 && second_ind >= 0; --i)
-                    {
-                        // If first value has a -, replace with current char from second value
-                        if (first_val[i] == '-')
-                        {
-                            first_val[i] = second_val[second_ind];
-                            --second_ind;
-                        }
-                    }
-
-                    // If second val still has characters, make them the left side of the new val
-                    std::string new_val = second_val.substr(0, second_ind + 1) + first_val;
-                    add_pattern(PatternType::bookkeepers_gambit, new_val);
-                }
-                else
-                {
-                    no_opt();
-                }
-                break;
-            // Check for operators which output bools
-            case PatternType::equality_distillation:
-            case PatternType::inequality_distillation:
-            case PatternType::maximus_distillation:
-            case PatternType::maximus_distillation_II:
-            case PatternType::minimus_distillation:
-            case PatternType::minimus_distillation_II:
-            case PatternType::conjunction_distillation:
-            case PatternType::disjunction_distillation:
-                // Top of stack is already a bool, no need to purify
-                if (peek(1).has_value() && peek(1).value().type == PatternType::augurs_purification)
-                {
-                    add_pattern(consume());
-                    consume();
-                }
-                else
-                {
-                    no_opt();
-                }
-                break;
-            case PatternType::numerical_reflection:
-                // Fishing down by 2, rotate down instead
-                if (peek().value().value.value() == "-2" && peek(1).has_value() &&
-                    peek(1).value().type == PatternType::fishermans_gambit)
-                {
-                    consume(2);
-                    add_pattern(PatternType::rotation_gambit_II);
-                }
-                // Fishing down by 1, swap instead
-                else if (peek().value().value.value() == "-1" && peek(1).has_value() &&
-                    peek(1).value().type == PatternType::fishermans_gambit)
-                {
-                    consume(2);
-                    add_pattern(PatternType::jesters_gambit);
-                }
-                // Fishing up top element, do nothing
-                else if (peek().value().value.value() == "0" && peek(1).has_value() &&
-                    peek(1).value().type == PatternType::fishermans_gambit)
-                {
-                    consume(2);
-                }
-                // Fishing up copy of top element, dupe instead
-                else if (peek().value().value.value() == "0" && peek(1).has_value() &&
-                    peek(1).value().type == PatternType::fishermans_gambit_II)
-                {
-                    consume(2);
-                    add_pattern(PatternType::gemini_decomposition);
-                }
-                // Fishing up second-from-top element, swap instead
-                else if (peek().value().value.value() == "1" && peek(1).has_value() &&
-                    peek(1).value().type == PatternType::fishermans_gambit)
-                {
-                    consume(2);
-                    add_pattern(PatternType::jesters_gambit);
-                }
-                // Fishing up copy of second-from-top element, dupe instead
-                else if (peek().value().value.value() == "1" && peek(1).has_value() &&
-                    peek(1).value().type == PatternType::fishermans_gambit_II)
-                {
-                    consume(2);
-                    add_pattern(PatternType::prospectors_gambit);
-                }
-                // Fishing up copy of third-from-top element, rotate down
-                else if (peek().value().value.value() == "2" && peek(1).has_value() &&
-                    peek(1).value().type == PatternType::fishermans_gambit)
-                {
-                    consume(2);
-                    add_pattern(PatternType::rotation_gambit);
-                }
-                // Zero element flock's, vacant instead
-                else if (peek().value().value.value() == "0" && peek(1).has_value() &&
-                    peek(1).value().type == PatternType::flocks_gambit)
-                {
-                    consume(2);
-                    add_pattern(PatternType::vacant_reflection);
-                }
-                // Single element flock's, single's instead
-                else if (peek().value().value.value() == "1" && peek(1).has_value() &&
-                    peek(1).value().type == PatternType::flocks_gambit)
-                {
-                    consume(2);
-                    add_pattern(PatternType::singles_purification);
-                }
-                // Vector constant optimizations
-                else if (peek(1).has_value() && peek(1).value().type == PatternType::numerical_reflection &&
-                    peek(2).has_value() && peek(2).value().type == PatternType::numerical_reflection &&
-                    peek(3).has_value() && peek(3).value().type == PatternType::vector_exaltation &&
-                    is_valid_vector_constant(peek().value().value.value(), peek(1).value().value.value(), peek(2).value().value.value()))
-                {
-                    if (peek().value().value.value() != "0")
-                    {
-                        if (peek().value().value.value() == "1")
-                        {
-                            add_pattern(PatternType::vector_reflection_PX);
-                        }
-                        else
-                        {
-                            add_pattern(PatternType::vector_reflection_NX);
-                        }
-                    }
-                    else if (peek(1).value().value.value() != "0")
-                    {
-                        if (peek(1).value().value.value() == "1")
-                        {
-                            add_pattern(PatternType::vector_reflection_PY);
-                        }
-                        else
-                        {
-                            add_pattern(PatternType::vector_reflection_NY);
-                        }
-                    }
-                    else if (peek(2).value().value.value() != "0")
-                    {
-                        if (peek(2).value().value.value() == "1")
-                        {
-                            add_pattern(PatternType::vector_reflection_PZ);
-                        }
-                        else
-                        {
-                            add_pattern(PatternType::vector_reflection_NZ);
-                        }
-                    }
-                    else
-                    {
-                        add_pattern(PatternType::vector_reflection_zero);
-                    }
-
-                    consume(4);
-                }
-                // Compile-time math
-                else if (peek(1).has_value() && peek(1).value().type == PatternType::numerical_reflection &&
-                    peek(2).has_value() && is_non_division_binary_op(peek(2).value().type))
-                {
-                    float lhs = std::stof(consume().value.value());
-                    float rhs = std::stof(consume().value.value());
-
-                    float result;
-
-                    // Perform operation
-                    switch (consume().type)
-                    {
-                    case PatternType::additive_distillation:
-                        result = lhs + rhs;
-                        break;
-                    case PatternType::subtractive_distillation:
-                        result = lhs - rhs;
-                        break;
-                    case PatternType::multiplicative_distillation:
-                        result = lhs * rhs;
-                        break;
-                    }
-
-                    // Maintain lack of decimal place if possible
-                    if (result == (int)result)
-                    {
-                        add_pattern(PatternType::numerical_reflection, std::to_string((int)result));
-                    }
-                    else
-                    {
-                        add_pattern(PatternType::numerical_reflection, std::to_string(result));
-                    }
-                }
-                else
-                {
-                    no_opt();
-                }
-                break;
-            // No optimizations to be found, continue
-            default:
-                no_opt();
-                break;
+                buffer[gap_start] = std::move(buffer[gap_end]);
             }
+            ++gap_start;
+            ++gap_end;
+            continue;
+        }
+
+        std::vector<Pattern> replacement = peephole_rules()[match.value().first].replace(match.value().second);
+        gap_end += match.value().second.length;
 
-            found_optimizations = found_optimizations || !no_optimization;
+        // Make room if replacement is longer than the gap
+        if (replacement.size() > gap_end - gap_start)
+        {
+            size_t room = replacement.size() - (gap_end - gap_start);
+            buffer.insert(buffer.begin() + gap_end, room, Pattern());
+            gap_end += room;
         }
 
-        if (!found_optimizations)
+        gap_end -= replacement.size();
+        std::move(replacement.begin(), replacement.end(), buffer.begin() + gap_end);
+
+        // Step back over patterns a rule could start at and still reach what was replaced
+        for (size_t i = 1; i < matcher.longest_match() && gap_start > 0; ++i)
         {
-            return m_output;
+            --gap_start;
+            --gap_end;
+            if (gap_start != gap_end)
+            {
+                buffer[gap_end] = std::move(buffer[gap_start]);
+            }
         }
 
-        m_patterns = std::vector<Pattern>(m_output);
-        m_index = 0;
-        m_output.clear();
+        ++rule_hits[match.value().first];
+        found_optimizations = true;
     }
+
+    buffer.resize(gap_start);
+    m_output = std::move(buffer);
+    return found_optimizations;
 }
 
 void Optimizer::add_pattern(PatternType type, std::optional<std::string> value)
@@ -338,68 +101,324 @@ void Optimizer::add_pattern(Pattern pattern)
     m_output.push_back(pattern);
 }
 
-bool Optimizer::is_valid_vector_constant(std::string x, std::string y, std::string z)
-{
-    int num_zeros = (x == "0") + (y == "0") + (z == "0");
 
-    if (num_zeros >= 3)
+// Longest run of patterns tried as one shuffle
+static const size_t max_shuffle_length = 16;
+// Most iotas a shuffle can read before it's too deep to be worth following
+static const int max_shuffle_inputs = 9;
+
+// Depth given to fisherman's gambits, if it's an integer
+static std::optional<int> shuffle_depth(const std::string& num_lit)
+{
+    int depth;
+    std::from_chars_result result = std::from_chars(num_lit.data(), num_lit.data() + num_lit.size(), depth);
+    if (result.ec != std::errc() || result.ptr != num_lit.data() + num_lit.size())
     {
-        return true;
+        return {};
     }
+    return depth;
+}
 
-    if (num_zeros < 2)
+// Number of patterns in the stack shuffle starting at index, or 0 if one doesn't start there
+static size_t shuffle_length(const std::vector<Pattern>& patterns, size_t index)
+{
+    switch (patterns[index].type)
     {
-        return false;
-    }
+    case PatternType::jesters_gambit:
+    case PatternType::rotation_gambit:
+    case PatternType::rotation_gambit_II:
+    case PatternType::gemini_decomposition:
+    case PatternType::prospectors_gambit:
+    case PatternType::dioscuri_gambit:
+    case PatternType::bookkeepers_gambit:
+        return 1;
+    case PatternType::numerical_reflection:
+    {
+        if (index + 1 >= patterns.size())
+        {
+            return 0;
+        }
 
-    int num_ones = (x == "1") + (y == "1") + (z == "1");
+        PatternType next = patterns[index + 1].type;
+        std::optional<int> depth = shuffle_depth(patterns[index].value.value());
+        if (!depth.has_value() || (next != PatternType::fishermans_gambit && next != PatternType::fishermans_gambit_II))
+        {
+            return 0;
+        }
 
-    if (num_ones == 1)
-    {
-        return true;
+        // Fisherman's II moving a copy down isn't in the table
+        if (next == PatternType::fishermans_gambit_II && depth.value() < 0)
+        {
+            return 0;
+        }
+        return 2;
+    }
+    default:
+        return 0;
     }
+}
 
-    int num_neg_ones = (x == "-1") + (y == "-1") + (z == "-1");
+// Follows where the iotas on top of the stack go through a run of shuffles
+struct Shuffle {
+    // Iotas read so far, numbered from the top down in the order they were reached
+    int num_inputs = 0;
+    // Input held by each slot, bottom first
+    std::vector<int> stack;
 
-    if (num_neg_ones == 1)
+    // Reads more inputs from below until the slot at depth is tracked
+    void reach(size_t depth)
     {
-        return true;
+        while (depth >= stack.size())
+        {
+            stack.insert(stack.begin(), num_inputs++);
+        }
     }
 
-    return false;
-}
+    void apply(const std::vector<Pattern>& patterns, size_t index)
+    {
+        const Pattern& pattern = patterns[index];
 
-bool Optimizer::is_non_division_binary_op(PatternType type)
-{
-    switch (type)
+        switch (pattern.type)
+        {
+        case PatternType::jesters_gambit:
+            reach(1);
+            std::swap(stack[stack.size() - 1], stack[stack.size() - 2]);
+            break;
+        case PatternType::rotation_gambit:
+        {
+            reach(2);
+            int input = stack[stack.size() - 3];
+            stack.erase(stack.end() - 3);
+            stack.push_back(input);
+            break;
+        }
+        case PatternType::rotation_gambit_II:
+        {
+            reach(2);
+            int input = stack.back();
+            stack.pop_back();
+            stack.insert(stack.end() - 2, input);
+            break;
+        }
+        case PatternType::gemini_decomposition:
+            reach(0);
+            stack.push_back(stack.back());
+            break;
+        case PatternType::prospectors_gambit:
+            reach(1);
+            stack.push_back(stack[stack.size() - 2]);
+            break;
+        case PatternType::dioscuri_gambit:
+        {
+            reach(1);
+            int second = stack[stack.size() - 2];
+            int first = stack.back();
+            stack.push_back(second);
+            stack.push_back(first);
+            break;
+        }
+        case PatternType::bookkeepers_gambit:
+        {
+            const std::string& mask = pattern.value.value();
+            if (mask.empty())
+            {
+                break;
+            }
+            reach(mask.size() - 1);
+
+            std::vector<int> kept;
+            for (size_t i = 0; i < mask.size(); ++i)
+            {
+                if (mask[i] == '-')
+                {
+                    kept.push_back(stack[stack.size() - mask.size() + i]);
+                }
+            }
+
+            stack.erase(stack.end() - mask.size(), stack.end());
+            stack.insert(stack.end(), kept.begin(), kept.end());
+            break;
+        }
+        case PatternType::numerical_reflection:
+        {
+            int depth = shuffle_depth(pattern.value.value()).value();
+
+            if (patterns[index + 1].type == PatternType::fishermans_gambit_II)
+            {
+                reach(depth);
+                stack.push_back(stack[stack.size() - 1 - depth]);
+            }
+            else if (depth >= 0)
+            {
+                reach(depth);
+                int input = stack[stack.size() - 1 - depth];
+                stack.erase(stack.end() - 1 - depth);
+                stack.push_back(input);
+            }
+            else
+            {
+                // Moves the top iota down
+                reach(-depth);
+                int input = stack.back();
+                stack.pop_back();
+                stack.insert(stack.end() + depth, input);
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    // Patterns doing the same shuffle for the least patterns, if it's small enough to be in the table
+    std::optional<std::vector<Pattern>> cheapest() const
     {
-    case PatternType::additive_distillation:
-    case PatternType::subtractive_distillation:
-    case PatternType::multiplicative_distillation:
-        return true;
-        break;
-    default:
-        return false;
-        break;
+        // Number inputs like the table, where the deepest input is 0
+        std::vector<int> outputs;
+        for (int input : stack)
+        {
+            outputs.push_back(num_inputs - 1 - input);
+        }
+
+        // Inputs left where they are at the bottom don't need to be shuffled
+        int inputs = num_inputs;
+        while (inputs > 0 && !outputs.empty() && outputs[0] == 0 && std::count(outputs.begin(), outputs.end(), 0) == 1)
+        {
+            outputs.erase(outputs.begin());
+            for (int& output : outputs)
+            {
+                --output;
+            }
+            --inputs;
+        }
+
+        if (inputs == 0)
+        {
+            return std::vector<Pattern>();
+        }
+        if (inputs > shuffle_table_max_inputs || outputs.size() > shuffle_table_max_outputs)
+        {
+            return {};
+        }
+
+        // Build map from the table the first time it's needed
+        static const std::unordered_map<std::string, const char*> table = []() {
+            std::unordered_map<std::string, const char*> table;
+            for (const ShuffleTableEntry& entry : shuffle_table)
+            {
+                table[std::to_string(entry.num_inputs) + ":" + entry.outputs] = entry.patterns;
+            }
+            return table;
+        }();
+
+        std::string key = std::to_string(inputs) + ":";
+        for (int output : outputs)
+        {
+            key += std::to_string(output);
+        }
+
+        std::unordered_map<std::string, const char*>::const_iterator iter = table.find(key);
+        if (iter == table.end())
+        {
+            return {};
+        }
+
+        std::vector<Pattern> patterns;
+        std::istringstream codes(iter->second);
+        std::string code;
+        while (codes >> code)
+        {
+            switch (code[0])
+            {
+            case 'j':
+                patterns.push_back(Pattern{.type = PatternType::jesters_gambit, .value = {}});
+                break;
+            case 'r':
+                patterns.push_back(Pattern{.type = PatternType::rotation_gambit, .value = {}});
+                break;
+            case 'R':
+                patterns.push_back(Pattern{.type = PatternType::rotation_gambit_II, .value = {}});
+                break;
+            case 'g':
+                patterns.push_back(Pattern{.type = PatternType::gemini_decomposition, .value = {}});
+                break;
+            case 'p':
+                patterns.push_back(Pattern{.type = PatternType::prospectors_gambit, .value = {}});
+                break;
+            case 'd':
+                patterns.push_back(Pattern{.type = PatternType::dioscuri_gambit, .value = {}});
+                break;
+            case 'b':
+                patterns.push_back(Pattern{.type = PatternType::bookkeepers_gambit, .value = code.substr(1)});
+                break;
+            case 'f':
+                patterns.push_back(Pattern{.type = PatternType::numerical_reflection, .value = code.substr(1)});
+                patterns.push_back(Pattern{.type = PatternType::fishermans_gambit, .value = {}});
+                break;
+            case 'F':
+                patterns.push_back(Pattern{.type = PatternType::numerical_reflection, .value = code.substr(1)});
+                patterns.push_back(Pattern{.type = PatternType::fishermans_gambit_II, .value = {}});
+                break;
+            }
+        }
+        return patterns;
     }
-}
+};
 
-std::optional<Pattern> Optimizer::peek(int offset)
+bool Optimizer::optimize_shuffles()
 {
-    if (m_index + offset >= m_patterns.size())
+    std::vector<Pattern> patterns = std::move(m_output);
+    m_output.clear();
+    bool found_optimizations = false;
+
+    size_t index = 0;
+    while (index < patterns.size())
     {
-        return {};
-    }
+        // Escaped pattern is pushed rather than ran
+        if (patterns[index].type == PatternType::consideration)
+        {
+            add_pattern(patterns[index++]);
+            if (index < patterns.size())
+            {
+                add_pattern(patterns[index++]);
+            }
+            continue;
+        }
 
-    return m_patterns.at(m_index + offset);
-}
+        // Find the run of shuffles starting here that can be drawn with the most patterns saved
+        Shuffle shuffle;
+        size_t end = index;
+        size_t best_end = index;
+        size_t best_saved = 0;
+        std::vector<Pattern> best_patterns;
+        while (end < patterns.size() && end - index < max_shuffle_length && shuffle_length(patterns, end) != 0)
+        {
+            shuffle.apply(patterns, end);
+            end += shuffle_length(patterns, end);
+            if (shuffle.num_inputs > max_shuffle_inputs)
+            {
+                break;
+            }
 
-Pattern Optimizer::consume()
-{
-    return m_patterns.at(m_index++);
-}
+            std::optional<std::vector<Pattern>> cheapest = shuffle.cheapest();
+            if (cheapest.has_value() && cheapest.value().size() + best_saved < end - index)
+            {
+                best_saved = end - index - cheapest.value().size();
+                best_end = end;
+                best_patterns = cheapest.value();
+            }
+        }
 
-void Optimizer::consume(int amount)
-{
-    m_index += amount;
+        if (best_saved == 0)
+        {
+            add_pattern(patterns[index++]);
+            continue;
+        }
+
+        m_output.insert(m_output.end(), best_patterns.begin(), best_patterns.end());
+        index = best_end;
+        found_optimizations = true;
+    }
+
+    return found_optimizations;
 }
\ No newline at end of file
@@ -5,25 +5,26 @@
 #include <vector>
 
 #include "generation.hpp"
+#include "peephole.hpp"
 
 class Optimizer {
 public:
     Optimizer (std::vector<Pattern> patterns);
 
     std::vector<Pattern> optimize();
+
+    // Number of times each rule in peephole_rules() was used
+    std::vector<size_t> rule_hits;
 private:
     std::vector<Pattern> m_output = std::vector<Pattern>();
     std::vector<Pattern> m_patterns;
-    size_t m_index = 0;
 
     void add_pattern(PatternType type, std::optional<std::string> value = {});
     void add_pattern(Pattern pattern);
 
-    bool is_valid_vector_constant(std::string x, std::string y, std::string z);
-    // Currently only supports num ops
-    bool is_non_division_binary_op(PatternType type);
+    // Runs every peephole rule over the patterns once, returns whether any were used
+    bool peephole_pass(const PeepholeMatcher& matcher);
 
-    std::optional<Pattern> peek(int offset = 0);
-    Pattern consume();
-    void consume(int amount);
+    // Replaces runs of stack shuffles in output with the cheapest patterns doing the same, returns whether any were found
+    bool optimize_shuffles();
 };
\ No newline at end of file
@@ -323,6 +323,38 @@ std::optional<NodeExpr*> Parser::parse_expr(int min_prec, NodeTerm* first_term)
         // Consume operator
         consume();
 
+        // Ternary's then expression can be anything, and its else expression can be another ternary
+        if (op_type == TokenType_::question)
+        {
+            std::optional<NodeExpr*> then_expr = parse_expr();
+            if (!then_expr.has_value())
+            {
+                compilation_error("Expected expression", peek(-1).has_value() ? peek(-1).value().line : 1);
+            }
+
+            try_consume(TokenType_::colon, ':');
+
+            std::optional<NodeExpr*> else_expr = parse_expr(prec);
+            if (!else_expr.has_value())
+            {
+                compilation_error("Expected expression", peek(-1).has_value() ? peek(-1).value().line : 1);
+            }
+
+            NodeTermTernary* term_ternary = m_allocator.alloc<NodeTermTernary>();
+            term_ternary->expr = lhs_expr;
+            term_ternary->then_expr = then_expr.value();
+            term_ternary->else_expr = else_expr.value();
+            term_ternary->line = line;
+            NodeTerm* term = m_allocator.alloc<NodeTerm>();
+            term->var = term_ternary;
+            term->line = line;
+
+            lhs_expr = m_allocator.alloc<NodeExpr>();
+            lhs_expr->var = term;
+            lhs_expr->line = line;
+            continue;
+        }
+
         int next_min_prec = prec + 1;
         std::optional<NodeExpr*> rhs_expr = parse_expr(next_min_prec);
         if (!rhs_expr.has_value())
@@ -441,15 +473,15 @@ std::optional<NodeStmt*> Parser::parse_stmt()
             stmt->line = line;
             return stmt;
         }
-        // Check if var
+        // Check if var or constant
         else if (
-            peek().value().type == TokenType_::let && peek(1).has_value() &&
+            (peek().value().type == TokenType_::let || peek().value().type == TokenType_::const_) && peek(1).has_value() &&
             peek(1).value().type == TokenType_::ident &&
             peek(2).has_value() && peek(2).value().type == TokenType_::eq)
         {
             // Consume sarting tokens and grab ident
-            consume();
             NodeStmtLet* stmt_let = m_allocator.alloc<NodeStmtLet>();
+            stmt_let->is_const = consume().type == TokenType_::const_;
             stmt_let->ident = consume();
             stmt_let->line = line;
             consume();
@@ -552,6 +584,49 @@ std::optional<NodeStmt*> Parser::parse_stmt()
                 compilation_error("Expected expression", peek(-1).has_value() ? peek(-1).value().line : 1);
             }
         }
+        // Check if for
+        else if (
+            peek().value().type == TokenType_::for_ && peek(1).has_value() &&
+            peek(1).value().type == TokenType_::paren_open && peek(2).has_value() &&
+            peek(2).value().type == TokenType_::ident)
+        {
+            consume(2);
+            Token ident = consume();
+            try_consume(TokenType_::colon, ':');
+
+            if (std::optional<NodeExpr*> expr = parse_expr())
+            {
+                try_consume(TokenType_::paren_close, ')');
+
+                if (std::optional<NodeStmt*> for_stmt = parse_stmt())
+                {
+                    NodeStmtFor* stmt_for = m_allocator.alloc<NodeStmtFor>();
+                    stmt_for->ident = ident;
+                    stmt_for->expr = expr.value();
+                    stmt_for->stmt = for_stmt.value();
+                    stmt_for->line = line;
+                    NodeStmt* stmt = m_allocator.alloc<NodeStmt>();
+                    stmt->var = stmt_for;
+                    stmt->line = line;
+                    return stmt;
+                }
+                else
+                {
+                    compilation_error("Expected statement", peek(-1).has_value() ? peek(-1).value().line : 1);
+                }
+            }
+            else
+            {
+                compilation_error("Expected expression", peek(-1).has_value() ? peek(-1).value().line : 1);
+            }
+        }
+        // Check if switch
+        else if (
+            peek().value().type == TokenType_::switch_ && peek(1).has_value() &&
+            peek(1).value().type == TokenType_::paren_open)
+        {
+            return parse_switch(line);
+        }
         // Check if scope
         else if (std::optional<NodeScope*> scope = parse_scope())
         {
@@ -565,6 +640,136 @@ std::optional<NodeStmt*> Parser::parse_stmt()
     return {};
 }
 
+NodeStmt* Parser::parse_switch(size_t line)
+{
+    consume(2);
+
+    std::optional<NodeExpr*> expr = parse_expr();
+    if (!expr.has_value())
+    {
+        compilation_error("Expected expression", peek(-1).has_value() ? peek(-1).value().line : 1);
+    }
+    try_consume(TokenType_::paren_close, ')');
+    try_consume(TokenType_::curly_open, '{');
+
+    // Each case runs the statements up to the next one, it doesn't fall through
+    std::vector<std::pair<NodeExpr*, NodeStmt*>> cases;
+    NodeStmt* default_stmt = nullptr;
+    while (peek().has_value() && (peek().value().type == TokenType_::case_ || peek().value().type == TokenType_::default_))
+    {
+        Token keyword = consume();
+
+        NodeExpr* value = nullptr;
+        if (keyword.type == TokenType_::case_)
+        {
+            std::optional<NodeExpr*> case_expr = parse_expr();
+            if (!case_expr.has_value())
+            {
+                compilation_error("Expected expression", peek(-1).has_value() ? peek(-1).value().line : 1);
+            }
+            value = case_expr.value();
+        }
+        else if (default_stmt != nullptr)
+        {
+            compilation_error("Switch can only have one default", keyword.line);
+        }
+        try_consume(TokenType_::colon, ':');
+
+        NodeScope* case_scope = m_allocator.alloc<NodeScope>();
+        case_scope->line = keyword.line;
+        while (std::optional<NodeStmt*> stmt = parse_stmt())
+        {
+            case_scope->stmts.push_back(stmt.value());
+        }
+        NodeStmt* case_stmt = m_allocator.alloc<NodeStmt>();
+        case_stmt->var = case_scope;
+        case_stmt->line = keyword.line;
+
+        if (value != nullptr)
+        {
+            cases.emplace_back(value, case_stmt);
+        }
+        else
+        {
+            default_stmt = case_stmt;
+        }
+    }
+
+    try_consume(TokenType_::curly_close, '}');
+
+    // Becomes a scope comparing the value with each case in order, through a hidden local unless it's already a
+    // variable. The generator dispatches long chains like this with a jump table
+    NodeScope* switch_scope = m_allocator.alloc<NodeScope>();
+    switch_scope->line = line;
+
+    Token ident;
+    const NodeTerm* term = std::holds_alternative<NodeTerm*>(expr.value()->var) ? std::get<NodeTerm*>(expr.value()->var) : nullptr;
+    if (term != nullptr && std::holds_alternative<NodeTermVar*>(term->var) &&
+        std::holds_alternative<NodeVarIdent*>(std::get<NodeTermVar*>(term->var)->var))
+    {
+        ident = std::get<NodeVarIdent*>(std::get<NodeTermVar*>(term->var)->var)->ident;
+    }
+    else
+    {
+        ident = Token{.type = TokenType_::ident, .value = "switch value " + std::to_string(m_num_switches++), .line = line};
+
+        NodeStmtLet* stmt_let = m_allocator.alloc<NodeStmtLet>();
+        stmt_let->ident = ident;
+        stmt_let->expr = expr.value();
+        stmt_let->line = line;
+        NodeStmt* stmt = m_allocator.alloc<NodeStmt>();
+        stmt->var = stmt_let;
+        stmt->line = line;
+        switch_scope->stmts.push_back(stmt);
+    }
+
+    NodeStmt* chain = default_stmt;
+    for (size_t i = cases.size(); i-- > 0;)
+    {
+        NodeVarIdent* var_ident = m_allocator.alloc<NodeVarIdent>();
+        var_ident->ident = ident;
+        var_ident->line = cases[i].first->line;
+        NodeTermVar* term_var = m_allocator.alloc<NodeTermVar>();
+        term_var->var = var_ident;
+        term_var->line = cases[i].first->line;
+        NodeTerm* var_term = m_allocator.alloc<NodeTerm>();
+        var_term->var = term_var;
+        var_term->line = cases[i].first->line;
+        NodeExpr* var_expr = m_allocator.alloc<NodeExpr>();
+        var_expr->var = var_term;
+        var_expr->line = cases[i].first->line;
+
+        NodeExprBin* comparison = m_allocator.alloc<NodeExprBin>();
+        comparison->op_type = TokenType_::double_eq;
+        comparison->lhs = var_expr;
+        comparison->rhs = cases[i].first;
+        comparison->line = cases[i].first->line;
+        NodeExpr* condition = m_allocator.alloc<NodeExpr>();
+        condition->var = comparison;
+        condition->line = cases[i].first->line;
+
+        NodeStmtIf* stmt_if = m_allocator.alloc<NodeStmtIf>();
+        stmt_if->expr = condition;
+        stmt_if->stmt = cases[i].second;
+        stmt_if->else_stmt = chain;
+        stmt_if->is_switch_case = true;
+        stmt_if->line = cases[i].second->line;
+        chain = m_allocator.alloc<NodeStmt>();
+        chain->var = stmt_if;
+        chain->line = stmt_if->line;
+    }
+
+    if (chain != nullptr)
+    {
+        switch_scope->stmts.push_back(chain);
+    }
+
+    NodeStmt* stmt = m_allocator.alloc<NodeStmt>();
+    stmt->var = switch_scope;
+    stmt->line = line;
+    return stmt;
+}
+
 std::optional<NodeFunctionDef*> Parser::parse_func_def()
 {
     // Return if no more tokens
@@ -675,14 +880,14 @@ std::optional<NodeProg*> Parser::parse_prog()
     {
         size_t line = peek().value().line;
 
-        // Check if global var
-        if (peek().value().type == TokenType_::let && peek(1).has_value() &&
+        // Check if global var or constant
+        if ((peek().value().type == TokenType_::let || peek().value().type == TokenType_::const_) && peek(1).has_value() &&
             peek(1).value().type == TokenType_::ident &&
             peek(2).has_value() && peek(2).value().type == TokenType_::eq)
         {
             // Consume sarting tokens and grab ident
-            consume();
             NodeGlobalLet* global_let = m_allocator.alloc<NodeGlobalLet>();
+            global_let->is_const = consume().type == TokenType_::const_;
             global_let->ident = consume();
             global_let->line = line;
             consume();
@@ -62,6 +62,13 @@ struct NodeTermParen : Node {
     NodeExpr* expr;
 };
 
+// Condition ? then expression : else expression
+struct NodeTermTernary : Node {
+    NodeExpr* expr;
+    NodeExpr* then_expr;
+    NodeExpr* else_expr;
+};
+
 struct NodeTermBoolLit : Node {
     Token bool_;
 };
@@ -70,7 +77,7 @@ struct NodeTermNullLit : Node {
 };
 
 struct NodeTerm : Node {
-    std::variant<NodeTermUn*, NodeTermUnPost*, NodeTermNumLit*, NodeTermListLit*, NodeTermPatternLit*, NodeTermBoolLit*, NodeTermNullLit*, NodeTermVar*, NodeTermParen*, NodeTermCallFunc*> var;
+    std::variant<NodeTermUn*, NodeTermUnPost*, NodeTermNumLit*, NodeTermListLit*, NodeTermPatternLit*, NodeTermBoolLit*, NodeTermNullLit*, NodeTermVar*, NodeTermParen*, NodeTermCallFunc*, NodeTermTernary*> var;
 };
 
 struct NodeExprBin : Node {
@@ -83,9 +90,11 @@ struct NodeExpr : Node {
     std::variant<NodeTerm*, NodeExprBin*> var;
 };
 
+// Constants are declared with const instead of let, and are replaced by their value where they're used
 struct NodeStmtLet : Node {
     Token ident;
     NodeExpr* expr;
+    bool is_const = false;
 };
 
 struct NodeScope : Node {
@@ -96,6 +105,8 @@ struct NodeStmtIf : Node {
     NodeExpr* expr;
     NodeStmt* stmt;
     NodeStmt* else_stmt;
+    // Set on the ifs a switch becomes, which compare the switch's value with a case's value
+    bool is_switch_case = false;
 };
 
 struct NodeStmtWhile : Node {
@@ -103,6 +114,13 @@ struct NodeStmtWhile : Node {
     NodeStmt* stmt;
 };
 
+// for (ident : expr) stmt, runs statement with ident set to each element of the list
+struct NodeStmtFor : Node {
+    Token ident;
+    NodeExpr* expr;
+    NodeStmt* stmt;
+};
+
 struct NodeStmtCallFunction : Node {
     NodeDefinedFunc* func;
 };
@@ -112,12 +130,13 @@ struct NodeStmtReturn : Node {
 };
 
 struct NodeStmt : Node {
-    std::variant<NodeStmtCallFunction*, NodeStmtReturn*, NodeExpr*, NodeStmtLet*, NodeStmtIf*, NodeStmtWhile*, NodeScope*> var;
+    std::variant<NodeStmtCallFunction*, NodeStmtReturn*, NodeExpr*, NodeStmtLet*, NodeStmtIf*, NodeStmtWhile*, NodeStmtFor*, NodeScope*> var;
 };
 
 struct NodeGlobalLet : Node {
     Token ident;
     NodeExpr* expr;
+    bool is_const = false;
 };
 
 struct NodeFunctionDefVoid : Node {
@@ -154,6 +173,7 @@ private:
     std::optional<NodeExpr*> parse_expr(int min_prec = 0, NodeTerm* first_term = nullptr);
     std::optional<NodeScope*> parse_scope();
     std::optional<NodeStmt*> parse_stmt();
+    NodeStmt* parse_switch(size_t line);
     std::optional<NodeFunctionDef*> parse_func_def();
     std::optional<NodeProg*> parse_prog();
 
@@ -166,4 +186,7 @@ private:
     const std::vector<Token> m_tokens;
     size_t m_index = 0;
     ArenaAllocator m_allocator;
+
+    // Used to name the hidden local each switch compares
+    size_t m_num_switches = 0;
 };
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include "peephole.hpp"
+
+#include <algorithm>
+
+#include "constant.hpp"
+
+const Pattern& PeepholeMatch::operator[](size_t offset) const
+{
+    return (*patterns)[start + offset];
+}
+
+bool PeepholeMatch::has(size_t offset, PatternType type) const
+{
+    return start + offset < patterns->size() && (*this)[offset].type == type;
+}
+
+static Pattern make_pattern(PatternType type, std::optional<std::string> value = {})
+{
+    return Pattern{.type = type, .value = value};
+}
+
+// Whether the bookkeeper's removes the top iota
+static bool pops_top(const Pattern& bookkeepers)
+{
+    return !bookkeepers.value.value().empty() && bookkeepers.value.value().back() == 'v';
+}
+
+// Whether number literal is an integer written without a fraction, like the depths given to fisherman's gambits
+static bool is_int_lit(const std::string& num_lit)
+{
+    size_t digits_start = !num_lit.empty() && num_lit[0] == '-' ? 1 : 0;
+    return num_lit.size() > digits_start && num_lit.find_first_not_of("0123456789", digits_start) == std::string::npos;
+}
+
+static std::string without_last(std::string mask)
+{
+    mask.pop_back();
+    return mask;
+}
+
+// Rule replacing a number and the pattern after it that uses it, when the number is num_lit
+static PeepholeRule num_rule(std::string name, std::string num_lit, PatternType type, std::vector<PatternType> replacement)
+{
+    return PeepholeRule{
+        .name = name,
+        .types = {{PatternType::numerical_reflection}, {type}},
+        .guard = [num_lit](PeepholeMatch& match) { return match[0].value.value() == num_lit; },
+        .replace = [replacement](const PeepholeMatch&) {
+            std::vector<Pattern> patterns;
+            for (PatternType type : replacement)
+            {
+                patterns.push_back(make_pattern(type));
+            }
+            return patterns;
+        },
+    };
+}
+
+// Vector reflection pushing the vector, if there is one
+static std::optional<PatternType> vector_constant(const std::string& x, const std::string& y, const std::string& z)
+{
+    int num_zeros = (x == "0") + (y == "0") + (z == "0");
+
+    if (num_zeros >= 3)
+    {
+        return PatternType::vector_reflection_zero;
+    }
+
+    if (num_zeros < 2)
+    {
+        return {};
+    }
+
+    if (x != "0")
+    {
+        return x == "1" ? PatternType::vector_reflection_PX : x == "-1" ? std::optional(PatternType::vector_reflection_NX) : std::nullopt;
+    }
+    if (y != "0")
+    {
+        return y == "1" ? PatternType::vector_reflection_PY : y == "-1" ? std::optional(PatternType::vector_reflection_NY) : std::nullopt;
+    }
+    return z == "1" ? PatternType::vector_reflection_PZ : z == "-1" ? std::optional(PatternType::vector_reflection_NZ) : std::nullopt;
+}
+
+// Result of doing a binary op on two numerical reflections, if it can be drawn exactly
+static std::optional<std::string> fold_num_patterns(const Pattern& lhs, const Pattern& rhs, const Pattern& op)
+{
+    std::optional<Constant> lhs_num = const_from_num_lit(lhs.value.value());
+    std::optional<Constant> rhs_num = const_from_num_lit(rhs.value.value());
+    if (!lhs_num.has_value() || !rhs_num.has_value())
+    {
+        return {};
+    }
+
+    TokenType_ op_type;
+    switch (op.type)
+    {
+    case PatternType::additive_distillation:
+        op_type = TokenType_::plus;
+        break;
+    case PatternType::subtractive_distillation:
+        op_type = TokenType_::dash;
+        break;
+    case PatternType::multiplicative_distillation:
+        op_type = TokenType_::star;
+        break;
+    default:
+        return {};
+    }
+
+    // Results too long for the number encoder to draw exactly aren't folded, same as in the AST
+    std::optional<Constant> result = fold_bin_op(op_type, lhs_num.value(), rhs_num.value());
+    if (!result.has_value() || !is_drawable_num(std::get<double>(result.value().var)))
+    {
+        return {};
+    }
+
+    return num_to_string(std::get<double>(result.value().var));
+}
+
+// Number of single pattern literals pushed in a row starting at offset
+static size_t num_pattern_lits(const PeepholeMatch& match, size_t offset)
+{
+    size_t num_patterns = 0;
+    while (match.has(offset + 4 * num_patterns + 0, PatternType::introspection) &&
+           match.has(offset + 4 * num_patterns + 1, PatternType::pattern_lit) &&
+           match.has(offset + 4 * num_patterns + 2, PatternType::retrospection) &&
+           match.has(offset + 4 * num_patterns + 3, PatternType::flocks_disintegration))
+    {
+        ++num_patterns;
+    }
+    return num_patterns;
+}
+
+const std::vector<PeepholeRule>& peephole_rules()
+{
+    static const std::vector<PeepholeRule> rules = {
+        // Double swap, do nothing
+        {
+            .name = "double jester's",
+            .types = {{PatternType::jesters_gambit}, {PatternType::jesters_gambit}},
+            .guard = {},
+            .replace = [](const PeepholeMatch&) { return std::vector<Pattern>(); },
+        },
+        // Copying value that will be immediately erased, don't copy
+        {
+            .name = "gemini then pop",
+            .types = {{PatternType::gemini_decomposition}, {PatternType::bookkeepers_gambit}},
+            .guard = [](PeepholeMatch& match) { return pops_top(match[1]); },
+            .replace = [](const PeepholeMatch& match) {
+                return std::vector<Pattern>{make_pattern(PatternType::bookkeepers_gambit, without_last(match[1].value.value()))};
+            },
+        },
+        // Copying a value up to the top that will be immediately erased, don't copy. Copying the top down under others
+        // and erasing the top just moves it down
+        {
+            .name = "fisherman's II then pop",
+            .types = {{PatternType::numerical_reflection}, {PatternType::fishermans_gambit_II}, {PatternType::bookkeepers_gambit}},
+            .guard = [](PeepholeMatch& match) { return is_int_lit(match[0].value.value()) && pops_top(match[2]); },
+            .replace = [](const PeepholeMatch& match) {
+                Pattern pop = make_pattern(PatternType::bookkeepers_gambit, without_last(match[2].value.value()));
+                if (match[0].value.value()[0] != '-')
+                {
+                    return std::vector<Pattern>{pop};
+                }
+                return std::vector<Pattern>{match[0], make_pattern(PatternType::fishermans_gambit), pop};
+            },
+        },
+        // List of pattern lits, build it as one list
+        {
+            .name = "list of pattern literals",
+            .types = {{PatternType::introspection}, {PatternType::pattern_lit}, {PatternType::retrospection}, {PatternType::flocks_disintegration}},
+            .guard = [](PeepholeMatch& match) {
+                // Check for flocks gambit with correct number of patterns
+                size_t num_patterns = 1 + num_pattern_lits(match, 4);
+                if (!match.has(4 * num_patterns + 0, PatternType::numerical_reflection) ||
+                    match[4 * num_patterns].value.value() != std::to_string(num_patterns) ||
+                    !match.has(4 * num_patterns + 1, PatternType::flocks_gambit))
+                {
+                    return false;
+                }
+
+                match.length = 4 * num_patterns + 2;
+                return true;
+            },
+            .replace = [](const PeepholeMatch& match) {
+                std::vector<Pattern> patterns = {make_pattern(PatternType::introspection)};
+                for (size_t i = 0; i + 2 < match.length; i += 4)
+                {
+                    patterns.push_back(make_pattern(PatternType::pattern_lit, match[i + 1].value));
+                }
+                patterns.push_back(make_pattern(PatternType::retrospection));
+                return patterns;
+            },
+        },
+        // Dud bookkeepers, do nothing
+        {
+            .name = "dud bookkeeper's",
+            .types = {{PatternType::bookkeepers_gambit}},
+            .guard = [](PeepholeMatch& match) { return match[0].value.value().find('v') == std::string::npos; },
+            .replace = [](const PeepholeMatch&) { return std::vector<Pattern>(); },
+        },
+        // Double bookkeepers, combine them
+        {
+            .name = "double bookkeeper's",
+            .types = {{PatternType::bookkeepers_gambit}, {PatternType::bookkeepers_gambit}},
+            .guard = {},
+            .replace = [](const PeepholeMatch& match) {
+                // Grab values of both bookkeepers to combine
+                std::string first_val = match[0].value.value();
+                std::string second_val = match[1].value.value();
+
+                // Loop over first value from left to right
+                int second_ind = second_val.length() - 1;
+                for (int i = first_val.length() - 1; i >= 0 && second_ind >= 0; --i)
+                {
+                    // If first value has a -, replace with current char from second value
+                    if (first_val[i] == '-')
+                    {
+                        first_val[i] = second_val[second_ind];
+                        --second_ind;
+                    }
+                }
+
+                // If second val still has characters, make them the left side of the new val
+                std::string new_val = second_val.substr(0, second_ind + 1) + first_val;
+                return std::vector<Pattern>{make_pattern(PatternType::bookkeepers_gambit, new_val)};
+            },
+        },
+        // Top of stack is already a bool, no need to purify
+        {
+            .name = "augur's after bool",
+            .types = {
+                {
+                    PatternType::equality_distillation,
+                    PatternType::inequality_distillation,
+                    PatternType::maximus_distillation,
+                    PatternType::maximus_distillation_II,
+                    PatternType::minimus_distillation,
+                    PatternType::minimus_distillation_II,
+                    PatternType::conjunction_distillation,
+                    PatternType::disjunction_distillation,
+                },
+                {PatternType::augurs_purification},
+            },
+            .guard = {},
+            .replace = [](const PeepholeMatch& match) { return std::vector<Pattern>{match[0]}; },
+        },
+        // Fishing down by 2, rotate down instead
+        num_rule("fisherman's -2", "-2", PatternType::fishermans_gambit, {PatternType::rotation_gambit_II}),
+        // Fishing down by 1, swap instead
+        num_rule("fisherman's -1", "-1", PatternType::fishermans_gambit, {PatternType::jesters_gambit}),
+        // Fishing up top element, do nothing
+        num_rule("fisherman's 0", "0", PatternType::fishermans_gambit, {}),
+        // Fishing up copy of top element, dupe instead
+        num_rule("fisherman's II 0", "0", PatternType::fishermans_gambit_II, {PatternType::gemini_decomposition}),
+        // Fishing up second-from-top element, swap instead
+        num_rule("fisherman's 1", "1", PatternType::fishermans_gambit, {PatternType::jesters_gambit}),
+        // Fishing up copy of second-from-top element, dupe instead
+        num_rule("fisherman's II 1", "1", PatternType::fishermans_gambit_II, {PatternType::prospectors_gambit}),
+        // Fishing up copy of third-from-top element, rotate down
+        num_rule("fisherman's 2", "2", PatternType::fishermans_gambit, {PatternType::rotation_gambit}),
+        // Zero element flock's, vacant instead
+        num_rule("flock's 0", "0", PatternType::flocks_gambit, {PatternType::vacant_reflection}),
+        // Single element flock's, single's instead
+        num_rule("flock's 1", "1", PatternType::flocks_gambit, {PatternType::singles_purification}),
+        // Vector constant optimizations
+        {
+            .name = "vector constant",
+            .types = {{PatternType::numerical_reflection}, {PatternType::numerical_reflection}, {PatternType::numerical_reflection}, {PatternType::vector_exaltation}},
+            .guard = [](PeepholeMatch& match) {
+                return vector_constant(match[0].value.value(), match[1].value.value(), match[2].value.value()).has_value();
+            },
+            .replace = [](const PeepholeMatch& match) {
+                return std::vector<Pattern>{make_pattern(vector_constant(match[0].value.value(), match[1].value.value(), match[2].value.value()).value())};
+            },
+        },
+        // Compile-time math
+        {
+            .name = "number math",
+            .types = {
+                {PatternType::numerical_reflection},
+                {PatternType::numerical_reflection},
+                {PatternType::additive_distillation, PatternType::subtractive_distillation, PatternType::multiplicative_distillation},
+            },
+            .guard = [](PeepholeMatch& match) { return fold_num_patterns(match[0], match[1], match[2]).has_value(); },
+            .replace = [](const PeepholeMatch& match) {
+                return std::vector<Pattern>{make_pattern(PatternType::numerical_reflection, fold_num_patterns(match[0], match[1], match[2]).value())};
+            },
+        },
+    };
+
+    return rules;
+}
+
+PeepholeMatcher::PeepholeMatcher(const std::vector<PeepholeRule>& rules)
+    :m_rules(rules), m_nodes(1)
+{
+    for (size_t rule = 0; rule < m_rules.size(); ++rule)
+    {
+        // Nodes reached so far, one for each way of picking from the alternative types
+        std::vector<size_t> nodes = {0};
+        for (const std::vector<PatternType>& alternatives : m_rules[rule].types)
+        {
+            std::vector<size_t> next_nodes;
+            for (size_t node : nodes)
+            {
+                for (PatternType type : alternatives)
+                {
+                    std::map<PatternType, size_t>::iterator child = m_nodes[node].children.find(type);
+                    if (child == m_nodes[node].children.end())
+                    {
+                        child = m_nodes[node].children.insert({type, m_nodes.size()}).first;
+                        m_nodes.push_back(Node());
+                    }
+                    next_nodes.push_back(child->second);
+                }
+            }
+            nodes = next_nodes;
+        }
+
+        for (size_t node : nodes)
+        {
+            m_nodes[node].rules.push_back(rule);
+        }
+        m_longest_match = std::max(m_longest_match, m_rules[rule].types.size());
+    }
+}
+
+std::optional<std::pair<size_t, PeepholeMatch>> PeepholeMatcher::match(const std::vector<Pattern>& patterns, size_t start) const
+{
+    // Find every rule whose types match, only as deep as the longest rule
+    std::vector<size_t> matched_rules;
+    size_t node = 0;
+    for (size_t i = start; i < patterns.size(); ++i)
+    {
+        std::map<PatternType, size_t>::const_iterator child = m_nodes[node].children.find(patterns[i].type);
+        if (child == m_nodes[node].children.end())
+        {
+            break;
+        }
+
+        node = child->second;
+        matched_rules.insert(matched_rules.end(), m_nodes[node].rules.begin(), m_nodes[node].rules.end());
+    }
+
+    std::sort(matched_rules.begin(), matched_rules.end());
+    for (size_t rule : matched_rules)
+    {
+        PeepholeMatch match = {.patterns = &patterns, .start = start, .length = m_rules[rule].types.size()};
+        if (!m_rules[rule].guard || m_rules[rule].guard(match))
+        {
+            return std::make_pair(rule, match);
+        }
+    }
+
+    return {};
+}
+
+size_t PeepholeMatcher::longest_match() const
+{
+    return m_longest_match;
+}
\ No newline at end of file
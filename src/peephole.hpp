@@ -0,0 +1,56 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "generation.hpp"
+
+// Patterns matched by a peephole rule
+struct PeepholeMatch {
+    const std::vector<Pattern>* patterns;
+    size_t start;
+    // Number of patterns matched, guards can add to this to match past the rule's types
+    size_t length;
+
+    const Pattern& operator[](size_t offset) const;
+    // Whether there's a pattern of type at offset from the start
+    bool has(size_t offset, PatternType type) const;
+};
+
+// Replaces patterns of the given types with cheaper ones doing the same thing
+struct PeepholeRule {
+    std::string name;
+    // Types of the patterns to match in order, where any one of the types given for a pattern matches
+    std::vector<std::vector<PatternType>> types;
+    // Checks values of the matched patterns, empty if matching types is enough
+    std::function<bool(PeepholeMatch&)> guard;
+    std::function<std::vector<Pattern>(const PeepholeMatch&)> replace;
+};
+
+// Every peephole rule, where earlier rules are used first if more than one matches
+const std::vector<PeepholeRule>& peephole_rules();
+
+// Matches every rule at once by walking a trie of the rules' types
+class PeepholeMatcher {
+public:
+    PeepholeMatcher(const std::vector<PeepholeRule>& rules);
+
+    // Index of the first rule matching patterns at start, and what it matched
+    std::optional<std::pair<size_t, PeepholeMatch>> match(const std::vector<Pattern>& patterns, size_t start) const;
+    // Most pattern types any rule matches, not counting what guards add
+    size_t longest_match() const;
+private:
+    struct Node {
+        std::map<PatternType, size_t> children;
+        // Rules whose types end at this node
+        std::vector<size_t> rules;
+    };
+
+    const std::vector<PeepholeRule>& m_rules;
+    std::vector<Node> m_nodes;
+    size_t m_longest_match = 0;
+};
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "profile.hpp"
+
+#include <charconv>
+#include <fstream>
+#include <sstream>
+
+#include "util.hpp"
+
+Profile::Profile(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.good())
+    {
+        compilation_error("Couldn't open profile \"" + path + "\"", 0);
+    }
+
+    std::string text;
+    for (size_t profile_line = 1; std::getline(file, text); ++profile_line)
+    {
+        text = text.substr(0, text.find("//"));
+
+        std::istringstream entry(text);
+        std::string kind;
+        if (!(entry >> kind))
+        {
+            continue;
+        }
+
+        std::string key;
+        long long count;
+        std::string extra;
+        bool is_valid = (kind == "line" || kind == "func") && (entry >> key >> count) && !(entry >> extra) && count >= 0;
+        // Line numbers too big to be stored are invalid too
+        size_t line = 0;
+        if (is_valid && kind == "line")
+        {
+            std::from_chars_result result = std::from_chars(key.data(), key.data() + key.size(), line);
+            is_valid = result.ec == std::errc() && result.ptr == key.data() + key.size();
+        }
+        if (!is_valid)
+        {
+            compilation_error("Invalid entry on line " + std::to_string(profile_line) + " of profile \"" + path + "\"", 0);
+        }
+
+        // Repeated entries add up, so profiles of several runs can be joined together
+        size_t& total = kind == "line" ? m_line_counts[line] : m_func_counts[key];
+        total += count;
+        m_max_count = std::max(m_max_count, total);
+    }
+}
+
+bool Profile::has_counts() const
+{
+    return !m_line_counts.empty() || !m_func_counts.empty();
+}
+
+bool Profile::is_hot_line(size_t line) const
+{
+    std::map<size_t, size_t>::const_iterator iter = m_line_counts.find(line);
+    return iter != m_line_counts.end() && is_hot(iter->second);
+}
+
+bool Profile::is_hot_func(const std::string& name) const
+{
+    std::map<std::string, size_t>::const_iterator iter = m_func_counts.find(name);
+    return iter != m_func_counts.end() && is_hot(iter->second);
+}
+
+bool Profile::is_cold_line(size_t line) const
+{
+    std::map<size_t, size_t>::const_iterator iter = m_line_counts.find(line);
+    return !m_line_counts.empty() && (iter == m_line_counts.end() || iter->second == 0);
+}
+
+bool Profile::is_cold_func(const std::string& name) const
+{
+    std::map<std::string, size_t>::const_iterator iter = m_func_counts.find(name);
+    return !m_func_counts.empty() && (iter == m_func_counts.end() || iter->second == 0);
+}
+
+bool Profile::is_hot(size_t count) const
+{
+    return count > 1 && count * 10 >= m_max_count;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <map>
+#include <string>
+
+// Execution counts recorded from running a spell, read from a file with one entry per line, either
+//     line <source line> <count>
+//     func <function name> <count>
+// with anything after // ignored. If a file has entries of a kind, the lines or functions of that kind left out of it
+// never ran
+class Profile {
+public:
+    // Empty profile, which makes no code hot or cold
+    Profile() = default;
+    Profile(const std::string& path);
+
+    bool has_counts() const;
+
+    // Ran more than once, and at least a tenth as often as the code that ran most
+    bool is_hot_line(size_t line) const;
+    bool is_hot_func(const std::string& name) const;
+    // Never ran while the profile was recorded. Code that's neither hot nor cold is left to the usual heuristics
+    bool is_cold_line(size_t line) const;
+    bool is_cold_func(const std::string& name) const;
+private:
+    bool is_hot(size_t count) const;
+
+    std::map<size_t, size_t> m_line_counts;
+    std::map<std::string, size_t> m_func_counts;
+    size_t m_max_count = 0;
+};
\ No newline at end of file
@@ -0,0 +1,339 @@
+#include "scheduling.hpp"
+
+#include <charconv>
+
+StackScheduler::StackScheduler(std::vector<Pattern> patterns)
+    :m_patterns(std::move(patterns))
+{ }
+
+std::vector<Pattern> StackScheduler::schedule()
+{
+    for (size_t i = 0; i < m_patterns.size(); ++i)
+    {
+        const Pattern& pattern = m_patterns[i];
+
+        // Copying value from down the stack
+        if (pattern.type == PatternType::numerical_reflection && i + 1 < m_patterns.size() &&
+            m_patterns[i + 1].type == PatternType::fishermans_gambit_II)
+        {
+            const std::string& num_lit = pattern.value.value();
+            int depth;
+            std::from_chars_result result = std::from_chars(num_lit.data(), num_lit.data() + num_lit.size(), depth);
+            if (result.ec == std::errc() && result.ptr == num_lit.data() + num_lit.size() && depth >= 0)
+            {
+                gen_copy(depth);
+                ++i;
+                continue;
+            }
+        }
+
+        // Escaped pattern is pushed rather than ran
+        if (pattern.type == PatternType::consideration)
+        {
+            m_output.push_back(pattern);
+            if (i + 1 < m_patterns.size())
+            {
+                m_output.push_back(m_patterns[++i]);
+            }
+            push(new_value());
+            continue;
+        }
+
+        simulate(pattern);
+        m_output.push_back(pattern);
+    }
+
+    return m_output;
+}
+
+void StackScheduler::gen_copy(size_t depth)
+{
+    ValueId value = at_depth(depth);
+
+    // Find closest slot with the same value
+    size_t closest = depth;
+    for (size_t i = 0; i < depth; ++i)
+    {
+        if (at_depth(i) == value)
+        {
+            closest = i;
+            break;
+        }
+    }
+
+    // Copying from the top two slots takes one pattern once optimized, otherwise rebuilding a number literal is cheaper
+    std::map<ValueId, std::string>::iterator literal = m_value_literals.find(value);
+    if (closest > 1 && literal != m_value_literals.end())
+    {
+        m_output.push_back(Pattern{.type = PatternType::numerical_reflection, .value = literal->second});
+    }
+    else
+    {
+        m_output.push_back(Pattern{.type = PatternType::numerical_reflection, .value = std::to_string(closest)});
+        m_output.push_back(Pattern{.type = PatternType::fishermans_gambit_II, .value = {}});
+    }
+
+    push(value);
+}
+
+void StackScheduler::simulate(const Pattern& pattern)
+{
+    switch (pattern.type)
+    {
+    case PatternType::numerical_reflection:
+        push(literal_value(pattern.value.value()));
+        break;
+    case PatternType::fishermans_gambit:
+    case PatternType::fishermans_gambit_II:
+    {
+        // Need to know the number to know where iotas go
+        std::map<ValueId, std::string>::iterator literal = m_value_literals.find(at_depth(0));
+        if (literal == m_value_literals.end())
+        {
+            reset();
+            break;
+        }
+
+        int n;
+        const std::string& num_lit = literal->second;
+        std::from_chars_result result = std::from_chars(num_lit.data(), num_lit.data() + num_lit.size(), n);
+        if (result.ec != std::errc() || result.ptr != num_lit.data() + num_lit.size())
+        {
+            reset();
+            break;
+        }
+
+        pop();
+        // Make sure every slot involved is tracked
+        at_depth(n >= 0 ? n : -n);
+
+        if (pattern.type == PatternType::fishermans_gambit)
+        {
+            if (n >= 0)
+            {
+                ValueId value = m_stack[m_stack.size() - 1 - n];
+                m_stack.erase(m_stack.end() - 1 - n);
+                m_stack.push_back(value);
+            }
+            else
+            {
+                ValueId value = pop();
+                m_stack.insert(m_stack.end() + n, value);
+            }
+        }
+        else
+        {
+            if (n >= 0)
+            {
+                push(at_depth(n));
+            }
+            else
+            {
+                m_stack.insert(m_stack.end() - 1 + n, at_depth(0));
+            }
+        }
+        break;
+    }
+    case PatternType::gemini_decomposition:
+        push(at_depth(0));
+        break;
+    case PatternType::prospectors_gambit:
+        push(at_depth(1));
+        break;
+    case PatternType::dioscuri_gambit:
+        push(at_depth(1));
+        push(at_depth(1));
+        break;
+    case PatternType::jesters_gambit:
+        std::swap(at_depth(0), at_depth(1));
+        break;
+    case PatternType::rotation_gambit:
+    {
+        // 3rd becomes 1st
+        at_depth(2);
+        ValueId value = m_stack[m_stack.size() - 3];
+        m_stack.erase(m_stack.end() - 3);
+        m_stack.push_back(value);
+        break;
+    }
+    case PatternType::rotation_gambit_II:
+    {
+        // 1st becomes 3rd
+        at_depth(2);
+        ValueId value = pop();
+        m_stack.insert(m_stack.end() - 2, value);
+        break;
+    }
+    case PatternType::bookkeepers_gambit:
+    {
+        const std::string& mask = pattern.value.value();
+        if (mask.empty())
+        {
+            break;
+        }
+        at_depth(mask.size() - 1);
+
+        std::vector<ValueId> kept;
+        for (size_t i = 0; i < mask.size(); ++i)
+        {
+            ValueId value = m_stack[m_stack.size() - mask.size() + i];
+            if (mask[i] == '-')
+            {
+                kept.push_back(value);
+            }
+        }
+
+        m_stack.erase(m_stack.end() - mask.size(), m_stack.end());
+        m_stack.insert(m_stack.end(), kept.begin(), kept.end());
+        break;
+    }
+    default:
+    {
+        std::optional<std::pair<int, int>> arity = pattern_arity(pattern.type);
+        if (!arity.has_value())
+        {
+            reset();
+            break;
+        }
+
+        for (int i = 0; i < arity.value().first; ++i)
+        {
+            pop();
+        }
+        for (int i = 0; i < arity.value().second; ++i)
+        {
+            push(new_value());
+        }
+        break;
+    }
+    }
+}
+
+std::optional<std::pair<int, int>> StackScheduler::pattern_arity(PatternType type)
+{
+    switch (type)
+    {
+    case PatternType::true_reflection:
+    case PatternType::false_reflection:
+    case PatternType::nullary_reflection:
+    case PatternType::vacant_reflection:
+    case PatternType::muninns_reflection:
+    case PatternType::minds_reflection:
+    case PatternType::circle_reflection:
+    case PatternType::arcs_reflection:
+    case PatternType::eulers_reflection:
+    case PatternType::entropy_reflection:
+    case PatternType::vector_reflection_NX:
+    case PatternType::vector_reflection_NY:
+    case PatternType::vector_reflection_NZ:
+    case PatternType::vector_reflection_PX:
+    case PatternType::vector_reflection_PY:
+    case PatternType::vector_reflection_PZ:
+    case PatternType::vector_reflection_zero:
+        return std::make_pair(0, 1);
+    case PatternType::augurs_purification:
+    case PatternType::negation_purification:
+    case PatternType::length_purification:
+    case PatternType::floor_purification:
+    case PatternType::ceiling_purification:
+    case PatternType::singles_purification:
+    case PatternType::sine_purification:
+    case PatternType::cosine_purification:
+    case PatternType::tangent_purification:
+    case PatternType::inverse_sine_purification:
+    case PatternType::inverse_cosine_purification:
+    case PatternType::inverse_tangent_purification:
+    case PatternType::retrograde_purification:
+    case PatternType::uniqueness_purification:
+    case PatternType::compass_purification:
+    case PatternType::compass_purification_II:
+    case PatternType::alidades_purification:
+    case PatternType::entity_prfn:
+    case PatternType::reveal:
+        return std::make_pair(1, 1);
+    case PatternType::huginns_gambit:
+        return std::make_pair(1, 0);
+    case PatternType::additive_distillation:
+    case PatternType::subtractive_distillation:
+    case PatternType::multiplicative_distillation:
+    case PatternType::division_distillation:
+    case PatternType::modulus_distillation:
+    case PatternType::power_distillation:
+    case PatternType::logarithmic_distillation:
+    case PatternType::equality_distillation:
+    case PatternType::inequality_distillation:
+    case PatternType::maximus_distillation:
+    case PatternType::maximus_distillation_II:
+    case PatternType::minimus_distillation:
+    case PatternType::minimus_distillation_II:
+    case PatternType::conjunction_distillation:
+    case PatternType::disjunction_distillation:
+    case PatternType::exclusion_distillation:
+    case PatternType::selection_distillation:
+    case PatternType::integration_distillation:
+    case PatternType::excisors_distillation:
+    case PatternType::speakers_distillation:
+    case PatternType::locators_distillation:
+    case PatternType::inverse_tangent_distillation:
+        return std::make_pair(2, 1);
+    case PatternType::augurs_exaltation:
+    case PatternType::selection_exaltation:
+    case PatternType::surgeons_exaltation:
+    case PatternType::vector_exaltation:
+        return std::make_pair(3, 1);
+    case PatternType::derivation_decomposition:
+    case PatternType::speakers_decomposition:
+        return std::make_pair(1, 2);
+    case PatternType::vector_disintegration:
+        return std::make_pair(1, 3);
+    default:
+        return {};
+    }
+}
+
+StackScheduler::ValueId& StackScheduler::at_depth(size_t depth)
+{
+    // Slots below what's tracked hold unknown values
+    while (depth >= m_stack.size())
+    {
+        m_stack.push_front(new_value());
+    }
+
+    return m_stack[m_stack.size() - 1 - depth];
+}
+
+StackScheduler::ValueId StackScheduler::pop()
+{
+    ValueId value = at_depth(0);
+    m_stack.pop_back();
+    return value;
+}
+
+void StackScheduler::push(ValueId value)
+{
+    m_stack.push_back(value);
+}
+
+StackScheduler::ValueId StackScheduler::new_value()
+{
+    return m_next_value++;
+}
+
+StackScheduler::ValueId StackScheduler::literal_value(const std::string& num_lit)
+{
+    std::map<std::string, ValueId>::iterator iter = m_literal_values.find(num_lit);
+    if (iter != m_literal_values.end())
+    {
+        return iter->second;
+    }
+
+    ValueId value = new_value();
+    m_literal_values[num_lit] = value;
+    m_value_literals[value] = num_lit;
+    return value;
+}
+
+void StackScheduler::reset()
+{
+    m_stack.clear();
+}
\ No newline at end of file
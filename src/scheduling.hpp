@@ -0,0 +1,46 @@
+#pragma once
+
+#include <deque>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "generation.hpp"
+
+// Follows what each stack slot holds through straight-line code, so that copies of variables can be taken from
+// whichever slot holding the same value is closest to the top, or rebuilt from a literal
+class StackScheduler {
+public:
+    StackScheduler(std::vector<Pattern> patterns);
+
+    std::vector<Pattern> schedule();
+private:
+    // Values are identified by ids, and slots with the same id hold the same iota
+    typedef long long ValueId;
+
+    void gen_copy(size_t depth);
+
+    // Applies effect of pattern to the tracked stack
+    void simulate(const Pattern& pattern);
+    // Numbers of iotas popped and pushed by patterns whose results don't depend on the rest of the stack
+    std::optional<std::pair<int, int>> pattern_arity(PatternType type);
+
+    ValueId& at_depth(size_t depth);
+    ValueId pop();
+    void push(ValueId value);
+    ValueId new_value();
+    ValueId literal_value(const std::string& num_lit);
+    // Forget everything about the stack, like after jumping
+    void reset();
+
+    std::vector<Pattern> m_patterns;
+    std::vector<Pattern> m_output;
+
+    // Back is top of stack
+    std::deque<ValueId> m_stack;
+    ValueId m_next_value = 0;
+    std::map<std::string, ValueId> m_literal_values;
+    std::map<ValueId, std::string> m_value_literals;
+};
\ No newline at end of file
@@ -0,0 +1,1626 @@
+// Generated by tools/shuffle_table.cpp, don't edit by hand
+#pragma once
+
+// Cheapest patterns for a shuffle of the top iotas of the stack, found by trying every sequence
+struct ShuffleTableEntry {
+    // Number of iotas read from the top of the stack
+    int num_inputs;
+    // Which input ends up in each slot, bottom first, where the deepest input is 0
+    const char* outputs;
+    // Space separated codes: j jester's, r rotation, R rotation II, g gemini, p prospector's, d dioscuri,
+    // b<mask> bookkeeper's, f<n> fisherman's, F<n> fisherman's II
+    const char* patterns;
+};
+
+constexpr int shuffle_table_max_inputs = 4;
+constexpr int shuffle_table_max_outputs = 5;
+
+constexpr ShuffleTableEntry shuffle_table[] = {
+    {1, "", "bv"},
+    {1, "00", "g"},
+    {1, "000", "g g"},
+    {2, "", "bvv"},
+    {2, "00", "p bv-"},
+    {2, "000", "p g bv--"},
+    {2, "0000", "p bv- d"},
+    {2, "0001", "p g r"},
+    {2, "001", "p j"},
+    {2, "0010", "p j p"},
+    {2, "0011", "d r"},
+    {2, "010", "p"},
+    {2, "0100", "p g"},
+    {2, "0101", "d"},
+    {2, "0110", "d j"},
+    {2, "1", "bv-"},
+    {2, "10", "j"},
+    {2, "100", "j g"},
+    {2, "1000", "j g g"},
+    {2, "1001", "j d j"},
+    {2, "101", "j p"},
+    {2, "1010", "j d"},
+    {2, "1011", "j p g"},
+    {2, "11", "g bv--"},
+    {2, "110", "g r"},
+    {2, "1100", "j d r"},
+    {2, "1101", "g r p"},
+    {2, "111", "g g bv---"},
+    {2, "1110", "g g f3"},
+    {2, "1111", "g bv-- d"},
+    {3, "", "bvvv"},
+    {3, "00", "bvv g"},
+    {3, "000", "bvv g g"},
+    {3, "0000", "bvv g d"},
+    {3, "00000", "bvv g g d"},
+    {3, "00001", "r g bv-- d f4"},
+    {3, "00002", "r g bv--- d f4"},
+    {3, "0001", "bv p g r"},
+    {3, "00010", "bv p g r p"},
+    {3, "00011", "R d bv-v-- d r"},
+    {3, "00012", "R p g r f4"},
+    {3, "0002", "bv- p g r"},
+    {3, "00020", "bv- p g r p"},
+    {3, "00021", "F2 g r f3"},
+    {3, "00022", "bv- p j d r"},
+    {3, "001", "R d bv-v--"},
+    {3, "0010", "R d bv-v-- p"},
+    {3, "00100", "R d bv-v-- p g"},
+    {3, "00101", "R d bv-v-- d"},
+    {3, "00102", "F2 j p f-3"},
+    {3, "0011", "bv d r"},
+    {3, "00110", "bv d r F2"},
+    {3, "00111", "bv d r g"},
+    {3, "00112", "R d r f4"},
+    {3, "0012", "F2 R"},
+    {3, "00120", "F2 R F2"},
+    {3, "00121", "F2 R p"},
+    {3, "00122", "F2 R g"},
+    {3, "002", "bv- p j"},
+    {3, "0020", "bv- p j p"},
+    {3, "00200", "bv- p j p g"},
+    {3, "00201", "F2 j p f3"},
+    {3, "00202", "bv- p j d"},
+    {3, "0021", "j F2 R"},
+    {3, "00210", "j F2 R F2"},
+    {3, "00211", "j F2 R g"},
+    {3, "00212", "j F2 R p"},
+    {3, "0022", "bv- d r"},
+    {3, "00220", "bv- d r F2"},
+    {3, "00221", "F2 R g r"},
+    {3, "00222", "bv- d r g"},
+    {3, "010", "bv p"},
+    {3, "0100", "bv p g"},
+    {3, "01000", "bv p g g"},
+    {3, "01001", "bv p d j"},
+    {3, "01002", "F2 g r"},
+    {3, "0101", "bv d"},
+    {3, "01010", "bv p d"},
+    {3, "01011", "bv d g"},
+    {3, "01012", "R d f4"},
+    {3, "0102", "F2 j"},
+    {3, "01020", "F2 j p"},
+    {3, "01021", "p F3 R"},
+    {3, "01022", "g F3 R"},
+    {3, "0110", "bv d j"},
+    {3, "01100", "bv p d r"},
+    {3, "01101", "bv d j p"},
+    {3, "01102", "p F3 r"},
+    {3, "01110", "bv d g r"},
+    {3, "01120", "p j F3"},
+    {3, "0120", "F2"},
+    {3, "01200", "F2 g"},
+    {3, "01201", "F2 F2"},
+    {3, "01202", "F2 p"},
+    {3, "01210", "p F3"},
+    {3, "01220", "g F3"},
+    {3, "020", "bv- p"},
+    {3, "0200", "bv- p g"},
+    {3, "02000", "bv- p g g"},
+    {3, "02001", "F2 g f3"},
+    {3, "02002", "bv- p d j"},
+    {3, "0201", "F2 r"},
+    {3, "02010", "F2 r p"},
+    {3, "02011", "F2 r g"},
+    {3, "02012", "F2 r F2"},
+    {3, "0202", "bv- d"},
+    {3, "02020", "bv- p d"},
+    {3, "02021", "F2 p f3"},
+    {3, "02022", "bv- d g"},
+    {3, "0210", "j F2"},
+    {3, "02100", "j F2 g"},
+    {3, "02101", "j F2 p"},
+    {3, "02102", "j F2 F2"},
+    {3, "02110", "j g F3"},
+    {3, "02120", "j p F3"},
+    {3, "0220", "bv- d j"},
+    {3, "02200", "bv- p d r"},
+    {3, "02201", "g F3 f3"},
+    {3, "02202", "bv- d j p"},
+    {3, "02210", "g r F3"},
+    {3, "02220", "bv- d g r"},
+    {3, "1", "bv-v"},
+    {3, "10", "r bv-"},
+    {3, "100", "r g bv--"},
+    {3, "1000", "r g g bv---"},
+    {3, "10000", "r g bv-- d"},
+    {3, "10001", "r bv- d g r"},
+    {3, "10002", "r g g f3"},
+    {3, "1001", "r bv- d j"},
+    {3, "10010", "r bv- d j p"},
+    {3, "10011", "r bv- p d r"},
+    {3, "10012", "r g F3 f3"},
+    {3, "1002", "r g r"},
+    {3, "10020", "r g r p"},
+    {3, "10021", "r g r F3"},
+    {3, "10022", "j R d r"},
+    {3, "101", "r bv- p"},
+    {3, "1010", "r bv- d"},
+    {3, "10100", "r bv- d g"},
+    {3, "10101", "r bv- p d"},
+    {3, "10102", "j r d f4"},
+    {3, "1011", "r bv- p g"},
+    {3, "10110", "bv d g f4"},
+    {3, "10111", "p bv- d f-4"},
+    {3, "10112", "p j p f-4"},
+    {3, "1012", "p f-3"},
+    {3, "10120", "p f-3 F2"},
+    {3, "10121", "p g f-4"},
+    {3, "10122", "d j f-4"},
+    {3, "102", "j R"},
+    {3, "1020", "j R p"},
+    {3, "10200", "j R p g"},
+    {3, "10201", "j R p F3"},
+    {3, "10202", "j R d"},
+    {3, "1021", "j R F2"},
+    {3, "10210", "j R F2 F2"},
+    {3, "10211", "j g g f-4"},
+    {3, "10212", "j d f-4"},
+    {3, "1022", "j R g"},
+    {3, "10220", "j R d j"},
+    {3, "10221", "j R g F3"},
+    {3, "10222", "j R g g"},
+    {3, "11", "p bv-v-"},
+    {3, "110", "p bv- r"},
+    {3, "1100", "r bv- d r"},
+    {3, "11000", "r bv- d r g"},
+    {3, "11001", "p bv- r d j"},
+    {3, "11002", "p f3 g f3"},
+    {3, "1101", "p bv- r p"},
+    {3, "11010", "p bv- r d"},
+    {3, "11011", "p bv- r p g"},
+    {3, "11012", "p g f-4 f-3"},
+    {3, "1102", "p f3 r"},
+    {3, "11020", "p f3 r p"},
+    {3, "11021", "p f3 r F2"},
+    {3, "11022", "d r f4 R"},
+    {3, "111", "p g bv-v--"},
+    {3, "1110", "p g bv-- f3"},
+    {3, "11100", "p bv- r d r"},
+    {3, "11101", "p g bv-- f3 p"},
+    {3, "11102", "p g f4 f3"},
+    {3, "1111", "p bv-v- d"},
+    {3, "11110", "p bv- d f4"},
+    {3, "11111", "p g bv-v-- d"},
+    {3, "11112", "d bv-v-- p g r"},
+    {3, "1112", "p g r bv----"},
+    {3, "11120", "p g r f4"},
+    {3, "11121", "p g r bv---- p"},
+    {3, "11122", "d bv-v-- d r"},
+    {3, "112", "d bv-v--"},
+    {3, "1120", "p j f3"},
+    {3, "11200", "p j f3 g"},
+    {3, "11201", "p j f3 F2"},
+    {3, "11202", "d f4 f3"},
+    {3, "1121", "d bv-v-- p"},
+    {3, "11210", "p j p f4"},
+    {3, "11211", "d bv-v-- p g"},
+    {3, "11212", "d bv-v-- d"},
+    {3, "1122", "d r bv----"},
+    {3, "11220", "d r f4"},
+    {3, "11221", "d bv-v-- d j"},
+    {3, "11222", "d r bv---- g"},
+    {3, "12", "bv--"},
+    {3, "120", "r"},
+    {3, "1200", "r g"},
+    {3, "12000", "r g g"},
+    {3, "12001", "r g F3"},
+    {3, "12002", "r d j"},
+    {3, "1201", "r F2"},
+    {3, "12010", "R d f-4"},
+    {3, "12011", "r F2 g"},
+    {3, "12012", "d f4 R"},
+    {3, "1202", "r p"},
+    {3, "12020", "r d"},
+    {3, "12021", "r p F3"},
+    {3, "12022", "r p g"},
+    {3, "121", "p bv---"},
+    {3, "1210", "p f3"},
+    {3, "12100", "p f3 g"},
+    {3, "12101", "p f3 p"},
+    {3, "12102", "d f4 j"},
+    {3, "1211", "p g bv----"},
+    {3, "12110", "p g f4"},
+    {3, "12111", "p g bv---- g"},
+    {3, "12112", "p bv--- d j"},
+    {3, "1212", "d bv----"},
+    {3, "12120", "d f4"},
+    {3, "12121", "p bv--- d"},
+    {3, "12122", "d bv---- g"},
+    {3, "122", "g bv---"},
+    {3, "1220", "g f3"},
+    {3, "12200", "r d r"},
+    {3, "12201", "d f4 r"},
+    {3, "12202", "g f3 p"},
+    {3, "1221", "d j bv----"},
+    {3, "12210", "d j f4"},
+    {3, "12211", "p bv--- d r"},
+    {3, "12212", "d j bv---- p"},
+    {3, "1222", "g g bv----"},
+    {3, "12220", "g g f4"},
+    {3, "12221", "d bv---- g r"},
+    {3, "12222", "g bv--- d"},
+    {3, "2", "bvv-"},
+    {3, "20", "r bv--"},
+    {3, "200", "r g bv---"},
+    {3, "2000", "r g g bv----"},
+    {3, "20000", "r g bv--- d"},
+    {3, "20001", "R p g r"},
+    {3, "20002", "r d bv---- g r"},
+    {3, "2001", "R p j"},
+    {3, "20010", "R p j p"},
+    {3, "20011", "R d r"},
+    {3, "20012", "R p j F3"},
+    {3, "2002", "r d j bv----"},
+    {3, "20020", "r d j bv---- p"},
+    {3, "20021", "r d j f4"},
+    {3, "20022", "r p bv--- d r"},
+    {3, "201", "R"},
+    {3, "2010", "R p"},
+    {3, "20100", "R p g"},
+    {3, "20101", "R d"},
+    {3, "20102", "R p F3"},
+    {3, "2011", "R g"},
+    {3, "20110", "R d j"},
+    {3, "20111", "R g g"},
+    {3, "20112", "R g F3"},
+    {3, "2012", "R F2"},
+    {3, "20120", "R F2 F2"},
+    {3, "20121", "d f-4"},
+    {3, "20122", "g g f-4"},
+    {3, "202", "r p bv---"},
+    {3, "2020", "r d bv----"},
+    {3, "20200", "r d bv---- g"},
+    {3, "20201", "r d f4"},
+    {3, "20202", "r p bv--- d"},
+    {3, "2021", "j p f-3"},
+    {3, "20210", "r d f4 j"},
+    {3, "20211", "d f-4 r"},
+    {3, "20212", "j p g f-4"},
+    {3, "2022", "r p g bv----"},
+    {3, "20220", "bv- d g f4"},
+    {3, "20221", "r p g f4"},
+    {3, "20222", "g bv-- d f-4"},
+    {3, "21", "j bv--"},
+    {3, "210", "j r"},
+    {3, "2100", "j r g"},
+    {3, "21000", "j r g g"},
+    {3, "21001", "j r d j"},
+    {3, "21002", "j r g F3"},
+    {3, "2101", "j r p"},
+    {3, "21010", "j r d"},
+    {3, "21011", "j r p g"},
+    {3, "21012", "d f-4 f-3"},
+    {3, "2102", "j r F2"},
+    {3, "21020", "j R d f-4"},
+    {3, "21021", "j d f4 R"},
+    {3, "21022", "j r F2 g"},
+    {3, "211", "j g bv---"},
+    {3, "2110", "R g r"},
+    {3, "21100", "j r d r"},
+    {3, "21101", "R g r p"},
+    {3, "21102", "R g r F3"},
+    {3, "2111", "j g g bv----"},
+    {3, "21110", "j g g f4"},
+    {3, "21111", "j g bv--- d"},
+    {3, "21112", "j d bv---- g r"},
+    {3, "2112", "j d j bv----"},
+    {3, "21120", "j d j f4"},
+    {3, "21121", "d bv-v-- d f-4"},
+    {3, "21122", "d bvv--- d r"},
+    {3, "212", "d bvv---"},
+    {3, "2120", "j p f3"},
+    {3, "21200", "r d j f-4"},
+    {3, "21201", "d f4 f4"},
+    {3, "21202", "r p g f-4"},
+    {3, "2121", "j d bv----"},
+    {3, "21210", "j d f4"},
+    {3, "21211", "j d bv---- g"},
+    {3, "21212", "d bvv--- d"},
+    {3, "2122", "d bvv--- g"},
+    {3, "21220", "j p g f4"},
+    {3, "21221", "d bvv--- d j"},
+    {3, "21222", "d bvv--- g g"},
+    {3, "22", "g bvv--"},
+    {3, "220", "r d bv-v--"},
+    {3, "2200", "r d r bv----"},
+    {3, "22000", "r d r bv---- g"},
+    {3, "22001", "r d r f4"},
+    {3, "22002", "r d bv-v-- d j"},
+    {3, "2201", "R F2 R"},
+    {3, "22010", "R F2 R p"},
+    {3, "22011", "R F2 R g"},
+    {3, "22012", "g g f-4 f-3"},
+    {3, "2202", "r d bv-v-- p"},
+    {3, "22020", "r d bv-v-- d"},
+    {3, "22021", "g f3 p f4"},
+    {3, "22022", "r d bv-v-- p g"},
+    {3, "221", "j d bv-v--"},
+    {3, "2210", "g r f3"},
+    {3, "22100", "g r f3 g"},
+    {3, "22101", "g r f3 p"},
+    {3, "22102", "g r f3 F2"},
+    {3, "2211", "j d r bv----"},
+    {3, "22110", "j d r f4"},
+    {3, "22111", "j d r bv---- g"},
+    {3, "22112", "j d bv-v-- d j"},
+    {3, "2212", "j d bv-v-- p"},
+    {3, "22120", "g r p f4"},
+    {3, "22121", "j d bv-v-- d"},
+    {3, "22122", "j d bv-v-- p g"},
+    {3, "222", "g g bvv---"},
+    {3, "2220", "g g bv--- f3"},
+    {3, "22200", "r d bv-v-- d r"},
+    {3, "22201", "g g f4 f4"},
+    {3, "22202", "g g bv--- f3 p"},
+    {3, "2221", "d bvv--- g r"},
+    {3, "22210", "g g f3 f4"},
+    {3, "22211", "j d bv-v-- d r"},
+    {3, "22212", "d bvv--- g r p"},
+    {3, "2222", "g bvv-- d"},
+    {3, "22220", "g bv-- d f4"},
+    {3, "22221", "g bv--- d f4"},
+    {3, "22222", "g g bvv--- d"},
+    {4, "", "bvvvv"},
+    {4, "00", "bvvv g"},
+    {4, "000", "bvvv g g"},
+    {4, "0000", "bvvv g d"},
+    {4, "00000", "bvvv g g d"},
+    {4, "00001", "bvv j g d f4"},
+    {4, "00002", "bv-v j g d f4"},
+    {4, "00003", "bvv- j g d f4"},
+    {4, "0001", "bvv p g r"},
+    {4, "00010", "bvv p g r p"},
+    {4, "00011", "bvv p j d r"},
+    {4, "00012", "bv R p g r f4"},
+    {4, "00013", "bv- R p g r f4"},
+    {4, "0002", "bv-v p g r"},
+    {4, "00020", "bv-v p g r p"},
+    {4, "00021", "bv F2 g r f3"},
+    {4, "00022", "bv-v p j d r"},
+    {4, "00023", "bv-- R p g r f4"},
+    {4, "0003", "bvv- p g r"},
+    {4, "00030", "bvv- p g r p"},
+    {4, "00031", "bv- F2 g r f3"},
+    {4, "00032", "bv-- F2 g r f3"},
+    {4, "00033", "bvv- p j d r"},
+    {4, "001", "bvv p j"},
+    {4, "0010", "bvv p j p"},
+    {4, "00100", "bvv p j p g"},
+    {4, "00101", "bvv p j d"},
+    {4, "00102", "bv F2 j p f-3"},
+    {4, "00103", "bv- F2 j p f-3"},
+    {4, "0011", "bvv d r"},
+    {4, "00110", "bvv d r F2"},
+    {4, "00111", "bvv d r g"},
+    {4, "00112", "bv R d r f4"},
+    {4, "00113", "bv- R d r f4"},
+    {4, "0012", "bv F2 R"},
+    {4, "00120", "bv F2 R F2"},
+    {4, "00121", "bv F2 R p"},
+    {4, "00122", "bv F2 R g"},
+    {4, "00123", "F3 f-3"},
+    {4, "0013", "bv- F2 R"},
+    {4, "00130", "bv- F2 R F2"},
+    {4, "00131", "bv- F2 R p"},
+    {4, "00132", "j F3 f-3"},
+    {4, "00133", "bv- F2 R g"},
+    {4, "002", "bv-v p j"},
+    {4, "0020", "bv-v p j p"},
+    {4, "00200", "bv-v p j p g"},
+    {4, "00201", "bv F2 j p f3"},
+    {4, "00202", "bv-v p j d"},
+    {4, "00203", "bv-- F2 j p f-3"},
+    {4, "0021", "r bv- F2 R"},
+    {4, "00210", "r bv- F2 R F2"},
+    {4, "00211", "r bv- F2 R g"},
+    {4, "00212", "r bv- F2 R p"},
+    {4, "00213", "j R F3 f-3"},
+    {4, "0022", "bv-v d r"},
+    {4, "00220", "bv-v d r F2"},
+    {4, "00221", "bv F2 R g r"},
+    {4, "00222", "bv-v d r g"},
+    {4, "00223", "d bv-v-- F3 f-3"},
+    {4, "0023", "bv-- F2 R"},
+    {4, "00230", "bv-- F2 R F2"},
+    {4, "00231", "r F3 f-3"},
+    {4, "00232", "bv-- F2 R p"},
+    {4, "00233", "bv-- F2 R g"},
+    {4, "003", "bvv- p j"},
+    {4, "0030", "bvv- p j p"},
+    {4, "00300", "bvv- p j p g"},
+    {4, "00301", "bv- F2 j p f3"},
+    {4, "00302", "bv-- F2 j p f3"},
+    {4, "00303", "bvv- p j d"},
+    {4, "0031", "r bv-- F2 R"},
+    {4, "00310", "r bv-- F2 R F2"},
+    {4, "00311", "r bv-- F2 R g"},
+    {4, "00312", "R F3 f-3"},
+    {4, "00313", "r bv-- F2 R p"},
+    {4, "0032", "j bv-- F2 R"},
+    {4, "00320", "j bv-- F2 R F2"},
+    {4, "00321", "j r F3 f-3"},
+    {4, "00322", "j bv-- F2 R g"},
+    {4, "00323", "d bvv--- F3 f-3"},
+    {4, "0033", "bvv- d r"},
+    {4, "00330", "bvv- d r F2"},
+    {4, "00331", "bv- F2 R g r"},
+    {4, "00332", "bv-- F2 R g r"},
+    {4, "00333", "bvv- d r g"},
+    {4, "010", "bvv p"},
+    {4, "0100", "bvv p g"},
+    {4, "01000", "bvv p g g"},
+    {4, "01001", "bvv p d j"},
+    {4, "01002", "bv F2 g r"},
+    {4, "01003", "bv- F2 g r"},
+    {4, "0101", "bvv d"},
+    {4, "01010", "bvv p d"},
+    {4, "01011", "bvv d g"},
+    {4, "01012", "bv R d f4"},
+    {4, "01013", "bv- R d f4"},
+    {4, "0102", "bv F2 j"},
+    {4, "01020", "bv F2 j p"},
+    {4, "01021", "bv p F3 R"},
+    {4, "01022", "p bv- F3 R"},
+    {4, "01023", "F3 R"},
+    {4, "0103", "bv- F2 j"},
+    {4, "01030", "bv- F2 j p"},
+    {4, "01031", "bv- p F3 R"},
+    {4, "01032", "j F3 R"},
+    {4, "01033", "g bv-- F3 R"},
+    {4, "0110", "bvv d j"},
+    {4, "01100", "bvv p d r"},
+    {4, "01101", "bvv d j p"},
+    {4, "01102", "bv p F3 r"},
+    {4, "01103", "bv- p F3 r"},
+    {4, "01110", "bvv d g r"},
+    {4, "01120", "R d bv-v-- F3"},
+    {4, "01130", "bv- p j F3"},
+    {4, "0120", "bv F2"},
+    {4, "01200", "bv F2 g"},
+    {4, "01201", "bv F2 F2"},
+    {4, "01202", "bv F2 p"},
+    {4, "01203", "F3 j"},
+    {4, "01210", "bv p F3"},
+    {4, "01220", "p bv- F3"},
+    {4, "01230", "F3"},
+    {4, "0130", "bv- F2"},
+    {4, "01300", "bv- F2 g"},
+    {4, "01301", "bv- F2 F2"},
+    {4, "01302", "F3 r"},
+    {4, "01303", "bv- F2 p"},
+    {4, "01310", "bv- p F3"},
+    {4, "01320", "j F3"},
+    {4, "01330", "g bv-- F3"},
+    {4, "020", "bv-v p"},
+    {4, "0200", "bv-v p g"},
+    {4, "02000", "bv-v p g g"},
+    {4, "02001", "bv F2 g f3"},
+    {4, "02002", "bv-v p d j"},
+    {4, "02003", "bv-- F2 g r"},
+    {4, "0201", "bv F2 r"},
+    {4, "02010", "bv F2 r p"},
+    {4, "02011", "bv F2 r g"},
+    {4, "02012", "bv F2 r F2"},
+    {4, "02013", "F3 f3 r"},
+    {4, "0202", "bv-v d"},
+    {4, "02020", "bv-v p d"},
+    {4, "02021", "bv F2 p f3"},
+    {4, "02022", "bv-v d g"},
+    {4, "02023", "bv-- R d f4"},
+    {4, "0203", "bv-- F2 j"},
+    {4, "02030", "bv-- F2 j p"},
+    {4, "02031", "r F3 R"},
+    {4, "02032", "p bv--- F3 R"},
+    {4, "02033", "g bv--- F3 R"},
+    {4, "0210", "r bv- F2"},
+    {4, "02100", "r bv- F2 g"},
+    {4, "02101", "r bv- F2 p"},
+    {4, "02102", "r bv- F2 F2"},
+    {4, "02103", "r F3 r"},
+    {4, "02110", "r g bv-- F3"},
+    {4, "02120", "r bv- p F3"},
+    {4, "02130", "j R F3"},
+    {4, "0220", "bv-v d j"},
+    {4, "02200", "bv-v p d r"},
+    {4, "02201", "p bv- F3 f3"},
+    {4, "02202", "bv-v d j p"},
+    {4, "02203", "p bv--- F3 r"},
+    {4, "02210", "p bv- r F3"},
+    {4, "02220", "bv-v d g r"},
+    {4, "02230", "d bv-v-- F3"},
+    {4, "0230", "bv-- F2"},
+    {4, "02300", "bv-- F2 g"},
+    {4, "02301", "F3 f3"},
+    {4, "02302", "bv-- F2 F2"},
+    {4, "02303", "bv-- F2 p"},
+    {4, "02310", "r F3"},
+    {4, "02320", "p bv--- F3"},
+    {4, "02330", "g bv--- F3"},
+    {4, "030", "bvv- p"},
+    {4, "0300", "bvv- p g"},
+    {4, "03000", "bvv- p g g"},
+    {4, "03001", "bv- F2 g f3"},
+    {4, "03002", "bv-- F2 g f3"},
+    {4, "03003", "bvv- p d j"},
+    {4, "0301", "bv- F2 r"},
+    {4, "03010", "bv- F2 r p"},
+    {4, "03011", "bv- F2 r g"},
+    {4, "03012", "R F3 R"},
+    {4, "03013", "bv- F2 r F2"},
+    {4, "0302", "bv-- F2 r"},
+    {4, "03020", "bv-- F2 r p"},
+    {4, "03021", "F3 r f3"},
+    {4, "03022", "bv-- F2 r g"},
+    {4, "03023", "d bvv--- F3 R"},
+    {4, "0303", "bvv- d"},
+    {4, "03030", "bvv- p d"},
+    {4, "03031", "bv- F2 p f3"},
+    {4, "03032", "bv-- F2 p f3"},
+    {4, "03033", "bvv- d g"},
+    {4, "0310", "r bv-- F2"},
+    {4, "03100", "r bv-- F2 g"},
+    {4, "03101", "r bv-- F2 p"},
+    {4, "03102", "R F3 j"},
+    {4, "03103", "r bv-- F2 F2"},
+    {4, "03110", "r g bv--- F3"},
+    {4, "03120", "R F3"},
+    {4, "03130", "r p bv--- F3"},
+    {4, "0320", "j bv-- F2"},
+    {4, "03200", "j bv-- F2 g"},
+    {4, "03201", "R F3 r"},
+    {4, "03202", "j bv-- F2 p"},
+    {4, "03203", "d bvv--- F3 j"},
+    {4, "03210", "j r F3"},
+    {4, "03220", "j g bv--- F3"},
+    {4, "03230", "d bvv--- F3"},
+    {4, "0330", "bvv- d j"},
+    {4, "03300", "bvv- p d r"},
+    {4, "03301", "g bv-- F3 f3"},
+    {4, "03302", "d bvv--- F3 r"},
+    {4, "03303", "bvv- d j p"},
+    {4, "03310", "r d bv-v-- F3"},
+    {4, "03320", "j d bv-v-- F3"},
+    {4, "03330", "bvv- d g r"},
+    {4, "1", "bv-vv"},
+    {4, "10", "bvv j"},
+    {4, "100", "bvv j g"},
+    {4, "1000", "bvv j g g"},
+    {4, "10000", "bvv j g d"},
+    {4, "10001", "bvv j d g r"},
+    {4, "10002", "bv r g g f3"},
+    {4, "10003", "bv- r g g f3"},
+    {4, "1001", "bvv j d j"},
+    {4, "10010", "bvv j d j p"},
+    {4, "10011", "bvv j p d r"},
+    {4, "10012", "bv r g F3 f3"},
+    {4, "10013", "bv- r g F3 f3"},
+    {4, "1002", "bv r g r"},
+    {4, "10020", "bv r g r p"},
+    {4, "10021", "bv r g r F3"},
+    {4, "10022", "r bv- R d r"},
+    {4, "10023", "r f-3 F2 R"},
+    {4, "1003", "bv- r g r"},
+    {4, "10030", "bv- r g r p"},
+    {4, "10031", "bv- r g r F3"},
+    {4, "10032", "f3 g r f3"},
+    {4, "10033", "r bv-- R d r"},
+    {4, "101", "bvv j p"},
+    {4, "1010", "bvv j d"},
+    {4, "10100", "bvv j d g"},
+    {4, "10101", "bvv j p d"},
+    {4, "10102", "r bv- r d f4"},
+    {4, "10103", "r bv-- r d f4"},
+    {4, "1011", "bvv j p g"},
+    {4, "10110", "bvv d g f4"},
+    {4, "10111", "bvv g d f-4"},
+    {4, "10112", "R d bv-v-- p f-4"},
+    {4, "10113", "bv- p j p f-4"},
+    {4, "1012", "bv p f-3"},
+    {4, "10120", "bv p f-3 F2"},
+    {4, "10121", "bv p g f-4"},
+    {4, "10122", "bv d j f-4"},
+    {4, "10123", "F2 f-4"},
+    {4, "1013", "bv- p f-3"},
+    {4, "10130", "bv- p f-3 F2"},
+    {4, "10131", "bv- p g f-4"},
+    {4, "10132", "j F2 f-4"},
+    {4, "10133", "bv- d j f-4"},
+    {4, "102", "r bv- R"},
+    {4, "1020", "r bv- R p"},
+    {4, "10200", "r bv- R p g"},
+    {4, "10201", "r bv- R p F3"},
+    {4, "10202", "r bv- R d"},
+    {4, "10203", "r F3 R f-4"},
+    {4, "1021", "r g bv-- f-3"},
+    {4, "10210", "r g bv-- f-3 F2"},
+    {4, "10211", "r g g bv--- f-4"},
+    {4, "10212", "r bv- d f-4"},
+    {4, "10213", "j R p f-4"},
+    {4, "1022", "r bv- R g"},
+    {4, "10220", "r bv- R d j"},
+    {4, "10221", "r bv- R g F3"},
+    {4, "10222", "r bv- R g g"},
+    {4, "10223", "r f-3 p j"},
+    {4, "1023", "r f-3"},
+    {4, "10230", "r f-3 F2"},
+    {4, "10231", "r g f-4"},
+    {4, "10232", "r f-3 p"},
+    {4, "10233", "r f-3 g"},
+    {4, "103", "r bv-- R"},
+    {4, "1030", "f3 d bvv---"},
+    {4, "10300", "f3 d bvv--- g"},
+    {4, "10301", "f3 d bvv--- F3"},
+    {4, "10302", "f3 j p f3"},
+    {4, "10303", "r bv-- R d"},
+    {4, "1031", "r g bv--- f-3"},
+    {4, "10310", "r g bv--- f-3 F2"},
+    {4, "10311", "r g g bv---- f-4"},
+    {4, "10312", "R p f-4"},
+    {4, "10313", "r d bv---- f-4"},
+    {4, "1032", "j r f-3"},
+    {4, "10320", "j r f-3 F2"},
+    {4, "10321", "j r g f-4"},
+    {4, "10322", "R g r f-4"},
+    {4, "10323", "j r f-3 p"},
+    {4, "1033", "r bv-- R g"},
+    {4, "10330", "r bv-- R d j"},
+    {4, "10331", "r d r bv---- f-4"},
+    {4, "10332", "r f-3 g r"},
+    {4, "10333", "r bv-- R g g"},
+    {4, "11", "bv-vv g"},
+    {4, "110", "bvv g r"},
+    {4, "1100", "bvv j d r"},
+    {4, "11000", "bvv j d r g"},
+    {4, "11001", "bvv g r d j"},
+    {4, "11002", "bv p f3 g f3"},
+    {4, "11003", "bv- p f3 g f3"},
+    {4, "1101", "bvv g r p"},
+    {4, "11010", "bvv g r d"},
+    {4, "11011", "bvv g r p g"},
+    {4, "11012", "bv p g f-4 f-3"},
+    {4, "11013", "bv- p g f-4 f-3"},
+    {4, "1102", "bv p f3 r"},
+    {4, "11020", "bv p f3 r p"},
+    {4, "11021", "bv p f3 r F2"},
+    {4, "11022", "bv d r f4 R"},
+    {4, "11023", "r g f-4 f-3"},
+    {4, "1103", "bv- p f3 r"},
+    {4, "11030", "bv- p f3 r p"},
+    {4, "11031", "bv- p f3 r F2"},
+    {4, "11032", "j r g f-4 f-3"},
+    {4, "11033", "bv- d r f4 R"},
+    {4, "111", "bv-vv g g"},
+    {4, "1110", "bvv g g f3"},
+    {4, "11100", "bvv g r d r"},
+    {4, "11101", "bvv g g f3 p"},
+    {4, "11102", "bv p g f4 f3"},
+    {4, "11103", "bv- p g f4 f3"},
+    {4, "1111", "bv-vv g d"},
+    {4, "11110", "bvv g d f4"},
+    {4, "11111", "bv-vv g g d"},
+    {4, "11112", "r g bv-v-- d f4"},
+    {4, "11113", "r g bvv--- d f4"},
+    {4, "1112", "bv--v p g r"},
+    {4, "11120", "bv p g r f4"},
+    {4, "11121", "bv--v p g r p"},
+    {4, "11122", "R d bvv-v-- d r"},
+    {4, "11123", "R p g r bv----- f4"},
+    {4, "1113", "bv-v- p g r"},
+    {4, "11130", "bv- p g r f4"},
+    {4, "11131", "bv-v- p g r p"},
+    {4, "11132", "bv--- F2 g r f3"},
+    {4, "11133", "bv- d bv-v-- d r"},
+    {4, "112", "R d bvv-v--"},
+    {4, "1120", "R d bv-v-- f3"},
+    {4, "11200", "R d bv-v-- f3 g"},
+    {4, "11201", "R d bv-v-- f3 F2"},
+    {4, "11202", "bv d f4 f3"},
+    {4, "11203", "F2 R f4 j"},
+    {4, "1121", "R d bvv-v-- p"},
+    {4, "11210", "R d bv-v-- p f4"},
+    {4, "11211", "R d bvv-v-- p g"},
+    {4, "11212", "R d bvv-v-- d"},
+    {4, "11213", "R d bv--v-- p f4"},
+    {4, "1122", "bv--v d r"},
+    {4, "11220", "bv d r f4"},
+    {4, "11221", "bv--v d r F2"},
+    {4, "11222", "bv--v d r g"},
+    {4, "11223", "d bv--v-- F3 f-3"},
+    {4, "1123", "bv--- F2 R"},
+    {4, "11230", "F2 R f4"},
+    {4, "11231", "bv--- F2 R F2"},
+    {4, "11232", "bv--- F2 R p"},
+    {4, "11233", "bv--- F2 R g"},
+    {4, "113", "bv- d bv-v--"},
+    {4, "1130", "bv- p j f3"},
+    {4, "11300", "bv- p j f3 g"},
+    {4, "11301", "bv- p j f3 F2"},
+    {4, "11302", "F2 R f4 r"},
+    {4, "11303", "bv- d f4 f3"},
+    {4, "1131", "bv- p d bv-v---"},
+    {4, "11310", "bv- p j p f4"},
+    {4, "11311", "bv- p d bv-v--- g"},
+    {4, "11312", "bv--- F2 j p f3"},
+    {4, "11313", "bv- d bv-v-- d"},
+    {4, "1132", "j bv--- F2 R"},
+    {4, "11320", "j F2 R f4"},
+    {4, "11321", "j bv--- F2 R F2"},
+    {4, "11322", "j bv--- F2 R g"},
+    {4, "11323", "d bv-v--- F3 f-3"},
+    {4, "1133", "bv-v- d r"},
+    {4, "11330", "bv- d r f4"},
+    {4, "11331", "bv-v- d r F2"},
+    {4, "11332", "bv--- F2 R g r"},
+    {4, "11333", "bv-v- d r g"},
+    {4, "12", "bv--v"},
+    {4, "120", "bv r"},
+    {4, "1200", "bv r g"},
+    {4, "12000", "bv r g g"},
+    {4, "12001", "bv r g F3"},
+    {4, "12002", "bv r d j"},
+    {4, "12003", "f3 g r"},
+    {4, "1201", "bv r F2"},
+    {4, "12010", "bv R d f-4"},
+    {4, "12011", "bv r F2 g"},
+    {4, "12012", "bv d f4 R"},
+    {4, "12013", "f3 F3 r"},
+    {4, "1202", "bv r p"},
+    {4, "12020", "bv r d"},
+    {4, "12021", "bv r p F3"},
+    {4, "12022", "bv r p g"},
+    {4, "12023", "f3 F2 r"},
+    {4, "1203", "f3 j"},
+    {4, "12030", "f3 j p"},
+    {4, "12031", "f3 j F3"},
+    {4, "12032", "p f4 R"},
+    {4, "12033", "g f4 R"},
+    {4, "121", "bv--v p"},
+    {4, "1210", "bv p f3"},
+    {4, "12100", "bv p f3 g"},
+    {4, "12101", "bv p f3 p"},
+    {4, "12102", "bv d f4 j"},
+    {4, "12103", "F2 f4 r"},
+    {4, "1211", "bv--v p g"},
+    {4, "12110", "bv p g f4"},
+    {4, "12111", "bv--v p g g"},
+    {4, "12112", "bv--v p d j"},
+    {4, "12113", "bv--- F2 g r"},
+    {4, "1212", "bv--v d"},
+    {4, "12120", "bv d f4"},
+    {4, "12121", "bv--v p d"},
+    {4, "12122", "bv--v d g"},
+    {4, "12123", "R d bv----- f4"},
+    {4, "1213", "bv--- F2 j"},
+    {4, "12130", "F2 j f4"},
+    {4, "12131", "bv--- F2 j p"},
+    {4, "12132", "p bv---- F3 R"},
+    {4, "12133", "g bv---- F3 R"},
+    {4, "122", "p bv--v-"},
+    {4, "1220", "p bv- f3"},
+    {4, "12200", "bv r d r"},
+    {4, "12201", "bv d f4 r"},
+    {4, "12202", "p bv- f3 p"},
+    {4, "12203", "p f4 r"},
+    {4, "1221", "bv--v d j"},
+    {4, "12210", "bv d j f4"},
+    {4, "12211", "bv--v p d r"},
+    {4, "12212", "bv--v d j p"},
+    {4, "12213", "p bv---- F3 r"},
+    {4, "1222", "p g bv--v--"},
+    {4, "12220", "p g bv-- f4"},
+    {4, "12221", "bv--v d g r"},
+    {4, "12222", "p bv--v- d"},
+    {4, "12223", "p g r bv-----"},
+    {4, "1223", "d bv--v--"},
+    {4, "12230", "p j f4"},
+    {4, "12231", "d bv--v-- F3"},
+    {4, "12232", "d bv--v-- p"},
+    {4, "12233", "d r bv-----"},
+    {4, "123", "bv---"},
+    {4, "1230", "f3"},
+    {4, "12300", "f3 g"},
+    {4, "12301", "f3 F3"},
+    {4, "12302", "f3 F2"},
+    {4, "12303", "f3 p"},
+    {4, "1231", "bv--- F2"},
+    {4, "12310", "F2 f4"},
+    {4, "12311", "bv--- F2 g"},
+    {4, "12312", "bv--- F2 F2"},
+    {4, "12313", "bv--- F2 p"},
+    {4, "1232", "p bv----"},
+    {4, "12320", "p f4"},
+    {4, "12321", "p bv---- F3"},
+    {4, "12322", "p g bv-----"},
+    {4, "12323", "d bv-----"},
+    {4, "1233", "g bv----"},
+    {4, "12330", "g f4"},
+    {4, "12331", "g bv---- F3"},
+    {4, "12332", "d j bv-----"},
+    {4, "12333", "g g bv-----"},
+    {4, "13", "bv-v-"},
+    {4, "130", "bv- r"},
+    {4, "1300", "bv- r g"},
+    {4, "13000", "bv- r g g"},
+    {4, "13001", "bv- r g F3"},
+    {4, "13002", "f3 g f3"},
+    {4, "13003", "bv- r d j"},
+    {4, "1301", "bv- r F2"},
+    {4, "13010", "bv- R d f-4"},
+    {4, "13011", "bv- r F2 g"},
+    {4, "13012", "f-3 p f-4"},
+    {4, "13013", "bv- d f4 R"},
+    {4, "1302", "f3 r"},
+    {4, "13020", "f3 r p"},
+    {4, "13021", "f3 r F3"},
+    {4, "13022", "f3 r g"},
+    {4, "13023", "f3 r F2"},
+    {4, "1303", "bv- r p"},
+    {4, "13030", "bv- r d"},
+    {4, "13031", "bv- r p F3"},
+    {4, "13032", "f3 p f3"},
+    {4, "13033", "bv- r p g"},
+    {4, "131", "bv-v- p"},
+    {4, "1310", "bv- p f3"},
+    {4, "13100", "bv- p f3 g"},
+    {4, "13101", "bv- p f3 p"},
+    {4, "13102", "F2 f4 f3"},
+    {4, "13103", "bv- d f4 j"},
+    {4, "1311", "bv-v- p g"},
+    {4, "13110", "bv- p g f4"},
+    {4, "13111", "bv-v- p g g"},
+    {4, "13112", "bv--- F2 g f3"},
+    {4, "13113", "bv-v- p d j"},
+    {4, "1312", "bv--- F2 r"},
+    {4, "13120", "F2 r f4"},
+    {4, "13121", "bv--- F2 r p"},
+    {4, "13122", "bv--- F2 r g"},
+    {4, "13123", "d bv-v--- F3 R"},
+    {4, "1313", "bv-v- d"},
+    {4, "13130", "bv- d f4"},
+    {4, "13131", "bv-v- p d"},
+    {4, "13132", "bv--- F2 p f3"},
+    {4, "13133", "bv-v- d g"},
+    {4, "132", "j bv---"},
+    {4, "1320", "j f3"},
+    {4, "13200", "j f3 g"},
+    {4, "13201", "j f3 F3"},
+    {4, "13202", "j f3 p"},
+    {4, "13203", "j f3 F2"},
+    {4, "1321", "j bv--- F2"},
+    {4, "13210", "j F2 f4"},
+    {4, "13211", "j bv--- F2 g"},
+    {4, "13212", "j bv--- F2 p"},
+    {4, "13213", "d bv-v--- F3 j"},
+    {4, "1322", "j g bv----"},
+    {4, "13220", "j g f4"},
+    {4, "13221", "j g bv---- F3"},
+    {4, "13222", "j g g bv-----"},
+    {4, "13223", "j d j bv-----"},
+    {4, "1323", "d bv-v---"},
+    {4, "13230", "j p f4"},
+    {4, "13231", "d bv-v--- F3"},
+    {4, "13232", "j d bv-----"},
+    {4, "13233", "d bv-v--- g"},
+    {4, "133", "g bv-v--"},
+    {4, "1330", "g bv-- f3"},
+    {4, "13300", "bv- r d r"},
+    {4, "13301", "bv- d f4 r"},
+    {4, "13302", "g f4 f3"},
+    {4, "13303", "g bv-- f3 p"},
+    {4, "1331", "bv-v- d j"},
+    {4, "13310", "bv- d j f4"},
+    {4, "13311", "bv-v- p d r"},
+    {4, "13312", "d bv-v--- F3 r"},
+    {4, "13313", "bv-v- d j p"},
+    {4, "1332", "j d bv--v--"},
+    {4, "13320", "g r f4"},
+    {4, "13321", "j d bv--v-- F3"},
+    {4, "13322", "j d r bv-----"},
+    {4, "13323", "j d bv--v-- p"},
+    {4, "1333", "g g bv-v---"},
+    {4, "13330", "g g bv--- f4"},
+    {4, "13331", "bv-v- d g r"},
+    {4, "13332", "d bv-v--- g r"},
+    {4, "13333", "g bv-v-- d"},
+    {4, "2", "bvv-v"},
+    {4, "20", "bv-v j"},
+    {4, "200", "bv-v j g"},
+    {4, "2000", "bv-v j g g"},
+    {4, "20000", "bv-v j g d"},
+    {4, "20001", "bv R p g r"},
+    {4, "20002", "bv-v j d g r"},
+    {4, "20003", "bv-- r g g f3"},
+    {4, "2001", "bv R p j"},
+    {4, "20010", "bv R p j p"},
+    {4, "20011", "bv R d r"},
+    {4, "20012", "bv R p j F3"},
+    {4, "20013", "j f-3 F2 R"},
+    {4, "2002", "bv-v j d j"},
+    {4, "20020", "bv-v j d j p"},
+    {4, "20021", "bv r d j f4"},
+    {4, "20022", "p bv-v- R d r"},
+    {4, "20023", "bv-- r g F3 f3"},
+    {4, "2003", "bv-- r g r"},
+    {4, "20030", "bv-- r g r p"},
+    {4, "20031", "f3 g r f4"},
+    {4, "20032", "bv-- r g r F3"},
+    {4, "20033", "j bv-- R d r"},
+    {4, "201", "bv R"},
+    {4, "2010", "bv R p"},
+    {4, "20100", "bv R p g"},
+    {4, "20101", "bv R d"},
+    {4, "20102", "bv R p F3"},
+    {4, "20103", "j F3 R f-4"},
+    {4, "2011", "bv R g"},
+    {4, "20110", "bv R d j"},
+    {4, "20111", "bv R g g"},
+    {4, "20112", "bv R g F3"},
+    {4, "20113", "j f-3 p j"},
+    {4, "2012", "p bv- f-3"},
+    {4, "20120", "p bv- f-3 F2"},
+    {4, "20121", "bv d f-4"},
+    {4, "20122", "p g bv-- f-4"},
+    {4, "20123", "p f-4"},
+    {4, "2013", "j f-3"},
+    {4, "20130", "j f-3 F2"},
+    {4, "20131", "j f-3 p"},
+    {4, "20132", "j g f-4"},
+    {4, "20133", "g r f-4"},
+    {4, "202", "p bv-v- R"},
+    {4, "2020", "bv-v j d"},
+    {4, "20200", "bv-v j d g"},
+    {4, "20201", "bv r d f4"},
+    {4, "20202", "p bv-v- R d"},
+    {4, "20203", "j bv-- r d f4"},
+    {4, "2021", "r bv- p f-3"},
+    {4, "20210", "bv r d f4 j"},
+    {4, "20211", "bv d f-4 r"},
+    {4, "20212", "r bv- p g f-4"},
+    {4, "20213", "j g f-4 R"},
+    {4, "2022", "p bv-v- R g"},
+    {4, "20220", "bv-v d g f4"},
+    {4, "20221", "p bv- r p f-4"},
+    {4, "20222", "p bv-v- d f-4"},
+    {4, "20223", "d bv-v-- p f-4"},
+    {4, "2023", "p bv--- f-3"},
+    {4, "20230", "p bv--- f-3 F2"},
+    {4, "20231", "p f-4 r"},
+    {4, "20232", "p g bv---- f-4"},
+    {4, "20233", "d j bv---- f-4"},
+    {4, "203", "j bv-- R"},
+    {4, "2030", "f3 d bv-v---"},
+    {4, "20300", "f3 d bv-v--- g"},
+    {4, "20301", "R F3 R f-4"},
+    {4, "20302", "f3 d bv-v--- F3"},
+    {4, "20303", "j bv-- R d"},
+    {4, "2031", "R f-3"},
+    {4, "20310", "R f-3 F2"},
+    {4, "20311", "R f-3 g"},
+    {4, "20312", "R g f-4"},
+    {4, "20313", "R f-3 p"},
+    {4, "2032", "j g bv--- f-3"},
+    {4, "20320", "j g bv--- f-3 F2"},
+    {4, "20321", "j r p f-4"},
+    {4, "20322", "j g g bv---- f-4"},
+    {4, "20323", "j d bv---- f-4"},
+    {4, "2033", "j bv-- R g"},
+    {4, "20330", "j bv-- R d j"},
+    {4, "20331", "g r f-4 r"},
+    {4, "20332", "j d r bv---- f-4"},
+    {4, "20333", "j bv-- R g g"},
+    {4, "21", "r bv-v-"},
+    {4, "210", "r bv- r"},
+    {4, "2100", "r bv- r g"},
+    {4, "21000", "r bv- r g g"},
+    {4, "21001", "r bv- r d j"},
+    {4, "21002", "r bv- r g F3"},
+    {4, "21003", "r f3 g f3"},
+    {4, "2101", "r bv- r p"},
+    {4, "21010", "r bv- r d"},
+    {4, "21011", "r bv- r p g"},
+    {4, "21012", "bv d f-4 f-3"},
+    {4, "21013", "j f-3 p f-3"},
+    {4, "2102", "r bv- r F2"},
+    {4, "21020", "r bv- R d f-4"},
+    {4, "21021", "r bv- d f4 R"},
+    {4, "21022", "r bv- r F2 g"},
+    {4, "21023", "r f-3 p f-4"},
+    {4, "2103", "r f3 r"},
+    {4, "21030", "r f3 r p"},
+    {4, "21031", "R p f-4 f-4"},
+    {4, "21032", "r f3 r F3"},
+    {4, "21033", "r f3 r g"},
+    {4, "211", "r g bv-v--"},
+    {4, "2110", "bv R g r"},
+    {4, "21100", "r bv- r d r"},
+    {4, "21101", "bv R g r p"},
+    {4, "21102", "bv R g r F3"},
+    {4, "21103", "r g f4 f3"},
+    {4, "2111", "r g g bv-v---"},
+    {4, "21110", "r g g bv--- f4"},
+    {4, "21111", "r g bv-v-- d"},
+    {4, "21112", "r bv-v- d g r"},
+    {4, "21113", "r d bv-v--- g r"},
+    {4, "2112", "r bv-v- d j"},
+    {4, "21120", "r bv- d j f4"},
+    {4, "21121", "r bv-v- d j p"},
+    {4, "21122", "r bv-v- p d r"},
+    {4, "21123", "r d bv-v--- F3 r"},
+    {4, "2113", "j R d bv--v--"},
+    {4, "21130", "r g r f4"},
+    {4, "21131", "j R d bv--v-- p"},
+    {4, "21132", "j R d bv--v-- F3"},
+    {4, "21133", "j R d r bv-----"},
+    {4, "212", "r bv-v- p"},
+    {4, "2120", "r bv- p f3"},
+    {4, "21200", "bv r d j f-4"},
+    {4, "21201", "bv d f4 f4"},
+    {4, "21202", "bv r p g f-4"},
+    {4, "21203", "p f4 R f-4"},
+    {4, "2121", "r bv-v- d"},
+    {4, "21210", "r bv- d f4"},
+    {4, "21211", "r bv-v- d g"},
+    {4, "21212", "r bv-v- p d"},
+    {4, "21213", "j r d bv----- f4"},
+    {4, "2122", "r bv-v- p g"},
+    {4, "21220", "r bv- p g f4"},
+    {4, "21221", "bv--v d g f4"},
+    {4, "21222", "p bv--v- d f-4"},
+    {4, "21223", "d bv--v-- p f-4"},
+    {4, "2123", "p bv---- f-3"},
+    {4, "21230", "p f-3 f4"},
+    {4, "21231", "p bv---- f-3 F2"},
+    {4, "21232", "p g bv----- f-4"},
+    {4, "21233", "d j bv----- f-4"},
+    {4, "213", "j R bv---"},
+    {4, "2130", "j R f3"},
+    {4, "21300", "j R f3 g"},
+    {4, "21301", "j R f3 F2"},
+    {4, "21302", "j R f3 F3"},
+    {4, "21303", "j R f3 p"},
+    {4, "2131", "r d bv-v---"},
+    {4, "21310", "j R p f4"},
+    {4, "21311", "r d bv-v--- g"},
+    {4, "21312", "r d bv-v--- F3"},
+    {4, "21313", "j R d bv-----"},
+    {4, "2132", "j R bv--- F2"},
+    {4, "21320", "j R F2 f4"},
+    {4, "21321", "r d bv-v--- F3 j"},
+    {4, "21322", "j g g bv----- f-4"},
+    {4, "21323", "j d bv----- f-4"},
+    {4, "2133", "j R g bv----"},
+    {4, "21330", "j R g f4"},
+    {4, "21331", "j R d j bv-----"},
+    {4, "21332", "j R g bv---- F3"},
+    {4, "21333", "j R g g bv-----"},
+    {4, "22", "p bvv-v-"},
+    {4, "220", "p bv-v- r"},
+    {4, "2200", "p bv-v- r g"},
+    {4, "22000", "p bv-v- r g g"},
+    {4, "22001", "bv r d r f4"},
+    {4, "22002", "p bv-v- r d j"},
+    {4, "22003", "d bv-v-- f3 g r"},
+    {4, "2201", "p bv- f-3 R"},
+    {4, "22010", "p bv- f-3 R p"},
+    {4, "22011", "p bv- f-3 R g"},
+    {4, "22012", "p g bv-- f-4 f-3"},
+    {4, "22013", "j g f-4 f-3"},
+    {4, "2202", "p bv-v- r p"},
+    {4, "22020", "p bv-v- r d"},
+    {4, "22021", "p bv- f3 p f4"},
+    {4, "22022", "p bv-v- r p g"},
+    {4, "22023", "p g bv---- f-4 f-3"},
+    {4, "2203", "p bv--- f3 r"},
+    {4, "22030", "p bv--- f3 r p"},
+    {4, "22031", "R g f-4 f-3"},
+    {4, "22032", "d bv-v-- p f4 R"},
+    {4, "22033", "d r bv---- f4 R"},
+    {4, "221", "p bv--v- r"},
+    {4, "2210", "p bv- r f3"},
+    {4, "22100", "p bv- r f3 g"},
+    {4, "22101", "p bv- r f3 p"},
+    {4, "22102", "p bv- r f3 F2"},
+    {4, "22103", "p f3 f4 f3"},
+    {4, "2211", "r bv-v- d r"},
+    {4, "22110", "r bv- d r f4"},
+    {4, "22111", "r bv-v- d r g"},
+    {4, "22112", "p bv--v- r d j"},
+    {4, "22113", "d bv--v-- f3 g r"},
+    {4, "2212", "p bv--v- r p"},
+    {4, "22120", "p bv- r p f4"},
+    {4, "22121", "p bv--v- r d"},
+    {4, "22122", "p bv--v- r p g"},
+    {4, "22123", "p g bv----- f-4 f-3"},
+    {4, "2213", "p bv---- f3 r"},
+    {4, "22130", "p f3 r f4"},
+    {4, "22131", "p bv---- f3 r p"},
+    {4, "22132", "d bv--v-- p f4 R"},
+    {4, "22133", "d r bv----- f4 R"},
+    {4, "222", "p g bvv-v--"},
+    {4, "2220", "p g bv-v-- f3"},
+    {4, "22200", "p bv-v- r d r"},
+    {4, "22201", "p g bv-- f4 f4"},
+    {4, "22202", "p g bv-v-- f3 p"},
+    {4, "22203", "d bv-v-- p f4 r"},
+    {4, "2221", "p g bv--v-- f3"},
+    {4, "22210", "p g bv-- f3 f4"},
+    {4, "22211", "p bv--v- r d r"},
+    {4, "22212", "p g bv--v-- f3 p"},
+    {4, "22213", "d bv--v-- p f4 r"},
+    {4, "2222", "p bvv-v- d"},
+    {4, "22220", "p bv-v- d f4"},
+    {4, "22221", "p bv--v- d f4"},
+    {4, "22222", "p g bvv-v-- d"},
+    {4, "22223", "d bvv-v-- p g r"},
+    {4, "2223", "p g r bvv----"},
+    {4, "22230", "p g r bv---- f4"},
+    {4, "22231", "p g r bv----- f4"},
+    {4, "22232", "p g r bvv---- p"},
+    {4, "22233", "d bvv-v-- d r"},
+    {4, "223", "d bvv-v--"},
+    {4, "2230", "d bv-v-- f3"},
+    {4, "22300", "d bv-v-- f3 g"},
+    {4, "22301", "p j f4 f4"},
+    {4, "22302", "d bv-v-- f3 F2"},
+    {4, "22303", "d bv-v-- f3 p"},
+    {4, "2231", "d bv--v-- f3"},
+    {4, "22310", "p j f3 f4"},
+    {4, "22311", "d bv--v-- f3 g"},
+    {4, "22312", "d bv--v-- f3 F2"},
+    {4, "22313", "d bv--v-- f3 p"},
+    {4, "2232", "d bvv-v-- p"},
+    {4, "22320", "d bv-v-- p f4"},
+    {4, "22321", "d bv--v-- p f4"},
+    {4, "22322", "d bvv-v-- p g"},
+    {4, "22323", "d bvv-v-- d"},
+    {4, "2233", "d r bvv----"},
+    {4, "22330", "d r bv---- f4"},
+    {4, "22331", "d r bv----- f4"},
+    {4, "22332", "d bvv-v-- d j"},
+    {4, "22333", "d r bvv---- g"},
+    {4, "23", "bvv--"},
+    {4, "230", "bv-- r"},
+    {4, "2300", "bv-- r g"},
+    {4, "23000", "bv-- r g g"},
+    {4, "23001", "f3 g f4"},
+    {4, "23002", "bv-- r g F3"},
+    {4, "23003", "bv-- r d j"},
+    {4, "2301", "f3 f3"},
+    {4, "23010", "f3 f3 p"},
+    {4, "23011", "f3 f3 g"},
+    {4, "23012", "p f-4 f-3"},
+    {4, "23013", "r p f4 R"},
+    {4, "2302", "bv-- r F2"},
+    {4, "23020", "bv-- R d f-4"},
+    {4, "23021", "f3 F2 f4"},
+    {4, "23022", "bv-- r F2 g"},
+    {4, "23023", "d bv---- f4 R"},
+    {4, "2303", "bv-- r p"},
+    {4, "23030", "bv-- r d"},
+    {4, "23031", "f3 p f4"},
+    {4, "23032", "bv-- r p F3"},
+    {4, "23033", "bv-- r p g"},
+    {4, "231", "r bv---"},
+    {4, "2310", "r f3"},
+    {4, "23100", "r f3 g"},
+    {4, "23101", "r f3 p"},
+    {4, "23102", "r f3 F3"},
+    {4, "23103", "r f3 F2"},
+    {4, "2311", "r g bv----"},
+    {4, "23110", "r g f4"},
+    {4, "23111", "r g g bv-----"},
+    {4, "23112", "r g bv---- F3"},
+    {4, "23113", "r d j bv-----"},
+    {4, "2312", "r bv--- F2"},
+    {4, "23120", "r F2 f4"},
+    {4, "23121", "R d bv----- f-4"},
+    {4, "23122", "r bv--- F2 g"},
+    {4, "23123", "d bv----- f4 R"},
+    {4, "2313", "r p bv----"},
+    {4, "23130", "r p f4"},
+    {4, "23131", "r d bv-----"},
+    {4, "23132", "r p bv---- F3"},
+    {4, "23133", "r p g bv-----"},
+    {4, "232", "p bvv---"},
+    {4, "2320", "p bv--- f3"},
+    {4, "23200", "p bv--- f3 g"},
+    {4, "23201", "p f4 f4"},
+    {4, "23202", "p bv--- f3 p"},
+    {4, "23203", "d bv---- f4 j"},
+    {4, "2321", "p bv---- f3"},
+    {4, "23210", "p f3 f4"},
+    {4, "23211", "p bv---- f3 g"},
+    {4, "23212", "p bv---- f3 p"},
+    {4, "23213", "d bv----- f4 j"},
+    {4, "2322", "p g bvv----"},
+    {4, "23220", "p g bv---- f4"},
+    {4, "23221", "p g bv----- f4"},
+    {4, "23222", "p g bvv---- g"},
+    {4, "23223", "p bvv--- d j"},
+    {4, "2323", "d bvv----"},
+    {4, "23230", "d bv---- f4"},
+    {4, "23231", "d bv----- f4"},
+    {4, "23232", "p bvv--- d"},
+    {4, "23233", "d bvv---- g"},
+    {4, "233", "g bvv---"},
+    {4, "2330", "g bv--- f3"},
+    {4, "23300", "bv-- r d r"},
+    {4, "23301", "g f4 f4"},
+    {4, "23302", "d bv---- f4 r"},
+    {4, "23303", "g bv--- f3 p"},
+    {4, "2331", "r d bv--v--"},
+    {4, "23310", "g f3 f4"},
+    {4, "23311", "r d r bv-----"},
+    {4, "23312", "r d bv--v-- F3"},
+    {4, "23313", "r d bv--v-- p"},
+    {4, "2332", "d j bvv----"},
+    {4, "23320", "d j bv---- f4"},
+    {4, "23321", "d j bv----- f4"},
+    {4, "23322", "p bvv--- d r"},
+    {4, "23323", "d j bvv---- p"},
+    {4, "2333", "g g bvv----"},
+    {4, "23330", "g g bv---- f4"},
+    {4, "23331", "g g bv----- f4"},
+    {4, "23332", "d bvv---- g r"},
+    {4, "23333", "g bvv--- d"},
+    {4, "3", "bvvv-"},
+    {4, "30", "bvv- j"},
+    {4, "300", "bvv- j g"},
+    {4, "3000", "bvv- j g g"},
+    {4, "30000", "bvv- j g d"},
+    {4, "30001", "bv- R p g r"},
+    {4, "30002", "bv-- R p g r"},
+    {4, "30003", "bvv- j d g r"},
+    {4, "3001", "bv- R p j"},
+    {4, "30010", "bv- R p j p"},
+    {4, "30011", "bv- R d r"},
+    {4, "30012", "f-3 F2 R"},
+    {4, "30013", "bv- R p j F3"},
+    {4, "3002", "bv-- R p j"},
+    {4, "30020", "bv-- R p j p"},
+    {4, "30021", "f-3 j F2 R"},
+    {4, "30022", "bv-- R d r"},
+    {4, "30023", "bv-- R p j F3"},
+    {4, "3003", "bvv- j d j"},
+    {4, "30030", "bvv- j d j p"},
+    {4, "30031", "bv- r d j f4"},
+    {4, "30032", "bv-- r d j f4"},
+    {4, "30033", "g bvv-- R d r"},
+    {4, "301", "bv- R"},
+    {4, "3010", "bv- R p"},
+    {4, "30100", "bv- R p g"},
+    {4, "30101", "bv- R d"},
+    {4, "30102", "F3 R f-4"},
+    {4, "30103", "bv- R p F3"},
+    {4, "3011", "bv- R g"},
+    {4, "30110", "bv- R d j"},
+    {4, "30111", "bv- R g g"},
+    {4, "30112", "f-3 p j"},
+    {4, "30113", "bv- R g F3"},
+    {4, "3012", "f-3"},
+    {4, "30120", "f-3 F2"},
+    {4, "30121", "f-3 p"},
+    {4, "30122", "f-3 g"},
+    {4, "30123", "g f-4"},
+    {4, "3013", "g bv-- f-3"},
+    {4, "30130", "g bv-- f-3 F2"},
+    {4, "30131", "bv- d f-4"},
+    {4, "30132", "j p f-4"},
+    {4, "30133", "g g bv--- f-4"},
+    {4, "302", "bv-- R"},
+    {4, "3020", "bv-- R p"},
+    {4, "30200", "bv-- R p g"},
+    {4, "30201", "f-3 F2 r"},
+    {4, "30202", "bv-- R d"},
+    {4, "30203", "bv-- R p F3"},
+    {4, "3021", "f-3 j"},
+    {4, "30210", "f-3 j F2"},
+    {4, "30211", "f-3 j g"},
+    {4, "30212", "f-3 j p"},
+    {4, "30213", "f-3 j F3"},
+    {4, "3022", "bv-- R g"},
+    {4, "30220", "bv-- R d j"},
+    {4, "30221", "f-3 g r"},
+    {4, "30222", "bv-- R g g"},
+    {4, "30223", "d r bv---- f-4"},
+    {4, "3023", "g bv--- f-3"},
+    {4, "30230", "g bv--- f-3 F2"},
+    {4, "30231", "r p f-4"},
+    {4, "30232", "d bv---- f-4"},
+    {4, "30233", "g g bv---- f-4"},
+    {4, "303", "g bvv-- R"},
+    {4, "3030", "bvv- j d"},
+    {4, "30300", "bvv- j d g"},
+    {4, "30301", "bv- r d f4"},
+    {4, "30302", "bv-- r d f4"},
+    {4, "30303", "g bvv-- R d"},
+    {4, "3031", "r p bv--- f-3"},
+    {4, "30310", "bv- r d f4 j"},
+    {4, "30311", "bv- d f-4 r"},
+    {4, "30312", "g f-4 R"},
+    {4, "30313", "r p g bv---- f-4"},
+    {4, "3032", "d bvv--- f-3"},
+    {4, "30320", "d bvv--- f-3 F2"},
+    {4, "30321", "j p f-4 r"},
+    {4, "30322", "d bv---- f-4 r"},
+    {4, "30323", "d bvv--- g f-4"},
+    {4, "3033", "g bvv-- R g"},
+    {4, "30330", "bvv- d g f4"},
+    {4, "30331", "r d bv-v-- p f-4"},
+    {4, "30332", "j d bv-v-- p f-4"},
+    {4, "30333", "g bvv-- d f-4"},
+    {4, "31", "r bvv--"},
+    {4, "310", "r bv-- r"},
+    {4, "3100", "r bv-- r g"},
+    {4, "31000", "r bv-- r g g"},
+    {4, "31001", "r bv-- r d j"},
+    {4, "31002", "R f3 g r"},
+    {4, "31003", "r bv-- r g F3"},
+    {4, "3101", "r bv-- r p"},
+    {4, "31010", "r bv-- r d"},
+    {4, "31011", "r bv-- r p g"},
+    {4, "31012", "f-3 p f-3"},
+    {4, "31013", "bv- d f-4 f-3"},
+    {4, "3102", "R f3 j"},
+    {4, "31020", "R f3 j p"},
+    {4, "31021", "R p f4 R"},
+    {4, "31022", "R g f4 R"},
+    {4, "31023", "r p f-4 f-3"},
+    {4, "3103", "r bv-- r F2"},
+    {4, "31030", "r bv-- R d f-4"},
+    {4, "31031", "r d bv---- f4 R"},
+    {4, "31032", "R f3 F3 r"},
+    {4, "31033", "r bv-- r F2 g"},
+    {4, "311", "r g bvv---"},
+    {4, "3110", "bv- R g r"},
+    {4, "31100", "r bv-- r d r"},
+    {4, "31101", "bv- R g r p"},
+    {4, "31102", "R p f4 r"},
+    {4, "31103", "bv- R g r F3"},
+    {4, "3111", "r g g bvv----"},
+    {4, "31110", "r g g bv---- f4"},
+    {4, "31111", "r g bvv--- d"},
+    {4, "31112", "R p g r bv-----"},
+    {4, "31113", "r d bvv---- g r"},
+    {4, "3112", "R d bv--v--"},
+    {4, "31120", "R p j f4"},
+    {4, "31121", "R d bv--v-- p"},
+    {4, "31122", "R d r bv-----"},
+    {4, "31123", "R d bv--v-- F3"},
+    {4, "3113", "r d j bvv----"},
+    {4, "31130", "r d j bv---- f4"},
+    {4, "31131", "r d j bvv---- p"},
+    {4, "31132", "r d j bv----- f4"},
+    {4, "31133", "r p bvv--- d r"},
+    {4, "312", "R bv---"},
+    {4, "3120", "R f3"},
+    {4, "31200", "R f3 g"},
+    {4, "31201", "R f3 F2"},
+    {4, "31202", "R f3 p"},
+    {4, "31203", "R f3 F3"},
+    {4, "3121", "R p bv----"},
+    {4, "31210", "R p f4"},
+    {4, "31211", "R p g bv-----"},
+    {4, "31212", "R d bv-----"},
+    {4, "31213", "R p bv---- F3"},
+    {4, "3122", "R g bv----"},
+    {4, "31220", "R g f4"},
+    {4, "31221", "R d j bv-----"},
+    {4, "31222", "R g g bv-----"},
+    {4, "31223", "R g bv---- F3"},
+    {4, "3123", "R bv--- F2"},
+    {4, "31230", "R F2 f4"},
+    {4, "31231", "R bv--- F2 F2"},
+    {4, "31232", "d bv----- f-4"},
+    {4, "31233", "g g bv----- f-4"},
+    {4, "313", "r p bvv---"},
+    {4, "3130", "r p bv--- f3"},
+    {4, "31300", "bv- r d j f-4"},
+    {4, "31301", "bv- d f4 f4"},
+    {4, "31302", "r p f4 f4"},
+    {4, "31303", "bv- r p g f-4"},
+    {4, "3131", "r d bvv----"},
+    {4, "31310", "r d bv---- f4"},
+    {4, "31311", "r d bvv---- g"},
+    {4, "31312", "r d bv----- f4"},
+    {4, "31313", "r p bvv--- d"},
+    {4, "3132", "d bv-v--- f-3"},
+    {4, "31320", "j p f-3 f4"},
+    {4, "31321", "d bv-v--- f-3 F2"},
+    {4, "31322", "d bv----- f-4 r"},
+    {4, "31323", "d bv-v--- g f-4"},
+    {4, "3133", "r p g bvv----"},
+    {4, "31330", "r p g bv---- f4"},
+    {4, "31331", "bv-v- d g f4"},
+    {4, "31332", "j d bv--v-- p f-4"},
+    {4, "31333", "g bv-v-- d f-4"},
+    {4, "32", "j bvv--"},
+    {4, "320", "j bv-- r"},
+    {4, "3200", "j bv-- r g"},
+    {4, "32000", "j bv-- r g g"},
+    {4, "32001", "f-3 R p j"},
+    {4, "32002", "j bv-- r d j"},
+    {4, "32003", "j bv-- r g F3"},
+    {4, "3201", "f-3 R"},
+    {4, "32010", "f-3 R p"},
+    {4, "32011", "f-3 R g"},
+    {4, "32012", "p f-4 f-4"},
+    {4, "32013", "f-3 R F3"},
+    {4, "3202", "j bv-- r p"},
+    {4, "32020", "j bv-- r d"},
+    {4, "32021", "j f3 p f4"},
+    {4, "32022", "j bv-- r p g"},
+    {4, "32023", "d bv---- f-4 f-3"},
+    {4, "3203", "j bv-- r F2"},
+    {4, "32030", "j bv-- R d f-4"},
+    {4, "32031", "R f-3 p f-4"},
+    {4, "32032", "j d bv---- f4 R"},
+    {4, "32033", "j bv-- r F2 g"},
+    {4, "321", "j r bv---"},
+    {4, "3210", "j r f3"},
+    {4, "32100", "j r f3 g"},
+    {4, "32101", "j r f3 p"},
+    {4, "32102", "j r f3 F2"},
+    {4, "32103", "j r f3 F3"},
+    {4, "3211", "j r g bv----"},
+    {4, "32110", "j r g f4"},
+    {4, "32111", "j r g g bv-----"},
+    {4, "32112", "j r d j bv-----"},
+    {4, "32113", "j r g bv---- F3"},
+    {4, "3212", "R d bv-v---"},
+    {4, "32120", "j r p f4"},
+    {4, "32121", "j r d bv-----"},
+    {4, "32122", "R d bv-v--- g"},
+    {4, "32123", "R d bv-v--- F3"},
+    {4, "3213", "j r bv--- F2"},
+    {4, "32130", "j r F2 f4"},
+    {4, "32131", "j R d bv----- f-4"},
+    {4, "32132", "j d bv----- f4 R"},
+    {4, "32133", "j r bv--- F2 g"},
+    {4, "322", "j g bvv---"},
+    {4, "3220", "bv-- R g r"},
+    {4, "32200", "j bv-- r d r"},
+    {4, "32201", "j g f4 f4"},
+    {4, "32202", "bv-- R g r p"},
+    {4, "32203", "bv-- R g r F3"},
+    {4, "3221", "j r d bv--v--"},
+    {4, "32210", "R g r f4"},
+    {4, "32211", "j r d r bv-----"},
+    {4, "32212", "j r d bv--v-- p"},
+    {4, "32213", "j r d bv--v-- F3"},
+    {4, "3222", "j g g bvv----"},
+    {4, "32220", "j g g bv---- f4"},
+    {4, "32221", "R d bv-v--- g r"},
+    {4, "32222", "j g bvv--- d"},
+    {4, "32223", "j d bvv---- g r"},
+    {4, "3223", "j d j bvv----"},
+    {4, "32230", "j d j bv---- f4"},
+    {4, "32231", "j d j bv----- f4"},
+    {4, "32232", "d bvv-v-- d f-4"},
+    {4, "32233", "d bvvv--- d r"},
+    {4, "323", "d bvvv---"},
+    {4, "3230", "d bvv--- f3"},
+    {4, "32300", "d bvv--- f3 g"},
+    {4, "32301", "j p f4 f4"},
+    {4, "32302", "d bv---- f4 f4"},
+    {4, "32303", "d bvv--- f3 p"},
+    {4, "3231", "d bv-v--- f3"},
+    {4, "32310", "j p f3 f4"},
+    {4, "32311", "d bv-v--- f3 g"},
+    {4, "32312", "d bv----- f4 f4"},
+    {4, "32313", "d bv-v--- f3 p"},
+    {4, "3232", "j d bvv----"},
+    {4, "32320", "j d bv---- f4"},
+    {4, "32321", "j d bv----- f4"},
+    {4, "32322", "j d bvv---- g"},
+    {4, "32323", "d bvvv--- d"},
+    {4, "3233", "d bvvv--- g"},
+    {4, "32330", "d bvv--- g f4"},
+    {4, "32331", "d bv-v--- g f4"},
+    {4, "32332", "d bvvv--- d j"},
+    {4, "32333", "d bvvv--- g g"},
+    {4, "33", "g bvvv--"},
+    {4, "330", "g bvv-- r"},
+    {4, "3300", "g bvv-- r g"},
+    {4, "33000", "g bvv-- r g g"},
+    {4, "33001", "bv- r d r f4"},
+    {4, "33002", "bv-- r d r f4"},
+    {4, "33003", "g bvv-- r d j"},
+    {4, "3301", "g bv-- f-3 R"},
+    {4, "33010", "g bv-- f-3 R p"},
+    {4, "33011", "g bv-- f-3 R g"},
+    {4, "33012", "g f-4 f-3"},
+    {4, "33013", "g g bv--- f-4 f-3"},
+    {4, "3302", "g bv--- f-3 R"},
+    {4, "33020", "g bv--- f-3 R p"},
+    {4, "33021", "g f-4 f-3 j"},
+    {4, "33022", "g bv--- f-3 R g"},
+    {4, "33023", "g g bv---- f-4 f-3"},
+    {4, "3303", "g bvv-- r p"},
+    {4, "33030", "g bvv-- r d"},
+    {4, "33031", "g bv-- f3 p f4"},
+    {4, "33032", "d bvv--- g f-4 f-3"},
+    {4, "33033", "g bvv-- r p g"},
+    {4, "331", "r d bvv-v--"},
+    {4, "3310", "r d bv-v-- f3"},
+    {4, "33100", "r d bv-v-- f3 g"},
+    {4, "33101", "r d bv-v-- f3 p"},
+    {4, "33102", "g f3 f4 f4"},
+    {4, "33103", "r d bv-v-- f3 F2"},
+    {4, "3311", "r d r bvv----"},
+    {4, "33110", "r d r bv---- f4"},
+    {4, "33111", "r d r bvv---- g"},
+    {4, "33112", "r d r bv----- f4"},
+    {4, "33113", "r d bvv-v-- d j"},
+    {4, "3312", "r d bv--v-- f3"},
+    {4, "33120", "R F2 R f4"},
+    {4, "33121", "r d bv--v-- f3 p"},
+    {4, "33122", "r d bv--v-- f3 g"},
+    {4, "33123", "r d bv--v-- f3 F2"},
+    {4, "3313", "r d bvv-v-- p"},
+    {4, "33130", "r d bv-v-- p f4"},
+    {4, "33131", "r d bvv-v-- d"},
+    {4, "33132", "r d bv--v-- p f4"},
+    {4, "33133", "r d bvv-v-- p g"},
+    {4, "332", "j d bvv-v--"},
+    {4, "3320", "j d bv-v-- f3"},
+    {4, "33200", "j d bv-v-- f3 g"},
+    {4, "33201", "g r f4 f4"},
+    {4, "33202", "j d bv-v-- f3 p"},
+    {4, "33203", "j d bv-v-- f3 F2"},
+    {4, "3321", "j d bv--v-- f3"},
+    {4, "33210", "g r f3 f4"},
+    {4, "33211", "j d bv--v-- f3 g"},
+    {4, "33212", "j d bv--v-- f3 p"},
+    {4, "33213", "j d bv--v-- f3 F2"},
+    {4, "3322", "j d r bvv----"},
+    {4, "33220", "j d r bv---- f4"},
+    {4, "33221", "j d r bv----- f4"},
+    {4, "33222", "j d r bvv---- g"},
+    {4, "33223", "j d bvv-v-- d j"},
+    {4, "3323", "j d bvv-v-- p"},
+    {4, "33230", "j d bv-v-- p f4"},
+    {4, "33231", "j d bv--v-- p f4"},
+    {4, "33232", "j d bvv-v-- d"},
+    {4, "33233", "j d bvv-v-- p g"},
+    {4, "333", "g g bvvv---"},
+    {4, "3330", "g g bvv--- f3"},
+    {4, "33300", "g bvv-- r d r"},
+    {4, "33301", "g g bv--- f4 f4"},
+    {4, "33302", "g g bv---- f4 f4"},
+    {4, "33303", "g g bvv--- f3 p"},
+    {4, "3331", "g g bv-v--- f3"},
+    {4, "33310", "g g bv--- f3 f4"},
+    {4, "33311", "r d bvv-v-- d r"},
+    {4, "33312", "g g bv----- f4 f4"},
+    {4, "33313", "g g bv-v--- f3 p"},
+    {4, "3332", "d bvvv--- g r"},
+    {4, "33320", "d bvv--- g r f4"},
+    {4, "33321", "d bv-v--- g r f4"},
+    {4, "33322", "j d bvv-v-- d r"},
+    {4, "33323", "d bvvv--- g r p"},
+    {4, "3333", "g bvvv-- d"},
+    {4, "33330", "g bvv-- d f4"},
+    {4, "33331", "g bv-v-- d f4"},
+    {4, "33332", "g bvv--- d f4"},
+    {4, "33333", "g g bvvv--- d"},
+};
\ No newline at end of file
@@ -0,0 +1,738 @@
+#include "specialization.hpp"
+
+#include <algorithm>
+
+#include "effects.hpp"
+#include "inlining.hpp"
+#include "unrolling.hpp"
+
+// How constant is written in the name of a copy
+static std::string const_to_string(const Constant& constant)
+{
+    if (std::holds_alternative<double>(constant.var))
+    {
+        return num_to_string(std::get<double>(constant.var));
+    }
+    else if (std::holds_alternative<bool>(constant.var))
+    {
+        return std::get<bool>(constant.var) ? "true" : "false";
+    }
+    else if (std::holds_alternative<ConstVec>(constant.var))
+    {
+        const ConstVec& vec = std::get<ConstVec>(constant.var);
+        return "vec(" + num_to_string(vec.x) + ", " + num_to_string(vec.y) + ", " + num_to_string(vec.z) + ")";
+    }
+    return "null";
+}
+
+static size_t estimate_size(const NodeExpr* expr);
+static size_t estimate_size(const NodeStmt* stmt);
+
+static size_t estimate_size(const std::vector<NodeExpr*>& exprs)
+{
+    size_t size = 0;
+    for (const NodeExpr* expr : exprs)
+    {
+        size += estimate_size(expr);
+    }
+    return size;
+}
+
+static size_t estimate_size(const std::vector<NodeStmt*>& stmts)
+{
+    size_t size = 0;
+    for (const NodeStmt* stmt : stmts)
+    {
+        size += estimate_size(stmt);
+    }
+    return size;
+}
+
+// Rough number of patterns term is generated as
+static size_t estimate_size(const NodeTerm* term)
+{
+    struct TermVisitor {
+        size_t operator()(const NodeTermUn* term_un)
+        {
+            return estimate_size(term_un->term) + 1;
+        }
+
+        size_t operator()(const NodeTermUnPost*)
+        {
+            return 5;
+        }
+
+        size_t operator()(const NodeTermNumLit*)
+        {
+            return 1;
+        }
+
+        size_t operator()(const NodeTermListLit* term_list_lit)
+        {
+            return estimate_size(term_list_lit->exprs) + 2;
+        }
+
+        size_t operator()(const NodeTermPatternLit*)
+        {
+            return 1;
+        }
+
+        size_t operator()(const NodeTermBoolLit*)
+        {
+            return 1;
+        }
+
+        size_t operator()(const NodeTermNullLit*)
+        {
+            return 1;
+        }
+
+        // Copied from its slot with Fisherman's Gambit II
+        size_t operator()(const NodeTermVar* term_var)
+        {
+            if (std::holds_alternative<NodeVarListSubscript*>(term_var->var))
+            {
+                return estimate_size(std::get<NodeVarListSubscript*>(term_var->var)->expr) + 3;
+            }
+            return 2;
+        }
+
+        size_t operator()(const NodeTermParen* term_paren)
+        {
+            return estimate_size(term_paren->expr);
+        }
+
+        // Declared functions are called through raven's mind
+        size_t operator()(const NodeTermCallFunc* call_func)
+        {
+            const std::string& func_name = call_func->func->ident.value.value();
+            return estimate_size(call_func->func->exprs) + (inbuilt_effect(func_name, false, false) == Effect::unknown ? 4 : 1);
+        }
+
+        size_t operator()(const NodeTermTernary* term_ternary)
+        {
+            std::optional<Constant> condition = const_from_expr(term_ternary->expr);
+            if (condition.has_value())
+            {
+                return estimate_size(const_is_truthy(condition.value()) ? term_ternary->then_expr : term_ternary->else_expr);
+            }
+            return estimate_size(term_ternary->expr) + estimate_size(term_ternary->then_expr) + estimate_size(term_ternary->else_expr) + 4;
+        }
+    };
+
+    TermVisitor visitor;
+    return std::visit(visitor, term->var);
+}
+
+static size_t estimate_size(const NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        return estimate_size(std::get<NodeTerm*>(expr->var));
+    }
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+    switch (expr_bin->op_type)
+    {
+    case TokenType_::eq:
+    case TokenType_::plus_eq:
+    case TokenType_::dash_eq:
+    case TokenType_::star_eq:
+    case TokenType_::fslash_eq:
+    case TokenType_::mod_eq:
+        return estimate_size(expr_bin->rhs) + 3;
+    // Member function is a single pattern after its arguments
+    case TokenType_::dot:
+        if (std::holds_alternative<NodeTerm*>(expr_bin->rhs->var) &&
+            std::holds_alternative<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var))
+        {
+            return estimate_size(expr_bin->lhs) + estimate_size(std::get<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var)->func->exprs) + 1;
+        }
+        return estimate_size(expr_bin->lhs) + estimate_size(expr_bin->rhs) + 1;
+    default:
+        return estimate_size(expr_bin->lhs) + estimate_size(expr_bin->rhs) + 1;
+    }
+}
+
+// Rough number of patterns statement is generated as, leaving out code that constant conditions make unreachable
+static size_t estimate_size(const NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        size_t operator()(const NodeStmtCallFunction* call_func)
+        {
+            const std::string& func_name = call_func->func->ident.value.value();
+            return estimate_size(call_func->func->exprs) + (inbuilt_effect(func_name, true, false) == Effect::unknown ? 4 : 1);
+        }
+
+        size_t operator()(const NodeStmtReturn* stmt_ret)
+        {
+            return (stmt_ret->expr.has_value() ? estimate_size(stmt_ret->expr.value()) : 0) + 3;
+        }
+
+        size_t operator()(const NodeExpr* stmt_expr)
+        {
+            return estimate_size(stmt_expr) + 1;
+        }
+
+        size_t operator()(const NodeStmtLet* stmt_let)
+        {
+            return estimate_size(stmt_let->expr);
+        }
+
+        size_t operator()(const NodeStmtIf* stmt_if)
+        {
+            std::optional<Constant> condition = const_from_expr(stmt_if->expr);
+            size_t stmt_size = estimate_size(stmt_if->stmt);
+            size_t else_size = stmt_if->else_stmt != nullptr ? estimate_size(stmt_if->else_stmt) : 0;
+            if (condition.has_value())
+            {
+                return const_is_truthy(condition.value()) ? stmt_size : else_size;
+            }
+            return estimate_size(stmt_if->expr) + stmt_size + else_size + 5;
+        }
+
+        size_t operator()(const NodeStmtWhile* stmt_while)
+        {
+            std::optional<Constant> condition = const_from_expr(stmt_while->expr);
+            if (condition.has_value() && !const_is_truthy(condition.value()))
+            {
+                return 0;
+            }
+            return estimate_size(stmt_while->expr) + estimate_size(stmt_while->stmt) + 8;
+        }
+
+        size_t operator()(const NodeStmtFor* stmt_for)
+        {
+            return estimate_size(stmt_for->expr) + estimate_size(stmt_for->stmt) + 4;
+        }
+
+        size_t operator()(const NodeScope* stmt_scope)
+        {
+            return estimate_size(stmt_scope->stmts) + 1;
+        }
+    };
+
+    StmtVisitor visitor;
+    return std::visit(visitor, stmt->var);
+}
+
+static const NodeScope* func_scope(const NodeFunctionDef* func_def)
+{
+    return std::holds_alternative<NodeFunctionDefVoid*>(func_def->var) ?
+        std::get<NodeFunctionDefVoid*>(func_def->var)->scope : std::get<NodeFunctionDefRet*>(func_def->var)->scope;
+}
+
+Specializer::Specializer(NodeProg* prog, ConstantFolder& folder, size_t budget)
+    :m_prog(prog), m_folder(folder), m_allocator(1024 * 1024 * 4), m_budget(budget)
+{ }
+
+void Specializer::specialize()
+{
+    // Copies are added after the other functions, so calls in them are specialized too
+    for (size_t i = 0; i < m_prog->funcs.size(); ++i)
+    {
+        for (NodeStmt* stmt : func_scope(m_prog->funcs[i])->stmts)
+        {
+            specialize_calls_stmt(stmt);
+        }
+    }
+
+    for (NodeStmt* stmt : func_scope(m_prog->main_)->stmts)
+    {
+        specialize_calls_stmt(stmt);
+    }
+}
+
+void Specializer::specialize_calls_stmt(NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        Specializer& spec;
+        StmtVisitor (Specializer& _spec) :spec(_spec) {}
+
+        void operator()(NodeStmtCallFunction* call_func)
+        {
+            for (NodeExpr* expr : call_func->func->exprs)
+            {
+                spec.specialize_calls_expr(expr);
+            }
+            spec.specialize_call(call_func->func);
+        }
+
+        void operator()(NodeStmtReturn* stmt_ret)
+        {
+            if (stmt_ret->expr.has_value())
+            {
+                spec.specialize_calls_expr(stmt_ret->expr.value());
+            }
+        }
+
+        void operator()(NodeExpr* stmt_expr)
+        {
+            spec.specialize_calls_expr(stmt_expr);
+        }
+
+        void operator()(NodeStmtLet* stmt_let)
+        {
+            spec.specialize_calls_expr(stmt_let->expr);
+        }
+
+        void operator()(NodeStmtIf* stmt_if)
+        {
+            spec.specialize_calls_expr(stmt_if->expr);
+            spec.specialize_calls_stmt(stmt_if->stmt);
+            if (stmt_if->else_stmt != nullptr)
+            {
+                spec.specialize_calls_stmt(stmt_if->else_stmt);
+            }
+        }
+
+        void operator()(NodeStmtWhile* stmt_while)
+        {
+            spec.specialize_calls_expr(stmt_while->expr);
+            spec.specialize_calls_stmt(stmt_while->stmt);
+        }
+
+        void operator()(NodeStmtFor* stmt_for)
+        {
+            spec.specialize_calls_expr(stmt_for->expr);
+            spec.specialize_calls_stmt(stmt_for->stmt);
+        }
+
+        void operator()(NodeScope* stmt_scope)
+        {
+            for (NodeStmt* scope_stmt : stmt_scope->stmts)
+            {
+                spec.specialize_calls_stmt(scope_stmt);
+            }
+        }
+    };
+
+    StmtVisitor visitor(*this);
+    std::visit(visitor, stmt->var);
+}
+
+void Specializer::specialize_calls_expr(NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        specialize_calls_term(std::get<NodeTerm*>(expr->var));
+        return;
+    }
+
+    NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+    specialize_calls_expr(expr_bin->lhs);
+
+    // Member functions are always inbuilt, so only their arguments can call anything
+    if (expr_bin->op_type == TokenType_::dot && std::holds_alternative<NodeTerm*>(expr_bin->rhs->var) &&
+        std::holds_alternative<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var))
+    {
+        for (NodeExpr* arg : std::get<NodeTermCallFunc*>(std::get<NodeTerm*>(expr_bin->rhs->var)->var)->func->exprs)
+        {
+            specialize_calls_expr(arg);
+        }
+        return;
+    }
+
+    specialize_calls_expr(expr_bin->rhs);
+}
+
+void Specializer::specialize_calls_term(NodeTerm* term)
+{
+    struct TermVisitor {
+        Specializer& spec;
+        TermVisitor (Specializer& _spec) :spec(_spec) {}
+
+        void operator()(NodeTermUn* term_un)
+        {
+            spec.specialize_calls_term(term_un->term);
+        }
+
+        void operator()(NodeTermUnPost* term_un_post)
+        {
+            spec.specialize_calls_var(term_un_post->vari);
+        }
+
+        void operator()(NodeTermNumLit*) {}
+
+        void operator()(NodeTermListLit* term_list_lit)
+        {
+            for (NodeExpr* expr : term_list_lit->exprs)
+            {
+                spec.specialize_calls_expr(expr);
+            }
+        }
+
+        void operator()(NodeTermPatternLit*) {}
+
+        void operator()(NodeTermBoolLit*) {}
+
+        void operator()(NodeTermNullLit*) {}
+
+        void operator()(NodeTermVar* term_var)
+        {
+            spec.specialize_calls_var(term_var);
+        }
+
+        void operator()(NodeTermParen* term_paren)
+        {
+            spec.specialize_calls_expr(term_paren->expr);
+        }
+
+        void operator()(NodeTermCallFunc* call_func)
+        {
+            for (NodeExpr* expr : call_func->func->exprs)
+            {
+                spec.specialize_calls_expr(expr);
+            }
+            spec.specialize_call(call_func->func);
+        }
+
+        void operator()(NodeTermTernary* term_ternary)
+        {
+            spec.specialize_calls_expr(term_ternary->expr);
+            spec.specialize_calls_expr(term_ternary->then_expr);
+            spec.specialize_calls_expr(term_ternary->else_expr);
+        }
+    };
+
+    TermVisitor visitor(*this);
+    std::visit(visitor, term->var);
+}
+
+void Specializer::specialize_calls_var(NodeTermVar* var)
+{
+    if (std::holds_alternative<NodeVarListSubscript*>(var->var))
+    {
+        specialize_calls_expr(std::get<NodeVarListSubscript*>(var->var)->expr);
+    }
+}
+
+void Specializer::specialize_call(NodeDefinedFunc* call)
+{
+    // Inbuilt functions are called before declared ones with the same name
+    const std::string func_name = call->ident.value.value();
+    if (inbuilt_effect(func_name, true, false) != Effect::unknown || inbuilt_effect(func_name, false, false) != Effect::unknown)
+    {
+        return;
+    }
+
+    std::vector<NodeFunctionDef*>::iterator iter = std::find_if(m_prog->funcs.begin(), m_prog->funcs.end(),
+        [&](const NodeFunctionDef* func_def){ return func_key(func_def) == FuncKey(func_name, call->exprs.size()); });
+    if (iter == m_prog->funcs.end())
+    {
+        return;
+    }
+    const NodeFunctionDef* func_def = *iter;
+
+    const std::vector<Token>& params = std::holds_alternative<NodeFunctionDefVoid*>(func_def->var) ?
+        std::get<NodeFunctionDefVoid*>(func_def->var)->params : std::get<NodeFunctionDefRet*>(func_def->var)->params;
+
+    // Params that are written to keep their slot, so they're never bound
+    std::map<std::string, Constant> bound_params;
+    std::string copy_name = func_name + "(";
+    for (size_t i = 0; i < params.size(); ++i)
+    {
+        std::optional<Constant> value = const_from_expr(call->exprs[i]);
+        VarUses uses(params[i].value.value());
+        for (const NodeStmt* stmt : func_scope(func_def)->stmts)
+        {
+            uses.add_stmt(stmt);
+        }
+
+        if (value.has_value() && !uses.is_written)
+        {
+            bound_params.emplace(params[i].value.value(), value.value());
+            copy_name += const_to_string(value.value());
+        }
+        else
+        {
+            copy_name += "_";
+        }
+        copy_name += i + 1 < params.size() ? ", " : "";
+    }
+    copy_name += ")";
+
+    if (bound_params.empty() || m_rejected_names.count(copy_name) > 0)
+    {
+        return;
+    }
+
+    if (m_copy_names.count(copy_name) == 0)
+    {
+        NodeFunctionDef* copy = copy_func_def(func_def, copy_name, bound_params);
+        size_t unfolded_size = estimate_size(func_scope(copy)->stmts);
+        m_folder.fold_func_def(copy);
+
+        // Copy is only worth it if the constants let something fold or branches be removed, beyond just the reads of
+        // the params becoming literals, and the focus doesn't grow past the budget
+        size_t copy_size = estimate_size(func_scope(copy)->stmts);
+        if (copy_size >= unfolded_size || m_growth + copy_size > m_budget)
+        {
+            m_rejected_names.insert(copy_name);
+            return;
+        }
+
+        m_growth += copy_size;
+        m_prog->funcs.push_back(copy);
+        m_copy_names.insert(copy_name);
+        specialized_funcs.push_back(std::make_pair(copy_name, func_name));
+    }
+
+    // Call copy without the bound arguments, which are constants so nothing is lost by not evaluating them
+    std::vector<NodeExpr*> exprs;
+    for (size_t i = 0; i < params.size(); ++i)
+    {
+        if (bound_params.count(params[i].value.value()) == 0)
+        {
+            exprs.push_back(call->exprs[i]);
+        }
+    }
+    call->ident.value = copy_name;
+    call->exprs = std::move(exprs);
+}
+
+NodeFunctionDef* Specializer::copy_func_def(const NodeFunctionDef* func_def, const std::string& name,
+    const std::map<std::string, Constant>& bound_params)
+{
+    m_bound_params = bound_params;
+
+    auto copy_params = [&](const std::vector<Token>& params) {
+        std::vector<Token> copy;
+        std::copy_if(params.begin(), params.end(), std::back_inserter(copy),
+            [&](const Token& param){ return m_bound_params.count(param.value.value()) == 0; });
+        return copy;
+    };
+
+    NodeFunctionDef* copy = copy_node(func_def);
+    if (std::holds_alternative<NodeFunctionDefVoid*>(func_def->var))
+    {
+        NodeFunctionDefVoid* func_void = copy_node(std::get<NodeFunctionDefVoid*>(func_def->var));
+        func_void->ident.value = name;
+        func_void->params = copy_params(func_void->params);
+        func_void->scope = copy_scope(func_void->scope);
+        copy->var = func_void;
+    }
+    else
+    {
+        NodeFunctionDefRet* func_ret = copy_node(std::get<NodeFunctionDefRet*>(func_def->var));
+        func_ret->ident.value = name;
+        func_ret->params = copy_params(func_ret->params);
+        func_ret->scope = copy_scope(func_ret->scope);
+        copy->var = func_ret;
+    }
+
+    m_bound_params.clear();
+    return copy;
+}
+
+NodeStmt* Specializer::copy_stmt(const NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        Specializer& spec;
+        NodeStmt* copy;
+        StmtVisitor (Specializer& _spec, NodeStmt* _copy) :spec(_spec), copy(_copy) {}
+
+        void operator()(const NodeStmtCallFunction* call_func)
+        {
+            NodeStmtCallFunction* call_copy = spec.copy_node(call_func);
+            call_copy->func = spec.copy_call(call_func->func);
+            copy->var = call_copy;
+        }
+
+        void operator()(const NodeStmtReturn* stmt_ret)
+        {
+            NodeStmtReturn* ret_copy = spec.copy_node(stmt_ret);
+            if (stmt_ret->expr.has_value())
+            {
+                ret_copy->expr = spec.copy_expr(stmt_ret->expr.value());
+            }
+            copy->var = ret_copy;
+        }
+
+        void operator()(const NodeExpr* stmt_expr)
+        {
+            copy->var = spec.copy_expr(stmt_expr);
+        }
+
+        void operator()(const NodeStmtLet* stmt_let)
+        {
+            NodeStmtLet* let_copy = spec.copy_node(stmt_let);
+            let_copy->expr = spec.copy_expr(stmt_let->expr);
+            copy->var = let_copy;
+        }
+
+        void operator()(const NodeStmtIf* stmt_if)
+        {
+            NodeStmtIf* if_copy = spec.copy_node(stmt_if);
+            if_copy->expr = spec.copy_expr(stmt_if->expr);
+            if_copy->stmt = spec.copy_stmt(stmt_if->stmt);
+            if_copy->else_stmt = stmt_if->else_stmt != nullptr ? spec.copy_stmt(stmt_if->else_stmt) : nullptr;
+            copy->var = if_copy;
+        }
+
+        void operator()(const NodeStmtWhile* stmt_while)
+        {
+            NodeStmtWhile* while_copy = spec.copy_node(stmt_while);
+            while_copy->expr = spec.copy_expr(stmt_while->expr);
+            while_copy->stmt = spec.copy_stmt(stmt_while->stmt);
+            copy->var = while_copy;
+        }
+
+        void operator()(const NodeStmtFor* stmt_for)
+        {
+            NodeStmtFor* for_copy = spec.copy_node(stmt_for);
+            for_copy->expr = spec.copy_expr(stmt_for->expr);
+            for_copy->stmt = spec.copy_stmt(stmt_for->stmt);
+            copy->var = for_copy;
+        }
+
+        void operator()(const NodeScope* stmt_scope)
+        {
+            copy->var = spec.copy_scope(stmt_scope);
+        }
+    };
+
+    NodeStmt* copy = copy_node(stmt);
+    StmtVisitor visitor(*this, copy);
+    std::visit(visitor, stmt->var);
+    return copy;
+}
+
+NodeScope* Specializer::copy_scope(const NodeScope* scope)
+{
+    NodeScope* copy = copy_node(scope);
+    for (NodeStmt*& stmt : copy->stmts)
+    {
+        stmt = copy_stmt(stmt);
+    }
+    return copy;
+}
+
+NodeExpr* Specializer::copy_expr(const NodeExpr* expr)
+{
+    NodeExpr* copy = copy_node(expr);
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        copy->var = copy_term(std::get<NodeTerm*>(expr->var));
+    }
+    else
+    {
+        NodeExprBin* bin_copy = copy_node(std::get<NodeExprBin*>(expr->var));
+        bin_copy->lhs = copy_expr(bin_copy->lhs);
+        bin_copy->rhs = copy_expr(bin_copy->rhs);
+        copy->var = bin_copy;
+    }
+    return copy;
+}
+
+NodeTerm* Specializer::copy_term(const NodeTerm* term)
+{
+    struct TermVisitor {
+        Specializer& spec;
+        NodeTerm* copy;
+        TermVisitor (Specializer& _spec, NodeTerm* _copy) :spec(_spec), copy(_copy) {}
+
+        void operator()(const NodeTermUn* term_un)
+        {
+            NodeTermUn* un_copy = spec.copy_node(term_un);
+            un_copy->term = spec.copy_term(term_un->term);
+            copy->var = un_copy;
+        }
+
+        void operator()(const NodeTermUnPost* term_un_post)
+        {
+            NodeTermUnPost* un_post_copy = spec.copy_node(term_un_post);
+            un_post_copy->vari = spec.copy_var(term_un_post->vari);
+            copy->var = un_post_copy;
+        }
+
+        void operator()(const NodeTermNumLit*) {}
+
+        void operator()(const NodeTermListLit* term_list_lit)
+        {
+            NodeTermListLit* list_copy = spec.copy_node(term_list_lit);
+            for (NodeExpr*& expr : list_copy->exprs)
+            {
+                expr = spec.copy_expr(expr);
+            }
+            copy->var = list_copy;
+        }
+
+        void operator()(const NodeTermPatternLit*) {}
+
+        void operator()(const NodeTermBoolLit*) {}
+
+        void operator()(const NodeTermNullLit*) {}
+
+        // Reads of bound params become their values
+        void operator()(const NodeTermVar* term_var)
+        {
+            if (std::holds_alternative<NodeVarIdent*>(term_var->var))
+            {
+                std::map<std::string, Constant>::const_iterator bound = spec.m_bound_params.find(
+                    std::get<NodeVarIdent*>(term_var->var)->ident.value.value());
+                if (bound != spec.m_bound_params.end())
+                {
+                    spec.m_folder.set_const_term(copy, bound->second);
+                    return;
+                }
+            }
+            copy->var = spec.copy_var(term_var);
+        }
+
+        void operator()(const NodeTermParen* term_paren)
+        {
+            NodeTermParen* paren_copy = spec.copy_node(term_paren);
+            paren_copy->expr = spec.copy_expr(term_paren->expr);
+            copy->var = paren_copy;
+        }
+
+        void operator()(const NodeTermCallFunc* call_func)
+        {
+            NodeTermCallFunc* call_copy = spec.copy_node(call_func);
+            call_copy->func = spec.copy_call(call_func->func);
+            copy->var = call_copy;
+        }
+
+        void operator()(const NodeTermTernary* term_ternary)
+        {
+            NodeTermTernary* ternary_copy = spec.copy_node(term_ternary);
+            ternary_copy->expr = spec.copy_expr(term_ternary->expr);
+            ternary_copy->then_expr = spec.copy_expr(term_ternary->then_expr);
+            ternary_copy->else_expr = spec.copy_expr(term_ternary->else_expr);
+            copy->var = ternary_copy;
+        }
+    };
+
+    // Literals are never changed, so they can be shared with the original
+    NodeTerm* copy = copy_node(term);
+    TermVisitor visitor(*this, copy);
+    std::visit(visitor, term->var);
+    return copy;
+}
+
+NodeTermVar* Specializer::copy_var(const NodeTermVar* var)
+{
+    NodeTermVar* copy = copy_node(var);
+    if (std::holds_alternative<NodeVarListSubscript*>(var->var))
+    {
+        NodeVarListSubscript* subscript_copy = copy_node(std::get<NodeVarListSubscript*>(var->var));
+        subscript_copy->expr = copy_expr(subscript_copy->expr);
+        copy->var = subscript_copy;
+    }
+    else
+    {
+        copy->var = copy_node(std::get<NodeVarIdent*>(var->var));
+    }
+    return copy;
+}
+
+NodeDefinedFunc* Specializer::copy_call(const NodeDefinedFunc* func)
+{
+    NodeDefinedFunc* copy = copy_node(func);
+    for (NodeExpr*& expr : copy->exprs)
+    {
+        expr = copy_expr(expr);
+    }
+    return copy;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parser.hpp"
+#include "folding.hpp"
+
+// Makes copies of declared functions for calls that pass some params constants, with those params replaced by their
+// values so the copies fold further, and points the calls at the copies
+class Specializer {
+public:
+    // Budget is roughly how many patterns all copies together can add to the focus
+    Specializer(NodeProg* prog, ConstantFolder& folder, size_t budget);
+
+    void specialize();
+
+    // Name of each copy made, and of the function it was copied from
+    std::vector<std::pair<std::string, std::string>> specialized_funcs;
+private:
+    void specialize_calls_stmt(NodeStmt* stmt);
+    void specialize_calls_expr(NodeExpr* expr);
+    void specialize_calls_term(NodeTerm* term);
+    void specialize_calls_var(NodeTermVar* var);
+    void specialize_call(NodeDefinedFunc* call);
+
+    // Copy of function with the params that have values bound left out, named name
+    NodeFunctionDef* copy_func_def(const NodeFunctionDef* func_def, const std::string& name,
+        const std::map<std::string, Constant>& bound_params);
+    NodeStmt* copy_stmt(const NodeStmt* stmt);
+    NodeScope* copy_scope(const NodeScope* scope);
+    NodeExpr* copy_expr(const NodeExpr* expr);
+    NodeTerm* copy_term(const NodeTerm* term);
+    NodeTermVar* copy_var(const NodeTermVar* var);
+    NodeDefinedFunc* copy_call(const NodeDefinedFunc* func);
+
+    template<typename T> T* copy_node(const T* node)
+    {
+        T* copy = m_allocator.alloc<T>();
+        *copy = *node;
+        return copy;
+    }
+
+    NodeProg* m_prog;
+    ConstantFolder& m_folder;
+    ArenaAllocator m_allocator;
+    size_t m_budget;
+    size_t m_growth = 0;
+
+    // Params being replaced in the function being copied
+    std::map<std::string, Constant> m_bound_params;
+    // Names of copies already made, and of ones that weren't worth it, so each is only tried once
+    std::set<std::string> m_copy_names;
+    std::set<std::string> m_rejected_names;
+};
\ No newline at end of file
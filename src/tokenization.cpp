@@ -33,6 +33,8 @@ std::vector<Token> Tokenizer::tokenize()
         {']', TokenType_::square_close},
         {'^', TokenType_::caret},
         {'~', TokenType_::tilde},
+        {'?', TokenType_::question},
+        {':', TokenType_::colon},
     };
 
     const std::map<std::string, TokenType_> doubleNonAlphaTokenMap {
@@ -53,9 +55,14 @@ std::vector<Token> Tokenizer::tokenize()
 
     const std::map<std::string, TokenType_> identifierTokenMap {
         {"let", TokenType_::let},
+        {"const", TokenType_::const_},
         {"if", TokenType_::if_},
         {"else", TokenType_::else_},
         {"while", TokenType_::while_},
+        {"for", TokenType_::for_},
+        {"switch", TokenType_::switch_},
+        {"case", TokenType_::case_},
+        {"default", TokenType_::default_},
         {"null", TokenType_::null_lit},
         {"void", TokenType_::void_},
         {"ret", TokenType_::ret},
@@ -220,29 +227,32 @@ std::optional<int> Tokenizer::bin_prec(TokenType_ type)
     case TokenType_::mod_eq:
     case TokenType_::eq:
         return 0;
-    case TokenType_::double_bar:
+    // Conditional operator, which isn't binary but fits in between
+    case TokenType_::question:
         return 1;
-    case TokenType_::double_amp:
+    case TokenType_::double_bar:
         return 2;
-    case TokenType_::caret:
+    case TokenType_::double_amp:
         return 3;
+    case TokenType_::caret:
+        return 4;
     case TokenType_::double_eq:
     case TokenType_::not_eq_:
-        return 4;
+        return 5;
     case TokenType_::angle_open:
     case TokenType_::angle_close:
     case TokenType_::oangle_eq:
     case TokenType_::cangle_eq:
-        return 5;
+        return 6;
     case TokenType_::plus:
     case TokenType_::dash:
-        return 6;
+        return 7;
     case TokenType_::star:
     case TokenType_::slash_forward:
     case TokenType_::modulus:
-        return 7;
-    case TokenType_::dot:
         return 8;
+    case TokenType_::dot:
+        return 9;
     default:
         return {};
     }
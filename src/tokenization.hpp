@@ -7,7 +7,7 @@
 enum class TokenType_ {
     num_lit, paren_open, paren_close, semi, ident, let, eq, plus, star, dash, slash_forward, curly_open, curly_close, if_, angle_open, angle_close, comma, else_, while_, dot, double_eq,
     double_dash, double_plus, plus_eq, dash_eq, star_eq, fslash_eq, double_amp, double_bar, not_eq_, oangle_eq, cangle_eq, mod_eq, not_, modulus, null_lit, bool_lit, void_, ret, return_,
-    square_open, square_close, caret, tilde, pattern_lit
+    square_open, square_close, caret, tilde, pattern_lit, question, colon, for_, switch_, case_, default_, const_
 };
 
 struct Token {
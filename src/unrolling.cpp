@@ -0,0 +1,435 @@
+#include "unrolling.hpp"
+
+#include "constant.hpp"
+#include "folding.hpp"
+#include "inlining.hpp"
+
+static bool is_var_ident(const NodeTermVar* var, const std::string& name)
+{
+    return std::holds_alternative<NodeVarIdent*>(var->var) && std::get<NodeVarIdent*>(var->var)->ident.value.value() == name;
+}
+
+// Variable term expression is made of, if it is one
+static const NodeTermVar* expr_var(const NodeExpr* expr)
+{
+    if (!std::holds_alternative<NodeTerm*>(expr->var) || !std::holds_alternative<NodeTermVar*>(std::get<NodeTerm*>(expr->var)->var))
+    {
+        return nullptr;
+    }
+    return std::get<NodeTermVar*>(std::get<NodeTerm*>(expr->var)->var);
+}
+
+static std::optional<double> const_num(const NodeExpr* expr)
+{
+    std::optional<Constant> value = const_from_expr(expr);
+    if (!value.has_value() || !std::holds_alternative<double>(value.value().var))
+    {
+        return {};
+    }
+    return std::get<double>(value.value().var);
+}
+
+// Comparison made each time through the loop, with the variable on the left
+static std::optional<std::pair<TokenType_, double>> find_bound(const NodeExpr* expr, const std::string& name)
+{
+    if (!std::holds_alternative<NodeExprBin*>(expr->var))
+    {
+        return {};
+    }
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+    TokenType_ op = expr_bin->op_type;
+    if (op != TokenType_::angle_open && op != TokenType_::angle_close && op != TokenType_::oangle_eq &&
+        op != TokenType_::cangle_eq && op != TokenType_::not_eq_)
+    {
+        return {};
+    }
+
+    const NodeTermVar* lhs_var = expr_var(expr_bin->lhs);
+    const NodeTermVar* rhs_var = expr_var(expr_bin->rhs);
+
+    if (lhs_var != nullptr && is_var_ident(lhs_var, name) && const_num(expr_bin->rhs).has_value())
+    {
+        return std::make_pair(op, const_num(expr_bin->rhs).value());
+    }
+
+    if (rhs_var != nullptr && is_var_ident(rhs_var, name) && const_num(expr_bin->lhs).has_value())
+    {
+        // Flip comparison so the variable is on the left
+        switch (op)
+        {
+        case TokenType_::angle_open:
+            op = TokenType_::angle_close;
+            break;
+        case TokenType_::angle_close:
+            op = TokenType_::angle_open;
+            break;
+        case TokenType_::oangle_eq:
+            op = TokenType_::cangle_eq;
+            break;
+        case TokenType_::cangle_eq:
+            op = TokenType_::oangle_eq;
+            break;
+        default:
+            break;
+        }
+        return std::make_pair(op, const_num(expr_bin->lhs).value());
+    }
+
+    return {};
+}
+
+// Amount statement adds to the variable and the variable as written in it, if that's all it does
+static std::optional<std::pair<double, const NodeTermVar*>> find_step(const NodeStmt* stmt, const std::string& name)
+{
+    if (!std::holds_alternative<NodeExpr*>(stmt->var))
+    {
+        return {};
+    }
+
+    const NodeExpr* expr = std::get<NodeExpr*>(stmt->var);
+
+    if (std::holds_alternative<NodeExprBin*>(expr->var))
+    {
+        const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+        const NodeTermVar* var = expr_var(expr_bin->lhs);
+        std::optional<double> amount = const_num(expr_bin->rhs);
+        if (var == nullptr || !is_var_ident(var, name) || !amount.has_value())
+        {
+            return {};
+        }
+
+        if (expr_bin->op_type == TokenType_::plus_eq)
+        {
+            return std::make_pair(amount.value(), var);
+        }
+        if (expr_bin->op_type == TokenType_::dash_eq)
+        {
+            return std::make_pair(-amount.value(), var);
+        }
+        return {};
+    }
+
+    const NodeTerm* term = std::get<NodeTerm*>(expr->var);
+
+    // ++x and --x
+    if (std::holds_alternative<NodeTermUn*>(term->var))
+    {
+        const NodeTermUn* term_un = std::get<NodeTermUn*>(term->var);
+        if ((term_un->op_type == TokenType_::double_plus || term_un->op_type == TokenType_::double_dash) &&
+            std::holds_alternative<NodeTermVar*>(term_un->term->var) && is_var_ident(std::get<NodeTermVar*>(term_un->term->var), name))
+        {
+            return std::make_pair(term_un->op_type == TokenType_::double_plus ? 1.0 : -1.0, std::get<NodeTermVar*>(term_un->term->var));
+        }
+    }
+
+    // x++ and x--
+    if (std::holds_alternative<NodeTermUnPost*>(term->var))
+    {
+        const NodeTermUnPost* term_un_post = std::get<NodeTermUnPost*>(term->var);
+        if (is_var_ident(term_un_post->vari, name))
+        {
+            return std::make_pair(term_un_post->op_type == TokenType_::double_plus ? 1.0 : -1.0, term_un_post->vari);
+        }
+    }
+
+    return {};
+}
+
+std::optional<InductionLoop> find_induction_loop(const NodeStmtLet* stmt_let, const NodeStmtWhile* stmt_while, size_t max_iterations)
+{
+    std::string name = stmt_let->ident.value.value();
+    std::optional<double> start = const_num(stmt_let->expr);
+    std::optional<std::pair<TokenType_, double>> bound = find_bound(stmt_while->expr, name);
+    if (!start.has_value() || !bound.has_value())
+    {
+        return {};
+    }
+
+    std::vector<NodeStmt*> body;
+    if (std::holds_alternative<NodeScope*>(stmt_while->stmt->var))
+    {
+        body = std::get<NodeScope*>(stmt_while->stmt->var)->stmts;
+    }
+    else
+    {
+        body.push_back(stmt_while->stmt);
+    }
+
+    // Variable must be stepped last, and nowhere else
+    if (body.empty())
+    {
+        return {};
+    }
+    std::optional<std::pair<double, const NodeTermVar*>> step = find_step(body.back(), name);
+    body.pop_back();
+    if (!step.has_value())
+    {
+        return {};
+    }
+
+    VarUses uses(name);
+    for (const NodeStmt* stmt : body)
+    {
+        // Returns would have to leave every copy of the body
+        if (contains_return(stmt))
+        {
+            return {};
+        }
+        uses.add_stmt(stmt);
+    }
+    if (uses.is_written)
+    {
+        return {};
+    }
+
+    // Run loop at compile time to find the variable's values
+    InductionLoop loop = {.var = step.value().second, .name = name, .step = step.value().first, .values = {},
+        .final_value = 0, .body = body};
+    Constant value = Constant{.var = start.value()};
+    while (true)
+    {
+        std::optional<Constant> condition = fold_bin_op(bound.value().first, value, Constant{.var = bound.value().second});
+        if (!condition.has_value())
+        {
+            return {};
+        }
+        if (!const_is_truthy(condition.value()))
+        {
+            break;
+        }
+
+        if (loop.values.size() >= max_iterations)
+        {
+            return {};
+        }
+        loop.values.push_back(std::get<double>(value.var));
+
+        std::optional<Constant> next = fold_bin_op(TokenType_::plus, value, Constant{.var = loop.step});
+        if (!next.has_value())
+        {
+            return {};
+        }
+        value = next.value();
+    }
+
+    loop.final_value = std::get<double>(value.var);
+    return loop;
+}
+
+bool uses_var(const std::vector<NodeStmt*>& stmts, const std::string& name)
+{
+    VarUses uses(name);
+    for (const NodeStmt* stmt : stmts)
+    {
+        uses.add_stmt(stmt);
+    }
+    return uses.is_read || uses.is_written;
+}
+
+VarUses::VarUses(std::string name)
+    :m_name(std::move(name))
+{ }
+
+void VarUses::add_stmt(const NodeStmt* stmt)
+{
+    struct StmtVisitor {
+        VarUses& uses;
+        StmtVisitor (VarUses& _uses) :uses(_uses) {}
+
+        void operator()(const NodeStmtCallFunction* call_func)
+        {
+            for (const NodeExpr* expr : call_func->func->exprs)
+            {
+                uses.add_expr(expr);
+            }
+        }
+
+        void operator()(const NodeStmtReturn* stmt_ret)
+        {
+            if (stmt_ret->expr.has_value())
+            {
+                uses.add_expr(stmt_ret->expr.value());
+            }
+        }
+
+        void operator()(const NodeExpr* stmt_expr)
+        {
+            uses.add_expr(stmt_expr);
+        }
+
+        void operator()(const NodeStmtLet* stmt_let)
+        {
+            uses.add_expr(stmt_let->expr);
+            if (stmt_let->ident.value.value() == uses.m_name)
+            {
+                uses.is_written = true;
+                uses.is_assigned = true;
+            }
+        }
+
+        void operator()(const NodeStmtIf* stmt_if)
+        {
+            uses.add_expr(stmt_if->expr);
+            uses.add_stmt(stmt_if->stmt);
+            if (stmt_if->else_stmt != nullptr)
+            {
+                uses.add_stmt(stmt_if->else_stmt);
+            }
+        }
+
+        void operator()(const NodeStmtWhile* stmt_while)
+        {
+            uses.add_expr(stmt_while->expr);
+            uses.add_stmt(stmt_while->stmt);
+        }
+
+        void operator()(const NodeStmtFor* stmt_for)
+        {
+            uses.add_expr(stmt_for->expr);
+            if (stmt_for->ident.value.value() == uses.m_name)
+            {
+                uses.is_written = true;
+                uses.is_assigned = true;
+            }
+            uses.add_stmt(stmt_for->stmt);
+        }
+
+        void operator()(const NodeScope* stmt_scope)
+        {
+            for (const NodeStmt* stmt : stmt_scope->stmts)
+            {
+                uses.add_stmt(stmt);
+            }
+        }
+    };
+
+    StmtVisitor visitor(*this);
+    std::visit(visitor, stmt->var);
+}
+
+void VarUses::add_expr(const NodeExpr* expr)
+{
+    if (std::holds_alternative<NodeTerm*>(expr->var))
+    {
+        add_term(std::get<NodeTerm*>(expr->var));
+        return;
+    }
+
+    const NodeExprBin* expr_bin = std::get<NodeExprBin*>(expr->var);
+
+    switch (expr_bin->op_type)
+    {
+    case TokenType_::eq:
+    case TokenType_::plus_eq:
+    case TokenType_::dash_eq:
+    case TokenType_::star_eq:
+    case TokenType_::fslash_eq:
+    case TokenType_::mod_eq:
+        if (expr_var(expr_bin->lhs) != nullptr)
+        {
+            add_var(expr_var(expr_bin->lhs), true);
+        }
+        else
+        {
+            add_expr(expr_bin->lhs);
+        }
+        add_expr(expr_bin->rhs);
+        return;
+    default:
+        add_expr(expr_bin->lhs);
+        add_expr(expr_bin->rhs);
+        return;
+    }
+}
+
+void VarUses::add_term(const NodeTerm* term)
+{
+    struct TermVisitor {
+        VarUses& uses;
+        TermVisitor (VarUses& _uses) :uses(_uses) {}
+
+        void operator()(const NodeTermUn* term_un)
+        {
+            if ((term_un->op_type == TokenType_::double_plus || term_un->op_type == TokenType_::double_dash) &&
+                std::holds_alternative<NodeTermVar*>(term_un->term->var))
+            {
+                uses.add_var(std::get<NodeTermVar*>(term_un->term->var), true);
+                return;
+            }
+
+            uses.add_term(term_un->term);
+        }
+
+        void operator()(const NodeTermUnPost* term_un_post)
+        {
+            uses.add_var(term_un_post->vari, true);
+        }
+
+        void operator()(const NodeTermNumLit*) {}
+
+        void operator()(const NodeTermListLit* term_list_lit)
+        {
+            for (const NodeExpr* expr : term_list_lit->exprs)
+            {
+                uses.add_expr(expr);
+            }
+        }
+
+        void operator()(const NodeTermPatternLit*) {}
+
+        void operator()(const NodeTermBoolLit*) {}
+
+        void operator()(const NodeTermNullLit*) {}
+
+        void operator()(const NodeTermVar* term_var)
+        {
+            uses.add_var(term_var, false);
+        }
+
+        void operator()(const NodeTermParen* term_paren)
+        {
+            uses.add_expr(term_paren->expr);
+        }
+
+        void operator()(const NodeTermCallFunc* call_func)
+        {
+            for (const NodeExpr* expr : call_func->func->exprs)
+            {
+                uses.add_expr(expr);
+            }
+        }
+        void operator()(const NodeTermTernary* term_ternary)
+        {
+            uses.add_expr(term_ternary->expr);
+            uses.add_expr(term_ternary->then_expr);
+            uses.add_expr(term_ternary->else_expr);
+        }
+    };
+
+    TermVisitor visitor(*this);
+    std::visit(visitor, term->var);
+}
+
+void VarUses::add_var(const NodeTermVar* var, bool is_write)
+{
+    if (std::holds_alternative<NodeVarIdent*>(var->var))
+    {
+        if (std::get<NodeVarIdent*>(var->var)->ident.value.value() == m_name)
+        {
+            is_read = is_read || !is_write;
+            is_written = is_written || is_write;
+            is_assigned = is_assigned || is_write;
+        }
+        return;
+    }
+
+    const NodeVarListSubscript* subscript = std::get<NodeVarListSubscript*>(var->var);
+    if (subscript->ident.value.value() == m_name)
+    {
+        is_read = true;
+        is_written = true;
+        is_assigned = is_assigned || is_write;
+    }
+    add_expr(subscript->expr);
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "parser.hpp"
+
+// What unrolling a loop is meant to make smaller
+enum class UnrollGoal {
+    // Patterns evaluated, as long as the focus doesn't grow by more than the budget
+    evals,
+    // Patterns in the focus
+    focus_size,
+};
+
+// Loop that steps a local by a constant each time through, until comparing it with a constant fails
+struct InductionLoop {
+    // Variable as it's written in the step, used to assign its value after unrolling
+    const NodeTermVar* var;
+    std::string name;
+    double step;
+    // Value of the variable each time through the loop
+    std::vector<double> values;
+    // Value of the variable once the loop is done
+    double final_value;
+    // Statements of the body without the step
+    std::vector<NodeStmt*> body;
+};
+
+// Recognizes a while loop stepping the variable declared right before it, if it runs at most max_iterations times
+std::optional<InductionLoop> find_induction_loop(const NodeStmtLet* stmt_let, const NodeStmtWhile* stmt_while, size_t max_iterations);
+
+// Whether statements use the variable in any way
+bool uses_var(const std::vector<NodeStmt*>& stmts, const std::string& name);
+
+// Finds how statements use a variable
+class VarUses {
+public:
+    VarUses(std::string name);
+
+    void add_stmt(const NodeStmt* stmt);
+    void add_expr(const NodeExpr* expr);
+    void add_term(const NodeTerm* term);
+
+    bool is_read = false;
+    // Set by assignments, and by subscripts, which read and write the variable without going through its value
+    bool is_written = false;
+    // Only set by assignments to the variable or its elements, and lets of its name
+    bool is_assigned = false;
+private:
+    void add_var(const NodeTermVar* var, bool is_write);
+
+    std::string m_name;
+};
\ No newline at end of file
@@ -0,0 +1,192 @@
+// Checks that shuffle rewrites keep what they leave on the stack, then times the optimizer on synthetic spells where
+// every fold makes another fold possible
+// Build from the repository root with the optimizer and what it uses, for example:
+// g++ -std=c++20 -O2 -Isrc tools/optimizer_bench.cpp src/optimization.cpp src/peephole.cpp src/constant.cpp src/util.cpp
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "optimization.hpp"
+
+// 1 + 1 + 1 + ..., each sum can only be folded once the one before it is
+static std::vector<Pattern> sum_chain(size_t length)
+{
+    std::vector<Pattern> patterns = {Pattern{.type = PatternType::numerical_reflection, .value = "1"}};
+    for (size_t i = 0; i < length; ++i)
+    {
+        patterns.push_back(Pattern{.type = PatternType::numerical_reflection, .value = "1"});
+        patterns.push_back(Pattern{.type = PatternType::additive_distillation, .value = {}});
+    }
+    return patterns;
+}
+
+// ((2 * 1 - 1) * 1 - 1) ..., alternating ops
+static std::vector<Pattern> mixed_chain(size_t length)
+{
+    std::vector<Pattern> patterns = {Pattern{.type = PatternType::numerical_reflection, .value = "2"}};
+    for (size_t i = 0; i < length; ++i)
+    {
+        patterns.push_back(Pattern{.type = PatternType::numerical_reflection, .value = "1"});
+        patterns.push_back(Pattern{.type = i % 2 == 0 ? PatternType::multiplicative_distillation : PatternType::subtractive_distillation, .value = {}});
+    }
+    return patterns;
+}
+
+static void bench(const std::string& name, std::vector<Pattern> (*make_spell)(size_t))
+{
+    for (size_t length = 1000; length <= 16000; length *= 2)
+    {
+        std::vector<Pattern> spell = make_spell(length);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Optimizer optimizer(spell);
+        std::vector<Pattern> result = optimizer.optimize();
+        std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+
+        std::cout << name << " " << spell.size() << " patterns -> " << result.size() << " in " << time.count() << " ms" << std::endl;
+    }
+}
+
+// Stack left by running stack shuffles on a stack of named iotas, empty if a pattern isn't a shuffle or mishaps
+static std::optional<std::vector<std::string>> run_shuffles(const std::vector<Pattern>& patterns, std::vector<std::string> stack)
+{
+    for (const Pattern& pattern : patterns)
+    {
+        std::vector<std::string>::iterator top = stack.end();
+        switch (pattern.type)
+        {
+        case PatternType::numerical_reflection:
+            if (!pattern.value.has_value() || pattern.value.value().empty())
+            {
+                return {};
+            }
+            stack.push_back(pattern.value.value());
+            break;
+        case PatternType::fishermans_gambit:
+        case PatternType::fishermans_gambit_II:
+        {
+            int depth;
+            std::from_chars_result result = std::from_chars(stack.back().data(), stack.back().data() + stack.back().size(), depth);
+            if (result.ec != std::errc() || result.ptr != stack.back().data() + stack.back().size())
+            {
+                return {};
+            }
+            stack.pop_back();
+            if (depth >= (int)stack.size() || -depth >= (int)stack.size())
+            {
+                return {};
+            }
+
+            bool is_copy = pattern.type == PatternType::fishermans_gambit_II;
+            if (depth >= 0)
+            {
+                std::string iota = stack[stack.size() - 1 - depth];
+                if (!is_copy)
+                {
+                    stack.erase(stack.end() - 1 - depth);
+                }
+                stack.push_back(iota);
+            }
+            else
+            {
+                std::string iota = stack.back();
+                if (!is_copy)
+                {
+                    stack.pop_back();
+                }
+                stack.insert(stack.end() - (is_copy ? 1 : 0) + depth, iota);
+            }
+            break;
+        }
+        case PatternType::bookkeepers_gambit:
+        {
+            const std::string& mask = pattern.value.value();
+            if (mask.size() > stack.size())
+            {
+                return {};
+            }
+            std::vector<std::string> kept;
+            for (size_t i = 0; i < mask.size(); ++i)
+            {
+                if (mask[i] == '-')
+                {
+                    kept.push_back(stack[stack.size() - mask.size() + i]);
+                }
+            }
+            stack.resize(stack.size() - mask.size());
+            stack.insert(stack.end(), kept.begin(), kept.end());
+            break;
+        }
+        case PatternType::jesters_gambit:
+            std::iter_swap(top - 1, top - 2);
+            break;
+        case PatternType::rotation_gambit:
+            std::rotate(top - 3, top - 2, top);
+            break;
+        case PatternType::rotation_gambit_II:
+            std::rotate(top - 3, top - 1, top);
+            break;
+        case PatternType::gemini_decomposition:
+            stack.push_back(stack.back());
+            break;
+        case PatternType::prospectors_gambit:
+            stack.push_back(stack[stack.size() - 2]);
+            break;
+        case PatternType::dioscuri_gambit:
+            stack.insert(stack.end(), {stack[stack.size() - 2], stack[stack.size() - 1]});
+            break;
+        default:
+            return {};
+        }
+    }
+    return stack;
+}
+
+// Rewrites of copies that are popped right away must leave the stack as it was. The negative depth's rewrite is as
+// long as its match, with nothing to fill the gap in front of it, so the number stepped back over must keep its value
+static bool check_shuffle_rewrites()
+{
+    const std::vector<std::vector<Pattern>> spells = {
+        {
+            Pattern{.type = PatternType::numerical_reflection, .value = "2"},
+            Pattern{.type = PatternType::fishermans_gambit_II, .value = {}},
+            Pattern{.type = PatternType::bookkeepers_gambit, .value = "-v"},
+        },
+        {
+            Pattern{.type = PatternType::numerical_reflection, .value = "3"},
+            Pattern{.type = PatternType::numerical_reflection, .value = "-2"},
+            Pattern{.type = PatternType::fishermans_gambit_II, .value = {}},
+            Pattern{.type = PatternType::bookkeepers_gambit, .value = "v"},
+        },
+    };
+
+    const std::vector<std::string> stack = {"a", "b", "c", "d"};
+    for (size_t i = 0; i < spells.size(); ++i)
+    {
+        Optimizer optimizer(spells[i]);
+        std::optional<std::vector<std::string>> expected = run_shuffles(spells[i], stack);
+        std::optional<std::vector<std::string>> result = run_shuffles(optimizer.optimize(), stack);
+        if (!expected.has_value() || result != expected)
+        {
+            std::cout << "rewrite of shuffle spell " << i << " changed what it leaves on the stack" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    if (!check_shuffle_rewrites())
+    {
+        return 1;
+    }
+
+    bench("sum chain", sum_chain);
+    bench("mixed chain", mixed_chain);
+}
\ No newline at end of file
@@ -0,0 +1,239 @@
+// Generates src/shuffle_table.hpp, the table of cheapest pattern sequences for small stack shuffles
+// Build and run from the repository root with: shuffle_table > src/shuffle_table.hpp
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Most iotas a shuffle in the table can read
+static const int max_inputs = 4;
+// Most iotas a shuffle in the table can leave
+static const int max_outputs = 5;
+// Most iotas the stack can hold while searching, past the inputs
+static const int max_extra = 2;
+
+// Stack holds which input iota is in each slot, bottom first
+typedef std::vector<int> Stack;
+
+struct Op {
+    // Code in the table, see src/shuffle_table.hpp
+    std::string code;
+    // Patterns drawn, fisherman's gambits need a number drawn first
+    int cost;
+};
+
+// Applies op to stack, returns false if the op can't be used on a stack this high
+static bool apply(const std::string& code, Stack& stack)
+{
+    int height = stack.size();
+
+    switch (code[0])
+    {
+    case 'j':
+        if (height < 2) return false;
+        std::swap(stack[height - 1], stack[height - 2]);
+        return true;
+    case 'r':
+        if (height < 3) return false;
+        stack.push_back(stack[height - 3]);
+        stack.erase(stack.end() - 4);
+        return true;
+    case 'R':
+        if (height < 3) return false;
+        stack.insert(stack.end() - 3, stack.back());
+        stack.pop_back();
+        return true;
+    case 'g':
+        if (height < 1) return false;
+        stack.push_back(stack[height - 1]);
+        return true;
+    case 'p':
+        if (height < 2) return false;
+        stack.push_back(stack[height - 2]);
+        return true;
+    case 'd':
+        if (height < 2) return false;
+        stack.push_back(stack[height - 2]);
+        stack.push_back(stack[height - 1]);
+        return true;
+    case 'b':
+    {
+        std::string mask = code.substr(1);
+        if (height < (int)mask.size()) return false;
+
+        Stack kept;
+        for (size_t i = 0; i < mask.size(); ++i)
+        {
+            if (mask[i] == '-')
+            {
+                kept.push_back(stack[height - mask.size() + i]);
+            }
+        }
+        stack.erase(stack.end() - mask.size(), stack.end());
+        stack.insert(stack.end(), kept.begin(), kept.end());
+        return true;
+    }
+    case 'f':
+    {
+        int n = std::stoi(code.substr(1));
+        if (n >= 0)
+        {
+            if (height < n + 1) return false;
+            int value = stack[height - 1 - n];
+            stack.erase(stack.end() - 1 - n);
+            stack.push_back(value);
+        }
+        else
+        {
+            if (height < -n + 1) return false;
+            int value = stack.back();
+            stack.pop_back();
+            stack.insert(stack.end() + n, value);
+        }
+        return true;
+    }
+    case 'F':
+    {
+        int n = std::stoi(code.substr(1));
+        if (height < n + 1) return false;
+        stack.push_back(stack[height - 1 - n]);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+static std::vector<Op> all_ops()
+{
+    std::vector<Op> ops = {
+        {"j", 1}, {"r", 1}, {"R", 1}, {"g", 1}, {"p", 1}, {"d", 1},
+    };
+
+    // Leading -s in a mask don't do anything, so every useful mask starts with a v
+    for (int length = 1; length <= max_inputs + max_extra; ++length)
+    {
+        for (int bits = 0; bits < (1 << (length - 1)); ++bits)
+        {
+            std::string mask = "v";
+            for (int i = length - 2; i >= 0; --i)
+            {
+                mask += (bits >> i) & 1 ? 'v' : '-';
+            }
+            ops.push_back({"b" + mask, 1});
+        }
+    }
+
+    // Smaller depths are already covered by jester's, rotation and prospector's
+    for (int n = 3; n < max_inputs + max_extra; ++n)
+    {
+        ops.push_back({"f" + std::to_string(n), 2});
+        ops.push_back({"f-" + std::to_string(n), 2});
+    }
+    for (int n = 2; n < max_inputs + max_extra; ++n)
+    {
+        ops.push_back({"F" + std::to_string(n), 2});
+    }
+
+    return ops;
+}
+
+// Removes bottom inputs that stay where they are, since those shuffles are also shuffles of fewer inputs
+static bool is_minimal(int num_inputs, const Stack& stack)
+{
+    return num_inputs == 0 || stack.empty() || stack[0] != 0 || std::count(stack.begin(), stack.end(), 0) > 1;
+}
+
+int main()
+{
+    std::vector<Op> ops = all_ops();
+
+    std::cout << "// Generated by tools/shuffle_table.cpp, don't edit by hand" << std::endl;
+    std::cout << "#pragma once" << std::endl;
+    std::cout << std::endl;
+    std::cout << "// Cheapest patterns for a shuffle of the top iotas of the stack, found by trying every sequence" << std::endl;
+    std::cout << "struct ShuffleTableEntry {" << std::endl;
+    std::cout << "    // Number of iotas read from the top of the stack" << std::endl;
+    std::cout << "    int num_inputs;" << std::endl;
+    std::cout << "    // Which input ends up in each slot, bottom first, where the deepest input is 0" << std::endl;
+    std::cout << "    const char* outputs;" << std::endl;
+    std::cout << "    // Space separated codes: j jester's, r rotation, R rotation II, g gemini, p prospector's, d dioscuri," << std::endl;
+    std::cout << "    // b<mask> bookkeeper's, f<n> fisherman's, F<n> fisherman's II" << std::endl;
+    std::cout << "    const char* patterns;" << std::endl;
+    std::cout << "};" << std::endl;
+    std::cout << std::endl;
+    std::cout << "constexpr int shuffle_table_max_inputs = " << max_inputs << ";" << std::endl;
+    std::cout << "constexpr int shuffle_table_max_outputs = " << max_outputs << ";" << std::endl;
+    std::cout << std::endl;
+    std::cout << "constexpr ShuffleTableEntry shuffle_table[] = {" << std::endl;
+
+    for (int num_inputs = 1; num_inputs <= max_inputs; ++num_inputs)
+    {
+        Stack start;
+        for (int i = 0; i < num_inputs; ++i)
+        {
+            start.push_back(i);
+        }
+
+        // Cheapest sequence found for each stack, searched cheapest first
+        std::map<Stack, std::pair<int, std::string>> best;
+        typedef std::tuple<int, int, Stack> Item;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+        int order = 0;
+
+        best[start] = {0, ""};
+        queue.push({0, order++, start});
+
+        while (!queue.empty())
+        {
+            auto [cost, item_order, stack] = queue.top();
+            queue.pop();
+            if (cost > best[stack].first)
+            {
+                continue;
+            }
+
+            for (const Op& op : ops)
+            {
+                Stack next = stack;
+                if (!apply(op.code, next) || (int)next.size() > num_inputs + max_extra)
+                {
+                    continue;
+                }
+
+                int next_cost = cost + op.cost;
+                std::map<Stack, std::pair<int, std::string>>::iterator iter = best.find(next);
+                if (iter != best.end() && iter->second.first <= next_cost)
+                {
+                    continue;
+                }
+
+                std::string sequence = best[stack].second;
+                best[next] = {next_cost, sequence.empty() ? op.code : sequence + " " + op.code};
+                queue.push({next_cost, order++, next});
+            }
+        }
+
+        for (const auto& [stack, result] : best)
+        {
+            if ((int)stack.size() > max_outputs || !is_minimal(num_inputs, stack))
+            {
+                continue;
+            }
+
+            std::string outputs;
+            for (int input : stack)
+            {
+                outputs += std::to_string(input);
+            }
+
+            std::cout << "    {" << num_inputs << ", \"" << outputs << "\", \"" << result.second << "\"}," << std::endl;
+        }
+    }
+
+    std::cout << "};";
+}